@@ -17,73 +17,54 @@
 
 #include "PlottingFramework.h"
 #include "PlotManager.h"
+#include "PlotServer.h"
+#include "FileWatcher.h"
 #include "Plot.h"
 #include "Logging.h"
 
 #include <boost/program_options.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <filesystem>
+#include <chrono>
 
 #include "Helpers.h"
 
 using namespace PlottingFramework;
 namespace po = boost::program_options;
 
+bool ReadConfiguration(const string& configFileName, string& plotDefinitions, string& inputFiles, string& outputDir);
+tuple<string, string> GetGroupAndCategory(const string& figureGroupAndCategory);
+bool RunServer(PlotManager& plotManager, const string& configFileName);
+void WatchPlots(PlotManager& plotManager, const string& plotDefinitions, const string& inputFiles, const string& mode,
+                const string& plotNames, const string& group, const string& category);
+
 int main(int argc, char* argv[])
 {
+  auto startTime = std::chrono::steady_clock::now();
 
   string configFileName = (gSystem->Getenv("__PLOTTING_CONFIG_FILE"))
                             ? expand_path("${__PLOTTING_CONFIG_FILE}")
                             : "~/.plotconfig.xml";
   configFileName = expand_path(configFileName);
 
-  string inputFiles;
-  string plotDefinitions;
-  string outputDir;
-
-  ptree activeConfigTree;
-  if (file_exists(configFileName)) {
-    using boost::property_tree::read_xml;
-    ptree configTree;
-    read_xml(configFileName, configTree, boost::property_tree::xml_parser::trim_whitespace);
-    string activeSettings;
-    if (auto activated = configTree.get_child_optional("activated")) {
-      activeSettings = activated.get().data();
-    }
-    if (auto curConfig = configTree.get_child_optional(activeSettings)) {
-      auto tree = curConfig.get();
-      if (auto property = tree.get_child_optional("plotDefinitions")) {
-        plotDefinitions = property->get_value<string>();
-      }
-      if (auto property = tree.get_child_optional("inputFiles")) {
-        inputFiles = property->get_value<string>();
-      }
-      if (auto property = tree.get_child_optional("outputDir")) {
-        outputDir = property->get_value<string>();
-      }
-    }
-  } else {
-    ERROR("Plotting app was not configured. Please run plot-config ...");
-    return 1;
-  }
-
-  // check if specified input files exist
-  if (!file_exists(expand_path(inputFiles))) {
-    ERROR(R"(File "{}" does not exists! Exiting.)", inputFiles);
-    return 1;
-  }
-  if (!file_exists(expand_path(plotDefinitions))) {
-    ERROR(R"(File "{}" does not exists! Exiting.)", plotDefinitions);
-    return 1;
-  }
-
   string mode;
   string figureGroupAndCategory;
   string plotNames;
+  bool runServer = false;
+  bool stopServer = false;
+  bool watch = false;
+  bool profile = false;
+  bool ioStatistics = false;
+  string traceFile;
 
   // handle user inputs
   try {
-    po::options_description arguments("positional arguments");
+    po::options_description arguments("arguments");
     arguments.add_options()("figureGroupAndCategory", po::value<string>(), "figure group")("plotNames", po::value<string>(), "plot name")("mode", po::value<string>(), "mode");
+    arguments.add_options()("server", "keep plotting environment alive and handle the requests of subsequent plot calls")("stop-server", "shut down the running plot server")("watch", "re-create plots whenever their definitions or input data change");
+    arguments.add_options()("profile", "print the time spent in the individual phases of plot creation")("trace", po::value<string>(), "write the timings to a Chrome trace-event file");
+    arguments.add_options()("io-stats", "print statistics about reading the input files");
+    arguments.add_options()("log", po::value<string>(), "verbosity (error, warning, info, log, debug) and per-module filters, e.g. warning,PlotPainter=debug")("log-json", po::value<string>(), "additionally write log messages as JSON lines to this file");
     po::positional_options_description pos;
     pos.add("figureGroupAndCategory", 1);
     pos.add("plotNames", 1);
@@ -102,6 +83,20 @@ int main(int argc, char* argv[])
     if (vm.count("mode")) {
       mode = vm["mode"].as<string>();
     }
+    runServer = vm.count("server");
+    stopServer = vm.count("stop-server");
+    watch = vm.count("watch");
+    if (vm.count("trace")) {
+      traceFile = vm["trace"].as<string>();
+    }
+    profile = vm.count("profile") || !traceFile.empty();
+    ioStatistics = vm.count("io-stats");
+    if (vm.count("log") && !Logger::SetFilters(vm["log"].as<string>())) {
+      return 1;
+    }
+    if (vm.count("log-json") && !Logger::SetJSONOutput(vm["log-json"].as<string>())) {
+      return 1;
+    }
   } catch (std::exception& e) {
     ERROR(R"(Exception "{}"! Exiting.)", e.what());
     return 1;
@@ -110,17 +105,116 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (stopServer) {
+    if (!PlotServer::Shutdown()) {
+      ERROR("No plot server is running.");
+      return 1;
+    }
+    return 0;
+  }
+
   if (mode.empty()) mode = "interactive";
 
-  if (plotNames.empty()) {
-    ERROR("No plots were specified.");
+  if (!runServer) {
+    if (plotNames.empty()) {
+      ERROR("No plots were specified.");
+      return 1;
+    }
+    if (watch && (mode == "interactive" || mode == "find")) {
+      ERROR("Watch mode requires a non-interactive output mode.");
+      return 1;
+    }
+    // let the plot server handle the request if there is one running
+    if (!watch && !profile && !ioStatistics && mode != "interactive" && mode != "find") {
+      if (auto success = PlotServer::SendRequest({figureGroupAndCategory, plotNames, mode})) {
+        return (*success) ? 0 : 1;
+      }
+    }
+  }
+
+  string inputFiles;
+  string plotDefinitions;
+  string outputDir;
+  if (!ReadConfiguration(configFileName, plotDefinitions, inputFiles, outputDir)) {
     return 1;
   }
 
   // create plotting environment
   PlotManager plotManager;
+  if (runServer) {
+    return (RunServer(plotManager, configFileName)) ? 0 : 1;
+  }
   plotManager.SetOutputDirectory(outputDir);
+  plotManager.SetProfiling(profile);
+  plotManager.SetReportIOStatistics(ioStatistics);
 
+  auto [group, category] = GetGroupAndCategory(figureGroupAndCategory);
+  if (mode != "find") {
+    plotManager.LoadInputDataFiles(inputFiles);
+  }
+  LOG("Start-up took {} ms.", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+  plotManager.ExtractPlotsFromFile(plotDefinitions, mode, plotNames, group, category);
+  if (profile) {
+    plotManager.PrintProfilingSummary();
+    if (!traceFile.empty()) plotManager.WriteProfilingTrace(traceFile);
+  }
+  if (watch) {
+    WatchPlots(plotManager, plotDefinitions, inputFiles, mode, plotNames, group, category);
+  }
+  return 0;
+}
+
+//**************************************************************************************************
+/**
+ * Reads the currently activated settings from the config file.
+ */
+//**************************************************************************************************
+bool ReadConfiguration(const string& configFileName, string& plotDefinitions, string& inputFiles, string& outputDir)
+{
+  if (file_exists(configFileName)) {
+    using boost::property_tree::read_xml;
+    ptree configTree;
+    read_xml(configFileName, configTree, boost::property_tree::xml_parser::trim_whitespace);
+    string activeSettings;
+    if (auto activated = configTree.get_child_optional("activated")) {
+      activeSettings = activated.get().data();
+    }
+    if (auto curConfig = configTree.get_child_optional(activeSettings)) {
+      auto tree = curConfig.get();
+      if (auto property = tree.get_child_optional("plotDefinitions")) {
+        plotDefinitions = property->get_value<string>();
+      }
+      if (auto property = tree.get_child_optional("inputFiles")) {
+        inputFiles = property->get_value<string>();
+      }
+      if (auto property = tree.get_child_optional("outputDir")) {
+        outputDir = property->get_value<string>();
+      }
+    }
+  } else {
+    ERROR("Plotting app was not configured. Please run plot-config ...");
+    return false;
+  }
+
+  // check if specified input files exist
+  if (!file_exists(expand_path(inputFiles))) {
+    ERROR(R"(File "{}" does not exists! Exiting.)", inputFiles);
+    return false;
+  }
+  if (!file_exists(expand_path(plotDefinitions))) {
+    ERROR(R"(File "{}" does not exists! Exiting.)", plotDefinitions);
+    return false;
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Translates user input of the form group/category into regular expressions.
+ */
+//**************************************************************************************************
+tuple<string, string> GetGroupAndCategory(const string& figureGroupAndCategory)
+{
   string group = ".+";
   string category = ".*";
 
@@ -132,10 +226,93 @@ int main(int argc, char* argv[])
     category = groupCat[1];
     category += "(/.*)?"; // search also in subcategories
   }
+  return {group, category};
+}
 
-  if (mode != "find") {
-    plotManager.LoadInputDataFiles(inputFiles);
+//**************************************************************************************************
+/**
+ * Keeps the plot manager including its parsed plot definitions and loaded input data alive
+ * and creates the plots requested by other instances of the app. Everything that was changed
+ * on disk in the meantime (configuration, plot definitions, input files) is reloaded.
+ */
+//**************************************************************************************************
+bool RunServer(PlotManager& plotManager, const string& configFileName)
+{
+  PlotServer server;
+  if (!server.Listen()) return false;
+
+  string inputFiles;
+  std::filesystem::file_time_type inputFilesTimestamp;
+  server.Run([&](const vector<string>& arguments) {
+    if (arguments.size() != 3) {
+      ERROR("Received invalid request.");
+      return false;
+    }
+    const string& figureGroupAndCategory = arguments[0];
+    const string& plotNames = arguments[1];
+    const string& mode = arguments[2];
+    if (mode == "interactive") {
+      ERROR("Interactive mode is not supported by the plot server.");
+      return false;
+    }
+
+    string plotDefinitions;
+    string curInputFiles;
+    string outputDir;
+    if (!ReadConfiguration(configFileName, plotDefinitions, curInputFiles, outputDir)) {
+      return false;
+    }
+    plotManager.SetOutputDirectory(outputDir);
+
+    std::error_code errorCode;
+    auto curInputFilesTimestamp = std::filesystem::last_write_time(expand_path(curInputFiles), errorCode);
+    if (curInputFiles != inputFiles || curInputFilesTimestamp != inputFilesTimestamp) {
+      plotManager.ClearInputDataFiles();
+      plotManager.ClearDataBuffer();
+      plotManager.LoadInputDataFiles(curInputFiles);
+      inputFiles = curInputFiles;
+      inputFilesTimestamp = curInputFilesTimestamp;
+    } else {
+      plotManager.InvalidateModifiedInputFiles();
+    }
+
+    // modified plot definition files are re-read automatically by the manager
+    plotManager.ClearPlots();
+    auto [group, category] = GetGroupAndCategory(figureGroupAndCategory);
+    return plotManager.ExtractPlotsFromFile(plotDefinitions, mode, plotNames, group, category);
+  });
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Waits for modifications of the plot definitions and input files and re-creates the affected plots.
+ */
+//**************************************************************************************************
+void WatchPlots(PlotManager& plotManager, const string& plotDefinitions, const string& inputFiles, const string& mode,
+                const string& plotNames, const string& group, const string& category)
+{
+  string inputFilesConfig = std::filesystem::absolute(expand_path(inputFiles)).lexically_normal().string();
+  string plotDefinitionsFile = std::filesystem::absolute(expand_path(plotDefinitions)).lexically_normal().string();
+
+  FileWatcher watcher;
+  while (true) {
+    vector<string> watchedFiles = plotManager.GetWatchedFiles();
+    watchedFiles.push_back(inputFilesConfig);
+    watchedFiles.push_back(plotDefinitionsFile);
+    watcher.SetFiles(watchedFiles);
+    INFO("Watching {} files for modifications (press Ctrl+C to exit).", watchedFiles.size());
+
+    auto modifiedFiles = watcher.WaitForChanges();
+    if (std::find(modifiedFiles.begin(), modifiedFiles.end(), inputFilesConfig) != modifiedFiles.end()) {
+      // input file definitions changed, start from scratch
+      plotManager.ClearInputDataFiles();
+      plotManager.ClearDataBuffer();
+      plotManager.ClearPlots();
+      plotManager.LoadInputDataFiles(inputFiles);
+      plotManager.ExtractPlotsFromFile(plotDefinitions, mode, plotNames, group, category);
+      continue;
+    }
+    plotManager.UpdatePlots(plotDefinitions, mode, plotNames, group, category);
   }
-  plotManager.ExtractPlotsFromFile(plotDefinitions, mode, plotNames, group, category);
-  return 0;
 }
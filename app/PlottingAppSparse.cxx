@@ -0,0 +1,71 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "PlottingFramework.h"
+#include "ChunkedSparse.h"
+#include "Logging.h"
+
+#include <boost/program_options.hpp>
+
+using namespace PlottingFramework;
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[])
+{
+  string outputFileName;
+  string name;
+  vector<string> inputNames;
+  uint64_t binsPerChunk{};
+
+  try {
+    po::options_description options("options");
+    options.add_options()("help,h", "usage: plot-sparse <output.root> <name> <input.root:path/to/sparse> [<input2.root:path/to/sparse> ...]")("bins-per-chunk", po::value<uint64_t>()->default_value(1000000), "maximum number of filled bins per chunk");
+    po::options_description arguments("positional arguments");
+    arguments.add_options()("output", po::value<string>(), "output file")("name", po::value<string>(), "name of the histogram in the output file")("inputs", po::value<vector<string>>(), "input histograms");
+    po::positional_options_description pos;
+    pos.add("output", 1);
+    pos.add("name", 1);
+    pos.add("inputs", -1);
+
+    po::options_description cmdline;
+    cmdline.add(options).add(arguments);
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(cmdline).positional(pos).run(), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || !vm.count("output") || !vm.count("name") || !vm.count("inputs")) {
+      std::cout << options << std::endl;
+      return vm.count("help") ? 0 : 1;
+    }
+    outputFileName = vm["output"].as<string>();
+    name = vm["name"].as<string>();
+    inputNames = vm["inputs"].as<vector<string>>();
+    binsPerChunk = vm["bins-per-chunk"].as<uint64_t>();
+  } catch (std::exception& e) {
+    ERROR(R"(Exception "{}"! Exiting.)", e.what());
+    return 1;
+  } catch (...) {
+    ERROR("Exception of unknown type! Exiting.");
+    return 1;
+  }
+
+  if (binsPerChunk == 0) {
+    ERROR("Number of bins per chunk must be positive.");
+    return 1;
+  }
+  return ChunkedSparse::Convert(inputNames, outputFileName, name, binsPerChunk) ? 0 : 1;
+}
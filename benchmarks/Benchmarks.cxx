@@ -0,0 +1,345 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "PlotManager.h"
+#include "PlotPainter.h"
+#include "SyntheticInput.h"
+#include "Logging.h"
+
+#include <boost/program_options.hpp>
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <regex>
+
+#include "TROOT.h"
+#include "TFile.h"
+#include "TCanvas.h"
+#include "TPave.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "THnSparse.h"
+#include "TGraphErrors.h"
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Gives the benchmarks access to the internals of manager and painter.
+ */
+//**************************************************************************************************
+class BenchmarkAccess
+{
+public:
+  static void RequestData(PlotManager& manager, const string& inputID, const string& name) { manager.mDataBuffer[MakeDataKey(inputID, name)]; }
+  static bool FillBuffer(PlotManager& manager) { return manager.FillBuffer(); }
+  static TObject* GetData(PlotManager& manager, const string& inputID, const string& name) { return manager.mDataBuffer[MakeDataKey(inputID, name)].get(); }
+  static void ReadData(PlotManager& manager, TObject* folder, vector<string>& names, const string& prefix, const string& inputID, const string& fileName)
+  {
+    manager.ReadData(folder, names, prefix, gNameGroupSeparator + inputID, inputID, fileName);
+  }
+  static optional<data_ptr_t> GetProjection(PlotPainter& painter, TObject* obj, const Plot::Pad::Data::proj_info_t& projInfo)
+  {
+    return painter.GetProjection(obj, projInfo);
+  }
+  static bool DivideGraphs(PlotPainter& painter, TGraph* numerator, TGraph* denominator) { return painter.DivideGraphs(numerator, denominator); }
+  static void DivideGraphsInterpolated(PlotPainter& painter, TGraph* numerator, TGraph* denominator) { painter.DivideGraphsInterpolated(numerator, denominator); }
+  static void DivideHistosInterpolated(PlotPainter& painter, TH1* numerator, TH1* denominator) { painter.DivideHistosInterpolated(numerator, denominator); }
+  static void DivideHistGraphInterpolated(PlotPainter& painter, TH1* numerator, TGraph* denominator) { painter.DivideHistGraphInterpolated(numerator, denominator); }
+  static TPave* GenerateBox(PlotPainter& painter, const Plot::Pad::TextBox* box, TPad* pad) { return painter.GenerateBox(box, pad); }
+};
+} // end namespace PlottingFramework
+
+using namespace PlottingFramework;
+namespace po = boost::program_options;
+namespace fs = std::filesystem;
+
+//**************************************************************************************************
+/**
+ * Measures the time spent in the part of a benchmark that is enclosed by Start() and Stop().
+ */
+//**************************************************************************************************
+class Stopwatch
+{
+public:
+  void Start() { mStart = std::chrono::steady_clock::now(); }
+  void Stop() { mElapsed += std::chrono::steady_clock::now() - mStart; }
+  double_t GetMilliseconds() const { return std::chrono::duration<double_t, std::milli>(mElapsed).count(); }
+
+private:
+  std::chrono::steady_clock::time_point mStart;
+  std::chrono::steady_clock::duration mElapsed{};
+};
+
+//**************************************************************************************************
+/**
+ * Runs the benchmarks and collects their timing statistics.
+ */
+//**************************************************************************************************
+class BenchmarkRunner
+{
+public:
+  BenchmarkRunner(uint32_t nRepetitions, const string& filter) : mRepetitions{nRepetitions}, mFilter{filter} {}
+
+  void Run(const string& name, const string& kind, const std::function<void(Stopwatch&)>& benchmark)
+  {
+    if (!std::regex_match(name, mFilter)) return;
+    vector<double_t> times;
+    for (uint32_t i = 0; i < mRepetitions; ++i) {
+      Stopwatch stopwatch;
+      benchmark(stopwatch);
+      times.push_back(stopwatch.GetMilliseconds());
+    }
+    std::sort(times.begin(), times.end());
+    result_t result{name, kind, times.front(), times[times.size() / 2],
+                    std::accumulate(times.begin(), times.end(), 0.) / times.size(), times.back()};
+    INFO("{:<32} {:>6}  min {:>10.3f} ms  median {:>10.3f} ms  mean {:>10.3f} ms", name, kind, result.min, result.median, result.mean);
+    mResults.push_back(result);
+  }
+
+  bool WriteJSON(const string& fileName, const synthetic_input_t& settings) const
+  {
+    std::ofstream output(fileName);
+    if (!output) {
+      ERROR("Could not write benchmark results to {}.", fileName);
+      return false;
+    }
+    output << fmt::format(R"({{"root_version": "{}", "repetitions": {}, "input": {{"keys": {}, "dir_depth": {}, "dirs_per_level": {}, "list_depth": {}, )",
+                          gROOT->GetVersion(), mRepetitions, settings.nKeys, settings.dirDepth, settings.dirsPerLevel, settings.listDepth);
+    output << fmt::format(R"("th1_bins": {}, "th2_bins": {}, "thn_dims": {}, "thn_bins": {}, "entries": {}, "graph_points": {}}},)",
+                          settings.nBinsTH1, settings.nBinsTH2, settings.nDimsTHn, settings.nBinsTHn, settings.nEntries, settings.nGraphPoints);
+    output << "\n \"results\": [";
+    for (size_t i = 0; i < mResults.size(); ++i) {
+      auto& result = mResults[i];
+      output << fmt::format(R"({}{{"name": "{}", "kind": "{}", "min_ms": {}, "median_ms": {}, "mean_ms": {}, "max_ms": {}}})",
+                            (i) ? ",\n  " : "\n  ", result.name, result.kind, result.min, result.median, result.mean, result.max);
+    }
+    output << "\n]}\n";
+    return true;
+  }
+
+private:
+  struct result_t {
+    string name;
+    string kind; // "micro" or "macro"
+    double_t min;
+    double_t median;
+    double_t mean;
+    double_t max;
+  };
+  uint32_t mRepetitions;
+  std::regex mFilter;
+  vector<result_t> mResults;
+};
+
+int main(int argc, char* argv[])
+{
+  synthetic_input_t settings;
+  string workDir;
+  string resultFile;
+  string filter;
+  uint32_t nRepetitions{};
+  uint32_t nPlots{};
+
+  try {
+    po::options_description arguments = GetSyntheticInputOptions(settings);
+    arguments.add_options()("work-dir", po::value<string>(&workDir)->default_value("benchmark_workdir"), "folder for generated input and output files");
+    arguments.add_options()("output", po::value<string>(&resultFile)->default_value("benchmark_results.json"), "file the results are written to");
+    arguments.add_options()("filter", po::value<string>(&filter)->default_value(".*"), "regular expression selecting the benchmarks to run");
+    arguments.add_options()("repetitions", po::value<uint32_t>(&nRepetitions)->default_value(5), "repetitions per benchmark");
+    arguments.add_options()("plots", po::value<uint32_t>(&nPlots)->default_value(50), "number of plots used in the macro benchmarks");
+    arguments.add_options()("help", "show available options");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, arguments), vm);
+    po::notify(vm);
+    if (vm.count("help")) {
+      std::cout << arguments << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    ERROR(R"(Exception "{}"! Exiting.)", e.what());
+    return 1;
+  } catch (...) {
+    ERROR("Exception of unknown type! Exiting.");
+    return 1;
+  }
+  if (nRepetitions == 0 || settings.nKeys < 4) {
+    ERROR("At least one repetition and four keys (one object of each type) are required.");
+    return 1;
+  }
+
+  gROOT->SetBatch(true);
+  TH1::AddDirectory(false);
+  fs::create_directories(workDir);
+  const string inputFileName = workDir + "/SyntheticInput.root";
+  const string inputID = "bench";
+  auto names = GenerateSyntheticInput(inputFileName, settings);
+  if (names.empty()) return 1;
+
+  // objects of the first leaf directory serve as input for the micro benchmarks
+  string leafPath = names.front().substr(0, names.front().find_last_of('/') + 1);
+  vector<string> leafNames;
+  for (auto& name : names) {
+    if (name.substr(0, leafPath.size()) == leafPath && name.find('/', leafPath.size()) == string::npos) leafNames.push_back(name.substr(leafPath.size()));
+  }
+  auto getObject = [&](const string& name) {
+    PlotManager manager;
+    manager.AddInputDataFile(inputID, inputFileName);
+    BenchmarkAccess::RequestData(manager, inputID, leafPath + name);
+    if (!BenchmarkAccess::FillBuffer(manager)) {
+      ERROR("Could not read {} from {}.", name, inputFileName);
+      std::exit(1);
+    }
+    return unique_ptr<TObject>(BenchmarkAccess::GetData(manager, inputID, leafPath + name)->Clone());
+  };
+  unique_ptr<TObject> hist1d = getObject("h1_0");
+  unique_ptr<TObject> hist2d = getObject("h2_1");
+  unique_ptr<TObject> histSparse = getObject("hn_2");
+  unique_ptr<TObject> graph = getObject("g_3");
+
+  BenchmarkRunner runner(nRepetitions, filter);
+  PlotPainter painter;
+
+  // ---------------------------------------------------------------------------------------------
+  // micro benchmarks
+  runner.Run("ReadData", "micro", [&](Stopwatch& stopwatch) {
+    PlotManager manager;
+    TFile file(inputFileName.data(), "READ");
+    TObject* folder = (leafPath.empty()) ? static_cast<TObject*>(&file) : file.GetDirectory(leafPath.data());
+    vector<string> requestedNames = leafNames;
+    stopwatch.Start();
+    BenchmarkAccess::ReadData(manager, folder, requestedNames, leafPath, inputID, inputFileName);
+    stopwatch.Stop();
+  });
+  runner.Run("FillBuffer", "micro", [&](Stopwatch& stopwatch) {
+    PlotManager manager;
+    manager.AddInputDataFile(inputID, inputFileName);
+    for (auto& name : names) {
+      BenchmarkAccess::RequestData(manager, inputID, name);
+    }
+    stopwatch.Start();
+    BenchmarkAccess::FillBuffer(manager);
+    stopwatch.Stop();
+  });
+  runner.Run("FillBuffer_single", "micro", [&](Stopwatch& stopwatch) {
+    PlotManager manager;
+    manager.AddInputDataFile(inputID, inputFileName);
+    BenchmarkAccess::RequestData(manager, inputID, names.back());
+    stopwatch.Start();
+    BenchmarkAccess::FillBuffer(manager);
+    stopwatch.Stop();
+  });
+
+  auto runProjection = [&](const string& name, TObject* obj, const Plot::Pad::Data::proj_info_t& projInfo) {
+    runner.Run(name, "micro", [&](Stopwatch& stopwatch) {
+      stopwatch.Start();
+      auto projection = BenchmarkAccess::GetProjection(painter, obj, projInfo);
+      stopwatch.Stop();
+      if (projection) std::visit([](auto&& ptr) { delete ptr; }, *projection);
+    });
+  };
+  runProjection("GetProjection_TH2_1d", hist2d.get(), {{0}, {{1, 10, 20}}});
+  runProjection("GetProjection_THnSparse_1d", histSparse.get(), {{0}, {{1, 5, 15}}});
+  runProjection("GetProjection_THnSparse_2d", histSparse.get(), {{0, 1}, {}});
+
+  runner.Run("DivideHistosInterpolated", "micro", [&](Stopwatch& stopwatch) {
+    unique_ptr<TH1> numerator(static_cast<TH1*>(hist1d->Clone()));
+    unique_ptr<TH1> denominator(static_cast<TH1*>(hist1d->Clone()));
+    denominator->Rebin(2);
+    stopwatch.Start();
+    BenchmarkAccess::DivideHistosInterpolated(painter, numerator.get(), denominator.get());
+    stopwatch.Stop();
+  });
+  runner.Run("DivideGraphs", "micro", [&](Stopwatch& stopwatch) {
+    unique_ptr<TGraph> numerator(static_cast<TGraph*>(graph->Clone()));
+    stopwatch.Start();
+    BenchmarkAccess::DivideGraphs(painter, numerator.get(), static_cast<TGraph*>(graph.get()));
+    stopwatch.Stop();
+  });
+  runner.Run("DivideGraphsInterpolated", "micro", [&](Stopwatch& stopwatch) {
+    unique_ptr<TGraph> numerator(static_cast<TGraph*>(graph->Clone()));
+    stopwatch.Start();
+    BenchmarkAccess::DivideGraphsInterpolated(painter, numerator.get(), static_cast<TGraph*>(graph.get()));
+    stopwatch.Stop();
+  });
+  runner.Run("DivideHistGraphInterpolated", "micro", [&](Stopwatch& stopwatch) {
+    unique_ptr<TH1> numerator(static_cast<TH1*>(hist1d->Clone()));
+    stopwatch.Start();
+    BenchmarkAccess::DivideHistGraphInterpolated(painter, numerator.get(), static_cast<TGraph*>(graph.get()));
+    stopwatch.Stop();
+  });
+
+  runner.Run("GenerateBox", "micro", [&](Stopwatch& stopwatch) {
+    TCanvas canvas("benchmark_canvas", "", 710, 710);
+    string text = "#bf{ALICE Performance}";
+    for (uint8_t i = 0; i < 9; ++i) {
+      text += fmt::format(" // line {} with #sqrt{{s}} = 13 TeV", i);
+    }
+    auto box = std::make_shared<Plot::Pad::TextBox>(0.2, 0.8, text);
+    stopwatch.Start();
+    unique_ptr<TPave> pave(BenchmarkAccess::GenerateBox(painter, box.get(), &canvas));
+    stopwatch.Stop();
+  });
+
+  // plot definitions used for the xml and end-to-end benchmarks
+  auto definePlots = [&](PlotManager& manager) {
+    for (uint32_t i = 0; i < nPlots; ++i) {
+      const string& name = names[(4 * i) % names.size()];
+      const string& otherName = names[(4 * i + 4) % names.size()];
+      Plot plot(fmt::format("plot_{}", i), "benchmark");
+      plot[1].AddData(name, inputID, "first");
+      plot[1].AddData(otherName, inputID, "second");
+      plot[1].AddLegend();
+      plot[1].AddText(0.2, 0.8, "synthetic // input");
+      manager.AddPlot(plot);
+    }
+  };
+  const string plotFileName = workDir + "/plotDefinitions.XML";
+  runner.Run("DumpPlots", "micro", [&](Stopwatch& stopwatch) {
+    PlotManager manager;
+    definePlots(manager);
+    stopwatch.Start();
+    manager.DumpPlots(plotFileName);
+    stopwatch.Stop();
+  });
+  runner.Run("ExtractPlotsFromFile", "micro", [&](Stopwatch& stopwatch) {
+    PlotManager manager;
+    stopwatch.Start();
+    manager.ExtractPlotsFromFile(plotFileName);
+    stopwatch.Stop();
+  });
+
+  // ---------------------------------------------------------------------------------------------
+  // macro benchmarks
+  for (const string outputMode : {"pdf", "png"}) {
+    runner.Run("CreatePlots_" + outputMode, "macro", [&](Stopwatch& stopwatch) {
+      PlotManager manager;
+      manager.SetOutputDirectory(workDir + "/plots");
+      manager.AddInputDataFile(inputID, inputFileName);
+      definePlots(manager);
+      stopwatch.Start();
+      manager.CreatePlots("", "", {}, outputMode);
+      stopwatch.Stop();
+    });
+  }
+
+  return runner.WriteJSON(resultFile, settings) ? 0 : 1;
+}
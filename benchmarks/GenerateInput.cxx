@@ -0,0 +1,55 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "SyntheticInput.h"
+#include "Logging.h"
+
+#include <boost/program_options.hpp>
+
+using namespace PlottingFramework;
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[])
+{
+  string fileName;
+  synthetic_input_t settings;
+
+  try {
+    po::options_description arguments = GetSyntheticInputOptions(settings);
+    arguments.add_options()("output", po::value<string>(&fileName)->default_value("SyntheticInput.root"), "name of the generated file")("help", "show available options");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, arguments), vm);
+    po::notify(vm);
+    if (vm.count("help")) {
+      std::cout << arguments << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    ERROR(R"(Exception "{}"! Exiting.)", e.what());
+    return 1;
+  } catch (...) {
+    ERROR("Exception of unknown type! Exiting.");
+    return 1;
+  }
+
+  auto names = GenerateSyntheticInput(fileName, settings);
+  if (names.empty()) return 1;
+  INFO("Wrote {} objects to {}.", names.size(), fileName);
+  return 0;
+}
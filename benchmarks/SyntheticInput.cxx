@@ -0,0 +1,179 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// framework dependencies
+#include "SyntheticInput.h"
+#include "Logging.h"
+
+// std dependencies
+#include <functional>
+
+// root dependencies
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TList.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "THnSparse.h"
+#include "TGraphErrors.h"
+#include "TRandom3.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Creates the i-th synthetic object (the type cycles with the index).
+ */
+//**************************************************************************************************
+TObject* CreateSyntheticObject(uint32_t i, const synthetic_input_t& settings, TRandom3& random)
+{
+  switch (i % 4) {
+    case 0: {
+      string name = fmt::format("h1_{}", i);
+      auto hist = new TH1D(name.data(), name.data(), settings.nBinsTH1, -5., 5.);
+      hist->Sumw2();
+      for (uint32_t j = 0; j < settings.nEntries; ++j) {
+        hist->Fill(random.Gaus());
+      }
+      return hist;
+    }
+    case 1: {
+      string name = fmt::format("h2_{}", i);
+      auto hist = new TH2D(name.data(), name.data(), settings.nBinsTH2, -5., 5., settings.nBinsTH2, -5., 5.);
+      for (uint32_t j = 0; j < settings.nEntries; ++j) {
+        hist->Fill(random.Gaus(), random.Gaus());
+      }
+      return hist;
+    }
+    case 2: {
+      string name = fmt::format("hn_{}", i);
+      vector<int32_t> nBins(settings.nDimsTHn, settings.nBinsTHn);
+      vector<double_t> min(settings.nDimsTHn, -5.);
+      vector<double_t> max(settings.nDimsTHn, 5.);
+      auto hist = new THnSparseD(name.data(), name.data(), settings.nDimsTHn, nBins.data(), min.data(), max.data());
+      vector<double_t> x(settings.nDimsTHn);
+      for (uint32_t j = 0; j < settings.nEntries; ++j) {
+        for (auto& value : x) {
+          value = random.Gaus();
+        }
+        hist->Fill(x.data());
+      }
+      return hist;
+    }
+    default: {
+      string name = fmt::format("g_{}", i);
+      auto graph = new TGraphErrors(settings.nGraphPoints);
+      graph->SetName(name.data());
+      for (uint32_t j = 0; j < settings.nGraphPoints; ++j) {
+        graph->SetPoint(j, j, 10. + random.Gaus());
+        graph->SetPointError(j, 0.5, 0.1 * std::abs(random.Gaus()));
+      }
+      return graph;
+    }
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Writes a synthetic input file with the specified layout.
+ */
+//**************************************************************************************************
+vector<string> GenerateSyntheticInput(const string& fileName, const synthetic_input_t& settings)
+{
+  vector<string> names;
+  TFile file(fileName.data(), "RECREATE");
+  if (file.IsZombie()) {
+    ERROR("Could not create synthetic input file {}.", fileName);
+    return names;
+  }
+  bool addDirStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+  TRandom3 random(settings.seed);
+
+  std::function<void(TDirectory*, const string&, uint32_t)> fillDirectory;
+  fillDirectory = [&](TDirectory* directory, const string& path, uint32_t level) {
+    if (level < settings.dirDepth) {
+      for (uint32_t i = 0; i < settings.dirsPerLevel; ++i) {
+        string subDirName = fmt::format("dir{}", i);
+        fillDirectory(directory->mkdir(subDirName.data()), path + subDirName + "/", level + 1);
+      }
+      return;
+    }
+
+    // objects stored in lists are found by the framework even if the lists are not part of the path
+    TList* topList{nullptr};
+    TList* innerList{nullptr};
+    for (uint32_t i = 0; i < settings.listDepth; ++i) {
+      auto list = new TList();
+      list->SetName(fmt::format("list{}", i).data());
+      list->SetOwner();
+      if (innerList) {
+        innerList->Add(list);
+      } else {
+        topList = list;
+      }
+      innerList = list;
+    }
+
+    for (uint32_t i = 0; i < settings.nKeys; ++i) {
+      TObject* obj = CreateSyntheticObject(i, settings, random);
+      names.push_back(path + obj->GetName());
+      if (innerList) {
+        innerList->Add(obj);
+      } else {
+        directory->WriteTObject(obj, obj->GetName());
+        delete obj;
+      }
+    }
+    if (topList) {
+      directory->WriteTObject(topList, topList->GetName());
+      delete topList;
+    }
+  };
+  fillDirectory(&file, "", 0);
+
+  TH1::AddDirectory(addDirStatus);
+  file.Close();
+  return names;
+}
+
+//**************************************************************************************************
+/**
+ * Command-line options to configure the layout of the synthetic input.
+ */
+//**************************************************************************************************
+boost::program_options::options_description GetSyntheticInputOptions(synthetic_input_t& settings)
+{
+  namespace po = boost::program_options;
+  po::options_description options("synthetic input");
+  options.add_options()("keys", po::value<uint32_t>(&settings.nKeys)->default_value(settings.nKeys), "objects per leaf directory");
+  options.add_options()("dir-depth", po::value<uint32_t>(&settings.dirDepth)->default_value(settings.dirDepth), "levels of sub-directories");
+  options.add_options()("dirs-per-level", po::value<uint32_t>(&settings.dirsPerLevel)->default_value(settings.dirsPerLevel), "sub-directories per level");
+  options.add_options()("list-depth", po::value<uint32_t>(&settings.listDepth)->default_value(settings.listDepth), "nesting of TLists the objects are stored in");
+  options.add_options()("th1-bins", po::value<int32_t>(&settings.nBinsTH1)->default_value(settings.nBinsTH1), "bins of 1d histograms");
+  options.add_options()("th2-bins", po::value<int32_t>(&settings.nBinsTH2)->default_value(settings.nBinsTH2), "bins per axis of 2d histograms");
+  options.add_options()("thn-dims", po::value<uint32_t>(&settings.nDimsTHn)->default_value(settings.nDimsTHn), "dimensions of sparse histograms");
+  options.add_options()("thn-bins", po::value<int32_t>(&settings.nBinsTHn)->default_value(settings.nBinsTHn), "bins per axis of sparse histograms");
+  options.add_options()("entries", po::value<uint32_t>(&settings.nEntries)->default_value(settings.nEntries), "entries per histogram");
+  options.add_options()("graph-points", po::value<uint32_t>(&settings.nGraphPoints)->default_value(settings.nGraphPoints), "points per graph");
+  options.add_options()("seed", po::value<uint32_t>(&settings.seed)->default_value(settings.seed), "seed of the random number generator");
+  return options;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,57 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef SyntheticInput_h
+#define SyntheticInput_h
+
+#include "PlottingFramework.h"
+
+#include <boost/program_options.hpp>
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Layout of the synthetic input files used for benchmarking.
+ * Objects are stored in the leaf directories of a tree of directories and cycle through the types
+ * TH1D (h1_i), TH2D (h2_i), THnSparseD (hn_i) and TGraphErrors (g_i).
+ */
+//**************************************************************************************************
+struct synthetic_input_t {
+  uint32_t nKeys{100};        // objects per leaf directory
+  uint32_t dirDepth{1};       // levels of sub-directories
+  uint32_t dirsPerLevel{2};   // sub-directories per level
+  uint32_t listDepth{0};      // if > 0 the objects of a leaf directory are stored in (nested) TLists
+  int32_t nBinsTH1{100};      // bins of the 1d histograms
+  int32_t nBinsTH2{100};      // bins per axis of the 2d histograms
+  uint32_t nDimsTHn{4};       // dimensions of the sparse histograms
+  int32_t nBinsTHn{20};       // bins per axis of the sparse histograms
+  uint32_t nEntries{10000};   // entries filled in each histogram
+  uint32_t nGraphPoints{100}; // points per graph
+  uint32_t seed{42};
+};
+
+// writes the synthetic input file and returns the names (including directory path) of all stored objects
+vector<string> GenerateSyntheticInput(const string& fileName, const synthetic_input_t& settings);
+
+// command-line options to configure the layout of the synthetic input
+boost::program_options::options_description GetSyntheticInputOptions(synthetic_input_t& settings);
+
+} // end namespace PlottingFramework
+#endif /* SyntheticInput_h */
@@ -0,0 +1,90 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef CSVReader_h
+#define CSVReader_h
+
+#include "PlottingFramework.h"
+
+#include <string_view>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Layout of a csv (or tsv) input file. It is specified after the file name as comma separated list
+ * of options, e.g. "scan.csv.gz:header,delimiter=semicolon,x=energy,y=eff|pur,ey=eff_err|pur_err".
+ * Columns can be selected by index (starting at 0) or by the name given in the header.
+ * Several y columns (separated by '|') result in several graphs that are read in a single pass,
+ * the error columns then have to be specified in the same order.
+ */
+//**************************************************************************************************
+struct csv_schema_t {
+  optional<char> delimiter; // tab, comma, semicolon, space (any whitespace) or single character; guessed from first line if not set
+  char comment{'#'};        // lines starting with this character are ignored
+  bool header{};            // first line (that is not a comment) contains the column names
+  string x{"0"};
+  vector<string> y;
+  vector<string> ex;
+  vector<string> ey;
+  vector<string> exl; // asymmetric errors
+  vector<string> exh;
+  vector<string> eyl;
+  vector<string> eyh;
+
+  static optional<csv_schema_t> FromString(const string& options);
+  bool IsDefault() const { return y.empty(); } // x y ex ey as in the classic root format
+  bool HasAsymmErrors() const { return !(exl.empty() && exh.empty() && eyl.empty() && eyh.empty()); }
+};
+
+//**************************************************************************************************
+/**
+ * Fast reader for numeric csv files. Plain files are memory-mapped, gzip compressed files (.gz) are
+ * inflated in memory. Only the columns selected in the schema are parsed (via std::from_chars).
+ */
+//**************************************************************************************************
+class CSVReader
+{
+public:
+  CSVReader(const csv_schema_t& schema);
+  ~CSVReader() = default;
+  CSVReader(const CSVReader& other) = delete;
+  CSVReader(CSVReader&&) = delete;
+  CSVReader& operator=(const CSVReader& other) = delete;
+  CSVReader& operator=(CSVReader&& other) = delete;
+
+  bool Read(const string& fileName);
+  const vector<double_t>* GetColumn(const string& column) const; // nullptr if column was not read
+  size_t GetNumRows() const { return mNumRows; }
+  const csv_schema_t& GetSchema() const { return mSchema; } // including the columns used by default
+
+  static bool IsCSVFile(const string& fileName);
+
+private:
+  bool Parse(std::string_view content, const string& fileName);
+  bool ResolveColumns(const vector<string>& columnNames, const string& fileName);
+  optional<size_t> GetColumnIndex(const string& column) const;
+
+  csv_schema_t mSchema;
+  vector<string> mColumnNames;
+  map<size_t, vector<double_t>> mColumns; // column index, values
+  size_t mNumRows{};
+};
+
+} // end namespace PlottingFramework
+#endif /* CSVReader_h */
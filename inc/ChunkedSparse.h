@@ -0,0 +1,51 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ChunkedSparse_h
+#define ChunkedSparse_h
+
+#include "PlottingFramework.h"
+
+#include <functional>
+
+class TObject;
+class THnBase;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Sparse histograms that are too large to be loaded as a whole. They are converted (e.g. with the
+ * plot-sparse app) into a directory of chunks, each of which is a small THnSparse with the same axes
+ * holding a part of the filled bins. Next to this directory a placeholder object with the name of the
+ * histogram is stored, which is put in the data buffer instead of the histogram itself. Projections
+ * are then computed by streaming through the chunks with only one of them in memory at a time.
+ */
+//**************************************************************************************************
+class ChunkedSparse
+{
+public:
+  // each input is "file.root:path/to/sparse"; the bins of all inputs are added up
+  static bool Convert(const vector<string>& inputNames, const string& outputFileName, const string& name, uint64_t binsPerChunk = 1000000);
+
+  static bool IsPlaceholder(const TObject* obj);
+  static void SetFileName(TObject* placeholder, const string& fileName); // remembers where the chunks are stored
+  static bool ForEachChunk(const TObject* placeholder, const std::function<bool(THnBase*)>& process);
+};
+
+} // end namespace PlottingFramework
+#endif /* ChunkedSparse_h */
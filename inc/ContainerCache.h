@@ -0,0 +1,71 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ContainerCache_h
+#define ContainerCache_h
+
+#include "PlottingFramework.h"
+
+#include <list>
+
+class TKey;
+class TCollection;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Cache for lists and similar containers read from the input files. Analysis outputs often store
+ * hundreds of histograms in a single list, which otherwise has to be read and decompressed completely
+ * again whenever further members are needed (by a later call or by another input using the same file).
+ * The containers are identified by the path of their key and are dropped when the key changed. The
+ * memory limit applies to the uncompressed size of the containers; least recently used ones are dropped first.
+ */
+//**************************************************************************************************
+class ContainerCache
+{
+public:
+  ContainerCache(uint64_t maxSize = 512u * 1024u * 1024u);
+  ~ContainerCache();
+  ContainerCache(const ContainerCache& other) = delete;
+  ContainerCache(ContainerCache&&) = delete;
+  ContainerCache& operator=(const ContainerCache& other) = delete;
+  ContainerCache& operator=(ContainerCache&& other) = delete;
+
+  void SetMaxSize(uint64_t maxSize); // bytes (0: disabled)
+  TCollection* Get(TKey* key);       // nullptr if not in the cache
+  bool Add(TKey* key, TCollection* container); // the cache takes ownership if true is returned
+  void Clear();
+
+private:
+  struct entry_t {
+    unique_ptr<TCollection> container;
+    int64_t seekKey;
+    uint32_t datime;
+    uint64_t size;
+  };
+  static string GetIdentifier(TKey* key);
+  void Remove(const string& identifier);
+
+  uint64_t mMaxSize;
+  uint64_t mSize{};
+  map<string, entry_t> mEntries; // key path, cached container
+  std::list<string> mUsage;      // key paths, most recently used first
+};
+
+} // end namespace PlottingFramework
+#endif /* ContainerCache_h */
@@ -0,0 +1,89 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef CopyOnWrite_h
+#define CopyOnWrite_h
+
+#include "PlottingFramework.h"
+#include <type_traits>
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Pointer with copy-on-write semantics. Copies share the pointee and are therefore O(1).
+ * The pointee is duplicated (with its dynamic type) only once a shared copy is modified via Mutable().
+ * Not thread-safe: objects must not be modified while copies are accessed from other threads.
+ */
+//**************************************************************************************************
+template <typename T>
+class cow_ptr
+{
+public:
+  cow_ptr() : cow_ptr(std::make_shared<T>()) {}
+  template <typename U>
+  cow_ptr(shared_ptr<U> ptr) : mPtr(std::move(ptr)), mCopy(&Copy<U>)
+  {
+  }
+
+  const T& operator*() const { return Get(); }
+  const T* operator->() const { return &Get(); }
+  const T& Get() const
+  {
+    if constexpr (std::is_default_constructible_v<T>) {
+      // moved-from pointers behave like pointers to a default-constructed object
+      static const T empty{};
+      if (!mPtr) return empty;
+    }
+    return *mPtr;
+  }
+
+  T& Mutable()
+  {
+    if constexpr (std::is_default_constructible_v<T>) {
+      if (!mPtr) *this = cow_ptr();
+    }
+    if (mPtr.use_count() > 1) mPtr = mCopy(*mPtr);
+    return *mPtr;
+  }
+  template <typename U>
+  U& Mutable()
+  {
+    return static_cast<U&>(Mutable());
+  }
+  template <typename U>
+  const U* As() const
+  {
+    return dynamic_cast<const U*>(mPtr.get());
+  }
+  bool IsShared() const { return mPtr.use_count() > 1; }
+
+private:
+  template <typename U>
+  static shared_ptr<T> Copy(const T& object)
+  {
+    return std::make_shared<U>(static_cast<const U&>(object));
+  }
+
+  shared_ptr<T> mPtr;
+  shared_ptr<T> (*mCopy)(const T&); // copies the pointee preserving its dynamic type
+};
+
+} // end namespace PlottingFramework
+#endif /* CopyOnWrite_h */
@@ -0,0 +1,68 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FilePool_h
+#define FilePool_h
+
+#include "PlottingFramework.h"
+
+#include <list>
+
+class TFile;
+class TDirectory;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Pool of open input files that is shared by all input identifiers while the data for the plots are
+ * read. Files are identified by their canonical path, such that a file that is used by several inputs
+ * (e.g. with different entry points "file.root:subdir") is opened only once and its directories are
+ * resolved only once. The least recently used files are closed when the maximum number of open files
+ * is exceeded.
+ */
+//**************************************************************************************************
+class FilePool
+{
+public:
+  FilePool(uint32_t maxOpenFiles = 64);
+  ~FilePool();
+  FilePool(const FilePool& other) = delete;
+  FilePool(FilePool&&) = delete;
+  FilePool& operator=(const FilePool& other) = delete;
+  FilePool& operator=(FilePool&& other) = delete;
+
+  void SetMaxOpenFiles(uint32_t maxOpenFiles);
+  TFile* Open(const string& fileName); // nullptr if the file cannot be opened
+  // resolves the leading directories of the path, which are removed from it
+  TDirectory* GetDirectory(TDirectory* directory, vector<string>& path);
+  void Clear();
+
+private:
+  struct file_entry_t {
+    unique_ptr<TFile> file;
+    map<std::pair<TDirectory*, string>, TDirectory*> subDirectories; // (parent, name), directory
+  };
+  file_entry_t* FindEntry(TFile* file);
+
+  uint32_t mMaxOpenFiles;
+  map<string, file_entry_t> mFiles; // canonical path, open file
+  std::list<string> mUsage;         // canonical paths, most recently used first
+};
+
+} // end namespace PlottingFramework
+#endif /* FilePool_h */
@@ -0,0 +1,55 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FileWatcher_h
+#define FileWatcher_h
+
+#include "PlottingFramework.h"
+
+#include <filesystem>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Waits for modifications of a set of files. On linux this is based on inotify (watching the
+ * directories of the files in order to also catch files that are replaced), otherwise the
+ * modification times of the files are polled.
+ */
+//**************************************************************************************************
+class FileWatcher
+{
+public:
+  FileWatcher();
+  ~FileWatcher();
+  FileWatcher(const FileWatcher& other) = delete;
+  FileWatcher(FileWatcher&&) = delete;
+  FileWatcher& operator=(const FileWatcher& other) = delete;
+  FileWatcher& operator=(FileWatcher&& other) = delete;
+
+  void SetFiles(const vector<string>& fileNames);
+  vector<string> WaitForChanges(uint32_t settleTimeMs = 500);
+
+private:
+  set<string> mFiles;
+  map<string, std::filesystem::file_time_type> mTimestamps;
+  int32_t mInotify{-1};
+  map<int32_t, string> mWatchedDirectories; // watch descriptor, directory
+};
+
+} // end namespace PlottingFramework
+#endif /* FileWatcher_h */
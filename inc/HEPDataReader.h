@@ -0,0 +1,91 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEPDataReader_h
+#define HEPDataReader_h
+
+#include "PlottingFramework.h"
+
+#include <string_view>
+
+class TObject;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Reader for HEPData tables, either in the yaml format of the submissions (.yaml, .yml) or as csv
+ * export (to be marked with the option 'hepdata', e.g. "Table1.csv:hepdata"); both may be gzipped.
+ * Each dependent variable of the table is provided as TGraphAsymmErrors named "<table>/y<j>"
+ * (counting from 1) with all uncertainties added in quadrature, or "<table>/y<j>/<label>" with only
+ * the uncertainties of the given label (e.g. "Table1/y1/stat"). Only the first independent variable
+ * is used as x. The file is processed in a single pass and the values of dependent variables that
+ * are not requested are skipped.
+ */
+//**************************************************************************************************
+class HEPDataReader
+{
+public:
+  HEPDataReader() = default;
+  ~HEPDataReader() = default;
+  HEPDataReader(const HEPDataReader& other) = delete;
+  HEPDataReader(HEPDataReader&&) = delete;
+  HEPDataReader& operator=(const HEPDataReader& other) = delete;
+  HEPDataReader& operator=(HEPDataReader&& other) = delete;
+
+  bool Read(const string& fileName, const vector<string>& requiredNames);
+  map<string, unique_ptr<TObject>>& GetObjects() { return mObjects; } // name, object
+
+  static bool IsHEPDataFile(const string& fileName); // file name optionally followed by ':' and options
+  static string GetTableName(const string& fileName);
+
+private:
+  struct error_t {
+    string label;
+    double_t plus{};
+    double_t minus{};
+    bool isRelative{}; // given in percent of the value
+  };
+  struct point_t {
+    double_t value;
+    vector<error_t> errors;
+  };
+  struct bin_t {
+    double_t value;
+    double_t low;
+    double_t high;
+  };
+
+  bool IsRequired(size_t variable) const;
+  bool ParseYAML(std::string_view content, const string& fileName);
+  bool ParseFlow(std::string_view text, size_t& position, vector<std::string_view>& path, bool emit);
+  bool BeginItem(const vector<std::string_view>& path);
+  void SetValue(const vector<std::string_view>& path, std::string_view value);
+  bool ParseCSV(std::string_view content, const string& fileName);
+  void CreateGraphs(const string& fileName);
+
+  string mTableName;
+  vector<string> mRequiredNames;         // without table name
+  uint8_t mNumIndependentVariables{};
+  vector<bin_t> mBins;                   // values of first independent variable
+  vector<vector<point_t>> mVariables;    // values of the dependent variables
+  vector<bool> mIsVariableRequired;
+  map<string, unique_ptr<TObject>> mObjects;
+};
+
+} // end namespace PlottingFramework
+#endif /* HEPDataReader_h */
@@ -26,6 +26,7 @@ namespace PlottingFramework
 string expand_path(const string& path);
 vector<string> split_string(const string& argString, char delimiter, bool onlyFirst = false);
 bool file_exists(const std::string& name);
+vector<string> expand_glob(const string& pattern); // sorted list of matching files (pattern itself if it contains no wildcards)
 
 inline bool str_contains(const std::string& str, const std::string& substr, bool reverseSearch = false)
 {
@@ -142,8 +143,9 @@ std::vector<T> string_to_vector(string itemString)
   return items;
 }
 
+// labels are taken as tree paths directly, so string literals do not need an intermediate std::string
 template <typename T>
-void put_in_tree(ptree& tree, const optional<T>& var, const string& label)
+void put_in_tree(ptree& tree, const optional<T>& var, const ptree::path_type& label)
 {
   if constexpr (is_vector<T>{}) // vectors are stored as comma separated strings
   {
@@ -157,7 +159,7 @@ void put_in_tree(ptree& tree, const optional<T>& var, const string& label)
 }
 
 template <typename T>
-void read_from_tree(const ptree& tree, optional<T>& var, const string& label)
+void read_from_tree(const ptree& tree, optional<T>& var, const ptree::path_type& label)
 {
   if constexpr (is_vector<T>{}) // vectors are stored as comma separated strings
   {
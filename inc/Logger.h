@@ -0,0 +1,138 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef Logger_h
+#define Logger_h
+
+#include <fmt/core.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Backend of the logging macros defined in Logging.h.
+ * Messages are formatted by the calling thread and put into a lock-free ring buffer, from which a
+ * background thread writes them in batches to the console (and optionally as JSON lines to a file).
+ * The verbosity can be changed at runtime, globally or per module (source file name without
+ * extension). Messages of disabled levels are neither formatted nor queued.
+ */
+//**************************************************************************************************
+class Logger
+{
+public:
+  // verbosity levels (a message is shown if its level is smaller or equal to the verbosity)
+  enum level_t : int8_t {
+    error,
+    warning,
+    info,
+    log,
+    debug,
+  };
+  // kind of message, which determines prefix, output stream and level
+  enum kind_t : uint8_t {
+    error_message,
+    warning_message,
+    info_message,
+    print_message,
+    print_inline_message,
+    log_message,
+    debug_message,
+  };
+  static constexpr level_t GetLevel(kind_t kind)
+  {
+    switch (kind) {
+      case error_message: return error;
+      case warning_message: return warning;
+      case log_message: return log;
+      case debug_message: return debug;
+      default: return info;
+    }
+  }
+
+  static Logger& Instance();
+  static uint16_t RegisterModule(const char* fileName);
+  static bool IsEnabled(kind_t kind, uint16_t module) { return GetLevel(kind) <= sModuleLevels[module].load(std::memory_order_relaxed); }
+
+  static void SetVerbosity(level_t level);
+  static void SetModuleVerbosity(const std::string& module, level_t level);
+  static bool SetFilters(const std::string& filters); // comma separated list of module=level, where level is a number or name
+  static bool SetJSONOutput(const std::string& fileName);
+  static void SetContext(const std::string& plotName, const std::string& figureGroup); // per thread, shown in JSON output
+
+  void Push(kind_t kind, uint16_t module, std::string&& message);
+  void Flush();
+
+private:
+  Logger();
+  ~Logger() = default;
+  Logger(const Logger& other) = delete;
+  Logger(Logger&&) = delete;
+  Logger& operator=(const Logger& other) = delete;
+  Logger& operator=(Logger&& other) = delete;
+
+  struct message_t {
+    kind_t kind{};
+    uint16_t module{};
+    int64_t time{}; // ms since epoch
+    std::string text;
+    std::string plotName;
+    std::string figureGroup;
+  };
+  struct slot_t {
+    std::atomic<uint64_t> sequence;
+    message_t message;
+  };
+
+  bool TryPush(message_t& message);
+  bool TryPop(message_t& message);
+  bool Drain();
+  void Write(const message_t& message, std::string& textBuffer, FILE*& textStream);
+  void Stop();
+
+  static constexpr uint16_t kMaxModules{256};
+  static constexpr uint64_t kCapacity{4096}; // must be power of two
+  inline static std::array<std::atomic<level_t>, kMaxModules> sModuleLevels{};
+
+  std::array<slot_t, kCapacity> mSlots;
+  alignas(64) std::atomic<uint64_t> mEnqueuePos{};
+  alignas(64) uint64_t mDequeuePos{};
+  std::atomic<uint64_t> mWritten{};
+  std::atomic<bool> mIsRunning{};
+  FILE* mJSONStream{};
+  std::mutex mSinkMutex;
+  std::condition_variable mSinkCondition;
+  std::thread mSinkThread;
+
+  std::mutex mModuleMutex;
+  std::vector<std::string> mModuleNames;
+  std::map<std::string, level_t> mModuleFilters;
+  level_t mVerbosity{debug};
+};
+
+} // end namespace PlottingFramework
+#endif /* Logger_h */
@@ -19,7 +19,9 @@
 #define Logging_h
 
 #include <fmt/core.h>
+#include "Logger.h"
 
+// compile-time suppression (at runtime the verbosity can be reduced further via Logger::SetVerbosity)
 #define DEBUG_LVL 2 // < 2: no debug, < 1: no warnings, < 0 no errors
 #define COUT_LVL 2  // < 2: no log,   < 1: no info,     < 0 no print
 
@@ -61,52 +63,29 @@
 #endif
 
 // some preprocessor macros for logging, printing and debugging
-#define DEBUG(s, ...)                              \
-  {                                                \
-    fmt::print(stderr, CYAN_ "[ DEBU ]" _END " "); \
-    fmt::print(stderr, s, ##__VA_ARGS__);          \
-    fmt::print(stderr, "\n");                      \
-  }
-#define WARNING(s, ...)                              \
-  {                                                  \
-    fmt::print(stderr, YELLOW_ "[ WARN ]" _END " "); \
-    fmt::print(stderr, s, ##__VA_ARGS__);            \
-    fmt::print(stderr, "\n");                        \
-  }
-#define ERROR(s, ...)                             \
-  {                                               \
-    fmt::print(stderr, RED_ "[ ERR  ]" _END " "); \
-    fmt::print(stderr, s, ##__VA_ARGS__);         \
-    fmt::print(stderr, "\n");                     \
-  }
-#define LOG(s, ...)                         \
-  {                                         \
-    fmt::print(GREEN_ "[ LOG  ]" _END " "); \
-    fmt::print(s, ##__VA_ARGS__);           \
-    fmt::print("\n");                       \
-  }
-#define INFO(s, ...)              \
-  {                               \
-    fmt::print("[ INFO ] ");      \
-    fmt::print(s, ##__VA_ARGS__); \
-    fmt::print("\n");             \
-  }
-#define PRINT(s, ...)                \
-  {                                  \
-    fmt::print(stderr, "       | "); \
-    fmt::print(s, ##__VA_ARGS__);    \
-    fmt::print("\n");                \
-  }
-#define PRINT_INLINE(s, ...)      \
-  {                               \
-    fmt::print(s, ##__VA_ARGS__); \
+// the messages are passed to the logger backend, which allows to change the verbosity at runtime
+// (globally or per source file) and writes them asynchronously; arguments of disabled messages are not evaluated
+#define LOG_MESSAGE_(kind, s, ...)                                                                                                      \
+  {                                                                                                                                     \
+    static const uint16_t loggerModule_ = PlottingFramework::Logger::RegisterModule(__FILE__);                                          \
+    if (PlottingFramework::Logger::IsEnabled(PlottingFramework::Logger::kind, loggerModule_)) {                                         \
+      PlottingFramework::Logger::Instance().Push(PlottingFramework::Logger::kind, loggerModule_, fmt::format(s, ##__VA_ARGS__));        \
+    }                                                                                                                                   \
   }
+#define DEBUG(s, ...) LOG_MESSAGE_(debug_message, s, ##__VA_ARGS__)
+#define WARNING(s, ...) LOG_MESSAGE_(warning_message, s, ##__VA_ARGS__)
+#define ERROR(s, ...) LOG_MESSAGE_(error_message, s, ##__VA_ARGS__)
+#define LOG(s, ...) LOG_MESSAGE_(log_message, s, ##__VA_ARGS__)
+#define INFO(s, ...) LOG_MESSAGE_(info_message, s, ##__VA_ARGS__)
+#define PRINT(s, ...) LOG_MESSAGE_(print_message, s, ##__VA_ARGS__)
+#define PRINT_INLINE(s, ...) LOG_MESSAGE_(print_inline_message, s, ##__VA_ARGS__)
 #define PRINT_SEPARATOR                     \
   {                                         \
     PRINT(fmt::format("{:-<{}}", "-", 60)); \
   }
 #define HERE                                                                              \
   {                                                                                       \
+    PlottingFramework::Logger::Instance().Flush();                                        \
     fmt::print("[ ---> ] Line {} in function {} ({})", __LINE__, __FUNCTION__, __FILE__); \
     fmt::print("\n");                                                                     \
   }
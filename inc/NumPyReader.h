@@ -0,0 +1,84 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef NumPyReader_h
+#define NumPyReader_h
+
+#include "PlottingFramework.h"
+#include "TextFile.h"
+
+class TObject;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Reader for numpy arrays stored in .npy files or .npz archives. Data is defined via the names of
+ * the arrays ("<name>/<role>" for the members of an archive):
+ *   - "<name>" with shape (n, 2), (n, 3), (n, 4): TGraph(Errors) with columns x, y[, ex], ey
+ *   - "<name>/x", "<name>/y" and optionally "<name>/ex", "<name>/ey": TGraph(Errors)
+ *   - "<name>/values" (or "<name>" itself) with "<name>/edges" (n+1 values) or "<name>/range"
+ *     (min, max) and optionally "<name>/errors": TH1D, for 2d values with "<name>/xedges",
+ *     "<name>/yedges" (or "<name>/xrange", "<name>/yrange"): TH2D; evenly spaced edges result in
+ *     fixed binning
+ * For a single .npy file "<dir>/<name>.npy" the additional arrays are taken from sidecar files
+ * "<dir>/<name>.<role>.npy". Plain .npy files and uncompressed archive members are memory-mapped
+ * and converted to the root objects with one bulk copy, compressed members are inflated first.
+ */
+//**************************************************************************************************
+class NumPyReader
+{
+public:
+  NumPyReader() = default;
+  ~NumPyReader() = default;
+  NumPyReader(const NumPyReader& other) = delete;
+  NumPyReader(NumPyReader&&) = delete;
+  NumPyReader& operator=(const NumPyReader& other) = delete;
+  NumPyReader& operator=(NumPyReader&& other) = delete;
+
+  bool Read(const string& fileName, const vector<string>& requiredNames);
+  map<string, unique_ptr<TObject>>& GetObjects() { return mObjects; } // name, object
+  const vector<string>& GetSidecarFileNames() const { return mSidecarFileNames; } // files read in addition to the requested one
+
+  static bool IsNumPyFile(const string& fileName);
+
+private:
+  struct array_t {
+    char type{};      // 'f' (float), 'i' (signed int), 'u' (unsigned int), 'b' (bool)
+    uint8_t itemSize{};
+    bool isSwapped{}; // big-endian data
+    vector<size_t> shape;
+    vector<size_t> strides; // in elements
+    std::string_view data;
+  };
+
+  bool AddArray(const string& name, std::string_view content, const string& fileName);
+  bool ReadArchive(std::string_view content, const string& fileName, const vector<string>& requiredNames);
+  const array_t* GetArray(const string& name) const;
+  unique_ptr<TObject> CreateObject(const string& name, const string& fileName) const;
+  unique_ptr<TObject> CreateHistogram(const string& name, const array_t& values, const string& fileName) const;
+  static void CopyValues(const array_t& array, size_t offset, size_t stride, size_t n, double_t* output, size_t outputStride = 1);
+
+  vector<unique_ptr<TextFile>> mFiles; // memory-mapped input files
+  vector<vector<char>> mInflatedMembers;
+  map<string, array_t> mArrays;
+  map<string, unique_ptr<TObject>> mObjects;
+  vector<string> mSidecarFileNames;
+};
+
+} // end namespace PlottingFramework
+#endif /* NumPyReader_h */
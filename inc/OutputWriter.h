@@ -0,0 +1,79 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OutputWriter_h
+#define OutputWriter_h
+
+#include "PlottingFramework.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Output stage that moves finished plot files to their final destination in the background.
+ * Files are first written to a local staging area and then handed over to writer threads,
+ * which create the target directories natively and put the files in place via atomic rename.
+ */
+//**************************************************************************************************
+class OutputWriter
+{
+public:
+  OutputWriter(uint8_t nThreads = 1);
+  ~OutputWriter();
+  OutputWriter(const OutputWriter& other) = delete;
+  OutputWriter(OutputWriter&&) = delete;
+  OutputWriter& operator=(const OutputWriter& other) = delete;
+  OutputWriter& operator=(OutputWriter&& other) = delete;
+
+  void SetNumThreads(uint8_t nThreads);
+  bool CreateDirectories(const string& path);
+  string GetStagingPath(const string& fileName);
+  void Commit(const string& stagingPath, const string& targetPath);
+  bool Flush();
+
+private:
+  void StartThreads();
+  void StopThreads();
+  void ProcessQueue();
+  bool MoveToTarget(const string& stagingPath, const string& targetPath, string& error);
+
+  uint8_t mNumThreads;
+  vector<std::thread> mThreads;
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueCondition;
+  std::condition_variable mIdleCondition;
+  std::deque<std::pair<string, string>> mQueue; // stagingPath, targetPath
+  set<string> mActiveTargets;                    // targets that are currently written by one of the threads
+  uint32_t mPendingJobs{};
+  bool mStopThreads{};
+  vector<string> mErrors;
+
+  std::mutex mDirectoryMutex;
+  set<string> mCreatedDirectories;
+  std::filesystem::path mStagingDirectory;
+  std::atomic<uint64_t> mStagingCounter{};
+};
+
+} // end namespace PlottingFramework
+#endif /* OutputWriter_h */
@@ -26,6 +26,8 @@
 #include "Rtypes.h"
 
 #include "PlottingFramework.h"
+#include "StringPool.h"
+#include "CopyOnWrite.h"
 
 namespace PlottingFramework
 {
@@ -86,11 +88,15 @@ public:
   };
 
   Plot() = default;
+  Plot(const Plot& otherPlot);
+  Plot(Plot&& otherPlot) = default;
+  Plot& operator=(const Plot& otherPlot);
+  Plot& operator=(Plot&& otherPlot) = default;
   Plot(const ptree& plotTree);
   Plot(const string& name, const string& figureGroupAndCategory, const optional<string>& plotTemplateName = std::nullopt);
-  Pad& operator[](uint8_t padID) { return mPads[padID]; }
-  Pad& GetPad(uint8_t padID) { return mPads[padID]; }
-  Pad& GetPadDefaults() { return mPads[0]; }
+  Pad& operator[](uint8_t padID) { return mPads.Mutable()[padID]; }
+  Pad& GetPad(uint8_t padID) { return mPads.Mutable()[padID]; }
+  Pad& GetPadDefaults() { return mPads.Mutable()[0]; }
   void operator+=(const Plot& plot);
   friend Plot operator+(const Plot& templatePlot, const Plot& plot);
   Plot(const Plot& otherPlot, const string& name, const string& figureGroup, const optional<string>& figureCategory = std::nullopt);
@@ -113,17 +119,20 @@ public:
 protected:
   friend class PlotManager;
   friend class PlotPainter;
+  friend class TestAccess;
 
   void SetFigureGroup(const string& figureGroup);
+  Plot SharedCopy() const;
 
   // accessors for internal use by manager and painter
-  const auto& GetName() const { return mName; }
-  const auto& GetFigureGroup() const { return mFigureGroup; }
+  const string& GetName() const { return mName; }
+  const string& GetFigureGroup() const { return mFigureGroup; }
   const auto& GetFigureCategory() const { return mFigureCategory; }
   const auto& GetPlotTemplateName() const { return mPlotTemplateName; }
-  const auto& GetUniqueName() const { return mUniqueName; }
+  const string& GetUniqueName() const { return mUniqueName; }
   ptree GetPropertyTree() const;
-  auto& GetPads() { return mPads; }
+  map<uint8_t, Pad>& GetPads() { return mPads.Mutable(); }
+  const map<uint8_t, Pad>& GetPads() const { return mPads.Get(); }
 
   const auto& GetHeight() const { return mPlotDimensions.height; }
   const auto& GetWidth() const { return mPlotDimensions.width; }
@@ -140,16 +149,20 @@ private:
     optional<int32_t> height;
     optional<bool> fixAspectRatio;
   };
+  struct shared_copy_t {
+  };
+  Plot(const Plot& otherPlot, shared_copy_t);
   void UpdateUniqueName();
+  static constexpr auto GetPropertyTable(); // labels and member paths of the optional properties
 
-  string mName;
-  string mFigureGroup;
+  interned_string_t mName;
+  interned_string_t mFigureGroup;
   optional<string> mFigureCategory;
-  string mUniqueName;
+  interned_string_t mUniqueName;
   optional<string> mPlotTemplateName;
   dimension_t mPlotDimensions;
   layout_t mFill;
-  map<uint8_t, Pad> mPads;
+  cow_ptr<map<uint8_t, Pad>> mPads; // shared between copies of the plot until one of them is modified
 };
 
 //**************************************************************************************************
@@ -243,6 +256,9 @@ protected:
   auto& GetData() { return mData; }
   auto& GetLegendBoxes() { return mLegendBoxes; }
   auto& GetTextBoxes() { return mTextBoxes; }
+  const auto& GetData() const { return mData; }
+  const auto& GetLegendBoxes() const { return mLegendBoxes; }
+  const auto& GetTextBoxes() const { return mTextBoxes; }
   uint8_t GetDataCount() const { return mData.size(); };
 
   const auto& GetAxes() const { return mAxes; }
@@ -288,6 +304,7 @@ protected:
   const auto& GetRefFunc() const { return mRefFunc; }
 
 private:
+  static constexpr auto GetPropertyTable();
   struct pad_position_t {
     optional<double_t> xlow;
     optional<double_t> ylow;
@@ -343,10 +360,10 @@ private:
   optional<string> mRefFunc;
 
   map<char, Axis> mAxes;
-  vector<shared_ptr<Data>> mData;
+  vector<cow_ptr<Data>> mData;
 
-  vector<shared_ptr<LegendBox>> mLegendBoxes;
-  vector<shared_ptr<TextBox>> mTextBoxes;
+  vector<cow_ptr<LegendBox>> mLegendBoxes;
+  vector<cow_ptr<TextBox>> mTextBoxes;
 };
 
 //**************************************************************************************************
@@ -369,6 +386,7 @@ public:
 
   Data& SetInputID(const string& inputIdentifier);
   const string& GetInputID() const { return mInputIdentifier; }
+  data_key_t GetDataKey() const { return MakeDataKey(mInputIdentifier, mName); }
 
   virtual Data& SetLayout(const Data& dataLayout);
   virtual Data& ApplyLayout(const Data& dataLayout);
@@ -420,12 +438,11 @@ protected:
   friend class PlotPainter;
   friend class Plot;
 
-  virtual std::shared_ptr<Data> Clone() const { return std::make_shared<Data>(*this); }
   virtual ptree GetPropertyTree() const;
   void SetType(const string& type) { mType = type; }
 
   const auto& GetType() const { return mType; }
-  const auto& GetName() const { return mName; }
+  const string& GetName() const { return mName; }
   const auto& GetLegendLabel() const { return mLegend.label; }
   const auto& GetLegendID() const { return mLegend.identifier; }
   const auto& GetMarkerColor() const { return mMarker.color; }
@@ -462,11 +479,12 @@ protected:
   };
 
 private:
+  static constexpr auto GetPropertyTable();
   bool mDefinesFrame{};
 
   string mType; // for introspection: "data" or "ratio"
-  string mName;
-  string mInputIdentifier;
+  interned_string_t mName;
+  interned_string_t mInputIdentifier;
 
   optional<string> mDrawingOptions;
   optional<drawing_options_t> mDrawingOptionAlias;
@@ -578,18 +596,18 @@ protected:
   friend class PlotPainter;
   friend class Plot;
 
-  virtual std::shared_ptr<Data> Clone() const { return std::make_shared<Ratio>(*this); }
 
   ptree GetPropertyTree() const;
-  const auto& GetDenomIdentifier() const { return mDenomInputIdentifier; }
-  const auto& GetDenomName() const { return mDenomName; }
+  const string& GetDenomIdentifier() const { return mDenomInputIdentifier; }
+  const string& GetDenomName() const { return mDenomName; }
+  data_key_t GetDenomDataKey() const { return MakeDataKey(mDenomInputIdentifier, mDenomName); }
 
   const bool& GetIsCorrelated() const { return mIsCorrelated; }
   const auto& GetProjInfoDenom() const { return mProjInfoDenom; }
 
 private:
-  string mDenomName;
-  string mDenomInputIdentifier;
+  interned_string_t mDenomName;
+  interned_string_t mDenomInputIdentifier;
   bool mIsCorrelated{};
   optional<proj_info_t> mProjInfoDenom;
 };
@@ -666,6 +684,7 @@ protected:
   const auto& GetTickOrientation() const { return mTickOrientation; }
 
 private:
+  static constexpr auto GetPropertyTable();
   struct axisTextProperties_t {
     optional<int16_t> font;
     optional<float_t> size;
@@ -756,6 +775,7 @@ private:
   Box(const ptree& boxTree);
 
   auto GetThis() { return static_cast<BoxType*>(this); }
+  static constexpr auto GetPropertyTable();
 
   struct position_t {
     optional<double_t> x;
@@ -858,6 +878,7 @@ protected:
   const auto& GetDefaultFillOpacity() const { return mFillDefault.scale; }
 
 private:
+  static constexpr auto GetPropertyTable();
   optional<string> mTitle;
   optional<uint8_t> mNumColumns;
   vector<LegendEntry> mLegendEntries;           // this is transient and will be generated automatically
@@ -925,6 +946,7 @@ protected:
   const auto& GetTextSize() const { return mText.scale; }
 
 private:
+  static constexpr auto GetPropertyTable();
   optional<string> mLabel;
   optional<string> mRefDataName;
   optional<string> mDrawStyle;
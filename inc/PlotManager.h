@@ -21,11 +21,21 @@
 #include "PlottingFramework.h"
 #include "Plot.h"
 
+#include <filesystem>
+
 class TApplication;
 class TCanvas;
+class TFile;
+class TKey;
+class TDirectory;
+class TCollection;
 
 namespace PlottingFramework
 {
+class OutputWriter;
+class FilePool;
+class ContainerCache;
+
 //**************************************************************************************************
 /**
  * Central manager class.
@@ -46,19 +56,45 @@ public:
   void SetOutputDirectory(const string& path);
   void SetUseUniquePlotNames(bool useUniquePlotNames = true);          // if true plot names are set to plotName_IN_figureGroup[.pdf,...]
   void SetOutputFileName(const string& fileName = "ResultPlots.root"); // in case canvases should be saved in .root file
+  void SetOutputFileCompression(const string& algorithm = "zlib", uint8_t level = 1); // "zlib", "lzma", "lz4", "zstd"
+  void SetOutputWriterThreads(uint8_t nThreads);                       // plot files are written in the background while the next plots are painted
+  bool FlushOutput();                                                  // wait until all plot files are written (returns false in case of errors)
+
+  // number of neighbouring plots that are kept painted while scrolling through the plots in interactive mode
+  void SetViewerCacheWindow(uint32_t nNeighbours = 3);
 
   // settings related to the input root files
-  void AddInputDataFiles(const string& inputIdentifier, const vector<string>& inputFilePathList);
+  void AddInputDataFiles(const string& inputIdentifier, const vector<string>& inputFilePathList); // glob patterns are expanded
   void AddInputDataFile(const string& inputIdentifier, const string& inputFilePath);
+  // add up the same-named data of all (root) files of this input instead of taking the first match (on-the-fly hadd)
+  void SetMergeInputFiles(const string& inputIdentifier, bool merge = true);
   void DumpInputDataFiles(const string& configFileName) const; // save input file paths to config file
   void LoadInputDataFiles(const string& configFileName);       // load the input file paths from config file
+  void ClearInputDataFiles();                                  // forget about all input file paths
+  vector<string> GetInputFileNames() const;                    // paths of all input files that are currently defined
+  void SetReportIOStatistics(bool report = true);              // print bytes read, seeks, keys read, etc. per input after creating plots
+  void SetReadPrefetchSize(uint32_t megaBytes = 32);           // objects of a directory are read in file order via sequential reads of up to this size
+  void SetDecompressionThreads(uint32_t nThreads);             // threads that decompress and deserialize the objects read (0: all available cores)
+  void SetMaxOpenInputFiles(uint32_t maxOpenFiles = 64);       // files used by several inputs are opened only once (least recently used ones are closed)
+  void SetContainerCacheSize(uint32_t megaBytes = 512);        // lists in the input files are kept in memory for further requests
+
+  // histograms can be filled from trees in the input files ("<tree>::<expression>>>(<binning>)[|<selection>]" as data name)
+  void SetTreeCacheFile(const string& fileName); // root file where filled histograms are cached
+  void SetEventLoopThreads(uint32_t nThreads);   // threads used for the event loops (0: all available cores)
 
   // remove all loaded input data (histograms, graphs, ...) from the manager (usually not needed)
   void ClearDataBuffer();
+  // input files that were modified after data was read from them (relevant for long-lived managers)
+  vector<string> GetModifiedInputFiles() const;
+  // all files the plots depend on (input files and files registered while reading, e.g. sidecar files of numpy arrays)
+  vector<string> GetWatchedFiles() const;
+  // drops data read from modified input files; returns the buffer entries (inputID, name) that have to be re-read
+  set<std::pair<string, string>> InvalidateModifiedInputFiles();
 
   // add plots or templates for plots to the manager
   void AddPlot(Plot& plot);
   void AddPlotTemplate(Plot& plotTemplate);
+  void ClearPlots(); // remove all plots and templates
 
   // saving plot definitions to external file (which can e.g. be read by the command-line plotting app
   // included in the framework)
@@ -68,7 +104,7 @@ public:
   // read plots from plot definition file created by the above functions (regular expressions are
   // allowed); the mode variable can be "load" to add these plots to the manager, or "find" to check
   // only if the specified plots exist (prints out this info)
-  void ExtractPlotsFromFile(const string& plotFileName,
+  bool ExtractPlotsFromFile(const string& plotFileName,
                             const string& mode = "load",
                             const string& plotName = ".*",
                             const string& group = ".*",
@@ -81,37 +117,112 @@ public:
   // canvas "pdf", "png": plots will be stored as such files in the specified output directory
   // (subdirectories are created for the figure groups and categories) "macro": plots are saved as
   // root macros (.C) "file": all plots (canvases) are put in a .root file with a directory
-  // structure corresponding to figure groups and categories
+  // structure corresponding to figure groups and categories (each canvas is written as soon as it is painted)
+  // several output formats can be combined in a comma separated list (e.g. "pdf,png:2,thumb"), in which
+  // case each plot is painted only once and then saved in all of them; "png:<scale>" renders png files
+  // with higher resolution and "thumb:<width>" produces additional small png previews (default width 200)
+  // "bundle" collects all plots of a figure category ("bundle:group" of a figure group) in one multi-page pdf
+  // accompanied by a .toc file containing the page numbers of the individual plots
   void CreatePlots(const string& figureGroup = "", const string& figureCategory = "",
                    vector<string> plotNames = {}, const string& outputMode = "pdf");
   void CreatePlot(const string& name, const string& figureGroup, const string& figureCategory = "",
                   const string& outputMode = "pdf");
+
+  // for long-lived managers: re-create only the plots affected by modifications of their definitions
+  // or input files since they were last created (arguments as for ExtractPlotsFromFile)
+  bool UpdatePlots(const string& plotFileName, const string& outputMode = "pdf", const string& plotName = ".*",
+                   const string& group = ".*", const string& category = ".*");
   void PrintLoadedPlots() const;
 
+  // measure the time spent in the individual phases of reading the input data and creating the plots
+  void SetProfiling(bool enable = true);
+  void PrintProfilingSummary() const;                     // table with timings per phase, plot and input file
+  bool WriteProfilingTrace(const string& fileName) const; // Chrome trace-event json file
+
 private:
+  friend class BenchmarkAccess;
+
   TObject* FindSubDirectory(TObject* folder, vector<string>& subDirs) const;
+  void InitializeGUI();
+  unique_ptr<TCanvas> PaintPlot(const Plot& plot);
+  void CreateSelectedPlots(vector<Plot*>& selectedPlots, const string& outputMode);
+  vector<data_key_t> GetRequiredData(const Plot& plot) const;
   bool GeneratePlot(const Plot& plot, const string& outputMode = "pdf");
+  void ViewPlots(const vector<Plot*>& plots);
+  void SavePlot(TCanvas* canvas, const Plot& plot, const string& outputFormat);
+  void SaveToBundle(TCanvas* canvas, const Plot& plot, bool perFigureGroup);
+  void CloseBundle();
+  static bool IsValidOutputMode(const string& outputMode);
   ptree& ReadPlotTemplatesFromFile(const string& plotFileName);
-  void SavePlotsToFile() const;
+  bool SaveToOutputFile(TCanvas* canvas, const Plot& plot);
+  void CloseOutputFile();
 
   std::unique_ptr<TApplication> mApp;
-  bool mSaveToRootFile{};
   string mOutputFileName;
-  map<string, shared_ptr<TCanvas>> mPlotLedger;
+  std::unique_ptr<TFile> mOutputFile;
+  string mCreatedOutputFile; // output file created by this manager, which is updated when opened again
+  optional<int32_t> mOutputFileCompression;
+  uint32_t mNumPlotsInOutputFile{};
   string mOutputDirectory;
   bool mUseUniquePlotNames{};
   vector<Plot> mPlots;
   vector<Plot> mPlotTemplates;
   map<string, ptree> mPropertyTreeCache;
-  vector<const string*> mPlotViewHistory;
+  map<string, std::filesystem::file_time_type> mPropertyTreeTimestamps;
+  map<string, set<string>> mPlotsFromFile;     // plot definition file, unique names of the plots read from it
+  map<string, set<string>> mTemplatesFromFile; // plot definition file, names of the templates read from it
+  std::unique_ptr<OutputWriter> mOutputWriter;
+  std::unique_ptr<FilePool> mFilePool;
+  std::unique_ptr<ContainerCache> mContainerCache;
+  string mBundleName;
+  string mBundleStagingName;
+  vector<string> mBundleContent;
+  uint32_t mViewerCacheWindow{3};
   int32_t mWindowOffsetY{};
 
-  unordered_map<string, unordered_map<string, std::unique_ptr<TObject>>> mDataBuffer;
+  unordered_map<data_key_t, std::unique_ptr<TObject>> mDataBuffer; // (inputID, name) of interned strings, data
   map<string, vector<string>> mInputFiles; // inputFileIdentifier, inputFilePaths
+  map<string, std::filesystem::file_time_type> mInputFileTimestamps;
+  map<string, vector<data_key_t>> mInputFileContent; // inputFilePath, data read from it
+  set<string> mMergedInputs; // inputIDs whose files are merged
+  string mTreeCacheFileName;
+  uint32_t mEventLoopThreads{};
+
+  struct io_stats_t {
+    uint64_t bytesRead{};         // as reported by TFile
+    uint64_t readCalls{};         // as reported by TFile
+    uint32_t seeks{};             // objects that were not read directly after the previous one
+    uint32_t keysTouched{};       // keys whose objects were read
+    uint32_t keysListed{};        // keys in the directories that were searched
+    uint64_t compressedBytes{};   // size on disk of the objects read
+    uint64_t uncompressedBytes{}; // size in memory of the objects read
+    double_t readTime{};          // time in ms spent reading, decompressing and streaming the objects
+    int64_t nextOffset{-1};       // file offset directly after the previously read object
+    struct container_read_t {
+      string name;
+      string className;
+      uint64_t uncompressedBytes;
+      double_t readTime;
+      uint32_t nEntries;
+      uint32_t nUsed;
+    };
+    vector<container_read_t> containerReads; // lists etc. that had to be read completely to find the data
+  };
+  bool mReportIOStatistics{};
+  int64_t mReadPrefetchSize{32 * 1024 * 1024}; // bytes
+  uint32_t mDecompressionThreads{};
+  map<std::pair<string, string>, io_stats_t> mIOStatistics; // (inputID, inputFilePath), statistics
+  void PrintIOStatistics();
+  map<TKey*, unique_ptr<TObject>> PrefetchKeys(TDirectory* directory, TCollection* keys, const vector<string>& dataNames, io_stats_t& ioStats, const string& fileName,
+                                               uint32_t nDecompressionThreads);
   void PrintBufferStatus(bool missingOnly = false) const;
   bool FillBuffer();
-  void ReadData(TObject* folder, vector<string>& dataNames, const string& prefix, const string& suffix, const string& inputID);
-  void ReadDataCSV(const string& inputFileName, const string& graphName, const string& inputIdentifier);
+  void RegisterInputFile(const string& fileName);
+  void ReadData(TObject* folder, vector<string>& dataNames, const string& prefix, const string& suffix, const string& inputID, const string& fileName,
+                map<string, unique_ptr<TObject>>* readData = nullptr, bool fromCache = false);
+  bool MergeInputData(const string& inputID, unordered_map<string, vector<string>>& requiredData);
+  vector<string> ReadDataCSV(const string& inputFileName, const string& inputIdentifier, const vector<string>& requiredNames);
+  vector<string> ReadDataExternal(const string& fileName, const string& inputIdentifier, const vector<string>& requiredNames);
 };
 
 } // end namespace PlottingFramework
@@ -104,9 +104,11 @@ const map<drawing_options_t, string> defaultDrawingOptions_Graph{
 class PlotPainter
 {
 public:
-  unique_ptr<TCanvas> GeneratePlot(Plot& plot, const unordered_map<string, unordered_map<string, std::unique_ptr<TObject>>>& dataBuffer);
+  unique_ptr<TCanvas> GeneratePlot(Plot& plot, const unordered_map<data_key_t, std::unique_ptr<TObject>>& dataBuffer);
 
 private:
+  friend class BenchmarkAccess;
+
   optional<data_ptr_t> GetDataClone(TObject* obj, const std::optional<Plot::Pad::Data::proj_info_t>& projInfo = std::nullopt);
   template <typename T>
   optional<data_ptr_t> GetDataClone(TObject* obj);
@@ -125,7 +127,7 @@ private:
   void DivideGraphHistInterpolated(TGraph* numerator, TH1* denominator);
   std::tuple<uint32_t, uint32_t> GetTextDimensions(TLatex& text, TPad* pad);
   void ReplacePlaceholders(string& str, TNamed* data_ptr);
-  TPave* GenerateBox(variant<shared_ptr<Plot::Pad::LegendBox>, shared_ptr<Plot::Pad::TextBox>> box, TPad* pad);
+  TPave* GenerateBox(variant<const Plot::Pad::LegendBox*, const Plot::Pad::TextBox*> box, TPad* pad);
   float_t GetTextSizePixel(float_t textSizeNDC);
 
   template <typename T>
@@ -0,0 +1,60 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PlotServer_h
+#define PlotServer_h
+
+#include "PlottingFramework.h"
+
+#include <functional>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Minimal server listening on a local unix socket. Each request consists of a list of arguments
+ * that is passed to a user defined handler, which reports back whether the request was successful.
+ */
+//**************************************************************************************************
+class PlotServer
+{
+public:
+  PlotServer(const string& socketPath = GetDefaultSocketPath());
+  ~PlotServer();
+  PlotServer(const PlotServer& other) = delete;
+  PlotServer(PlotServer&&) = delete;
+  PlotServer& operator=(const PlotServer& other) = delete;
+  PlotServer& operator=(PlotServer&& other) = delete;
+
+  bool Listen();
+  void Run(const std::function<bool(const vector<string>&)>& requestHandler);
+
+  static optional<bool> SendRequest(const vector<string>& arguments, const string& socketPath = GetDefaultSocketPath());
+  static bool Shutdown(const string& socketPath = GetDefaultSocketPath());
+  static string GetDefaultSocketPath();
+
+private:
+  static optional<string> Exchange(const string& message, const string& socketPath);
+  static bool WriteMessage(int32_t socket, const string& message);
+  static optional<string> ReadMessage(int32_t socket);
+
+  string mSocketPath;
+  int32_t mSocket{-1};
+};
+
+} // end namespace PlottingFramework
+#endif /* PlotServer_h */
@@ -22,6 +22,7 @@
 #include <map>
 #include <set>
 #include <variant>
+#include <optional>
 #include <cmath>
 #include <cstdint>
 #include <boost/property_tree/ptree.hpp>
@@ -0,0 +1,131 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef Profiler_h
+#define Profiler_h
+
+#include "PlottingFramework.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Collects the time spent in the individual phases of reading input data and creating plots.
+ * Timings are recorded per plot and per input file and can be summarized or exported as
+ * Chrome trace-event file (to be viewed e.g. in chrome://tracing or https://ui.perfetto.dev).
+ * When profiling is disabled the timers reduce to a single check of a flag.
+ */
+//**************************************************************************************************
+class Profiler
+{
+public:
+  enum phase_t : uint8_t {
+    file_open,
+    key_lookup,
+    object_read,
+    event_loop,
+    clone,
+    projection,
+    ratio,
+    scaling,
+    box_layout,
+    painting,
+    save_as,
+    n_phases,
+  };
+
+  static Profiler& Instance();
+  static bool IsEnabled() { return sEnabled; }
+  static void SetEnabled(bool enabled = true) { sEnabled = enabled; }
+  static const char* GetPhaseName(phase_t phase);
+
+  // the plot that is currently processed is used as context for all timers that do not specify one
+  void SetCurrentPlot(const string& plotName) { mCurrentPlot = plotName; }
+  const string& GetCurrentPlot() const { return mCurrentPlot; }
+
+  void AddRecord(phase_t phase, string context, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+  void PrintSummary(uint32_t nEntries = 10) const;
+  bool WriteTrace(const string& fileName) const;
+  void Reset();
+
+private:
+  Profiler();
+
+  struct record_t {
+    phase_t phase;
+    string context;
+    int64_t start;    // in us since creation of the profiler
+    int64_t duration; // in us
+    uint32_t threadID;
+  };
+
+  inline static bool sEnabled{};
+  std::chrono::steady_clock::time_point mStartTime;
+  string mCurrentPlot;
+  mutable std::mutex mMutex;
+  vector<record_t> mRecords;
+};
+
+//**************************************************************************************************
+/**
+ * Records the time between its construction and destruction (or Stop()) as the specified phase.
+ */
+//**************************************************************************************************
+class ScopedTimer
+{
+public:
+  ScopedTimer(Profiler::phase_t phase) : mPhase{phase}
+  {
+    if (Profiler::IsEnabled()) Start(Profiler::Instance().GetCurrentPlot());
+  }
+  ScopedTimer(Profiler::phase_t phase, const string& context) : mPhase{phase}
+  {
+    if (Profiler::IsEnabled()) Start(context);
+  }
+  ~ScopedTimer() { Stop(); }
+  ScopedTimer(const ScopedTimer& other) = delete;
+  ScopedTimer(ScopedTimer&&) = delete;
+  ScopedTimer& operator=(const ScopedTimer& other) = delete;
+  ScopedTimer& operator=(ScopedTimer&& other) = delete;
+
+  void Stop()
+  {
+    if (!mIsRunning) return;
+    mIsRunning = false;
+    Profiler::Instance().AddRecord(mPhase, std::move(mContext), mStart, std::chrono::steady_clock::now());
+  }
+
+private:
+  void Start(const string& context)
+  {
+    mContext = context;
+    mIsRunning = true;
+    mStart = std::chrono::steady_clock::now();
+  }
+
+  Profiler::phase_t mPhase;
+  bool mIsRunning{};
+  string mContext;
+  std::chrono::steady_clock::time_point mStart;
+};
+
+} // end namespace PlottingFramework
+#endif /* Profiler_h */
@@ -0,0 +1,118 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef PropertyTable_h
+#define PropertyTable_h
+
+#include "PlottingFramework.h"
+#include "Helpers.h"
+
+#include <tuple>
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * How a property is treated by the generic operations on the property tables.
+ */
+//**************************************************************************************************
+enum class property_kind : uint8_t {
+  regular, // serialized and applied on top of another object if set
+  layout,  // same as regular, in addition part of the appearance of data (see Data::SetLayout)
+  manual,  // serialized, but the class merges it by hand (e.g. mutually exclusive properties)
+};
+
+//**************************************************************************************************
+/**
+ * Entry of a property table: label in the property tree and the chain of member pointers
+ * leading from the object to the optional value (e.g. &Pad::mMargins, &pad_margin_t::top).
+ */
+//**************************************************************************************************
+template <property_kind Kind, typename... MemberPtrs>
+struct property_t {
+  static constexpr property_kind kind = Kind;
+  const char* label;
+  tuple<MemberPtrs...> path;
+
+  template <typename Object>
+  constexpr auto& Get(Object& object) const
+  {
+    return std::apply([&object](auto... ptrs) -> auto& { return (object .* ... .* ptrs); }, path);
+  }
+};
+
+template <property_kind Kind = property_kind::regular, typename... MemberPtrs>
+constexpr property_t<Kind, MemberPtrs...> property(const char* label, MemberPtrs... path)
+{
+  return {label, {path...}};
+}
+
+template <typename... Properties>
+constexpr tuple<Properties...> property_table(Properties... properties)
+{
+  return {properties...};
+}
+
+//**************************************************************************************************
+/**
+ * Generic operations on all properties of a table.
+ */
+//**************************************************************************************************
+template <typename Object, typename Table>
+void write_properties(ptree& tree, const Object& object, const Table& table)
+{
+  std::apply([&](const auto&... prop) { (put_in_tree(tree, prop.Get(object), prop.label), ...); }, table);
+}
+
+template <typename Object, typename Table>
+void read_properties(const ptree& tree, Object& object, const Table& table)
+{
+  std::apply([&](const auto&... prop) { (read_from_tree(tree, prop.Get(object), prop.label), ...); }, table);
+}
+
+// apply all properties that are set in origin on top of target (skips the manually merged ones)
+template <typename Object, typename Table>
+void merge_properties(const Object& origin, Object& target, const Table& table)
+{
+  auto merge = [&](const auto& prop) {
+    if constexpr (std::decay_t<decltype(prop)>::kind != property_kind::manual) {
+      set_if(prop.Get(origin), prop.Get(target));
+    }
+  };
+  std::apply([&](const auto&... prop) { (merge(prop), ...); }, table);
+}
+
+// copy (set_all = true) or merge all properties of a certain kind from origin to target
+template <property_kind Kind, typename Object, typename Table>
+void transfer_properties(const Object& origin, Object& target, const Table& table, bool set_all)
+{
+  auto transfer = [&](const auto& prop) {
+    if constexpr (std::decay_t<decltype(prop)>::kind == Kind) {
+      if (set_all) {
+        prop.Get(target) = prop.Get(origin);
+      } else {
+        set_if(prop.Get(origin), prop.Get(target));
+      }
+    }
+  };
+  std::apply([&](const auto&... prop) { (transfer(prop), ...); }, table);
+}
+
+} // end namespace PlottingFramework
+#endif /* PropertyTable_h */
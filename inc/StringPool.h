@@ -0,0 +1,90 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef StringPool_h
+#define StringPool_h
+
+#include "PlottingFramework.h"
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Interning table for the identifiers used throughout the framework (plot names, figure groups,
+ * input identifiers and data names). Each distinct string is stored only once and referred to by
+ * a compact ID. The strings are kept in fixed-size chunks, such that they never move and can be
+ * accessed by ID without locking.
+ */
+//**************************************************************************************************
+class StringPool
+{
+public:
+  using id_t = uint32_t;
+
+  static id_t Intern(std::string_view str);
+  static const string& Get(id_t id) { return Instance().mChunks[id / kChunkSize].load(std::memory_order_acquire)[id % kChunkSize]; }
+  static size_t GetSize() { return Instance().mSize.load(std::memory_order_acquire); }
+
+private:
+  StringPool();
+  static StringPool& Instance();
+
+  static constexpr id_t kChunkSize{4096};
+  static constexpr id_t kMaxChunks{4096};
+
+  array<std::atomic<string*>, kMaxChunks> mChunks{};
+  std::atomic<id_t> mSize{};
+  std::mutex mMutex;
+  unordered_map<std::string_view, id_t> mIDs;
+};
+
+//**************************************************************************************************
+/**
+ * Interned string that behaves like a (const) std::string but only stores the ID.
+ * ID 0 always refers to the empty string.
+ */
+//**************************************************************************************************
+struct interned_string_t {
+  interned_string_t() = default;
+  interned_string_t(const string& str) : id{StringPool::Intern(str)} {}
+  interned_string_t(const char* str) : id{StringPool::Intern(str)} {}
+
+  const string& str() const { return StringPool::Get(id); }
+  operator const string&() const { return str(); }
+  bool empty() const { return id == 0; }
+  bool operator==(const interned_string_t& other) const { return id == other.id; }
+  bool operator!=(const interned_string_t& other) const { return id != other.id; }
+
+  StringPool::id_t id{};
+};
+
+// data in the buffer is identified by the combination of input identifier and name
+using data_key_t = uint64_t;
+inline data_key_t MakeDataKey(const interned_string_t& inputID, const interned_string_t& name)
+{
+  return (static_cast<data_key_t>(inputID.id) << 32) | name.id;
+}
+inline const string& GetInputID(data_key_t key) { return StringPool::Get(static_cast<StringPool::id_t>(key >> 32)); }
+inline const string& GetDataName(data_key_t key) { return StringPool::Get(static_cast<StringPool::id_t>(key & 0xffffffff)); }
+
+} // end namespace PlottingFramework
+#endif /* StringPool_h */
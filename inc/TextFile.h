@@ -0,0 +1,108 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TextFile_h
+#define TextFile_h
+
+#include "PlottingFramework.h"
+
+#include <string_view>
+#include <charconv>
+#include <cstdlib>
+#include <cerrno>
+#include <cctype>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Read-only view of the content of a (text or numpy) input file. Plain files are memory-mapped, gzip
+ * compressed files (.gz) are inflated in memory.
+ */
+//**************************************************************************************************
+class TextFile
+{
+public:
+  TextFile() = default;
+  ~TextFile();
+  TextFile(const TextFile& other) = delete;
+  TextFile(TextFile&&) = delete;
+  TextFile& operator=(const TextFile& other) = delete;
+  TextFile& operator=(TextFile&& other) = delete;
+
+  bool Open(const string& fileName);
+  void Close();
+  std::string_view GetContent() const { return mContent; }
+
+private:
+  std::string_view mContent;
+  string mInflatedContent;
+  void* mMappedContent{nullptr};
+  size_t mMappedSize{};
+};
+
+// get next line (without line break) starting at position and move position to the beginning of the following line
+inline bool next_line(std::string_view content, size_t& position, std::string_view& line)
+{
+  if (position >= content.size()) return false;
+  size_t lineEnd = content.find('\n', position);
+  if (lineEnd == std::string_view::npos) lineEnd = content.size();
+  line = content.substr(position, lineEnd - position);
+  if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+  position = lineEnd + 1;
+  return true;
+}
+
+inline std::string_view trim_blanks(std::string_view str)
+{
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) str.remove_prefix(1);
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\t')) str.remove_suffix(1);
+  return str;
+}
+
+// parse a complete field (without leading '+') as floating point number via strtod (fallback in case floating point std::from_chars is not available)
+inline bool parse_number_strtod(std::string_view field, double_t& value)
+{
+  // strtod additionally accepts leading blanks, signs and hexadecimal numbers, which are rejected here for consistency with std::from_chars
+  if (field.empty() || field.front() == '+' || std::isspace(static_cast<unsigned char>(field.front()))) return false;
+  if (field.find_first_of("xX") != std::string_view::npos) return false;
+  string buffer(field);
+  char* end{};
+  errno = 0;
+  value = std::strtod(buffer.data(), &end);
+  return errno != ERANGE && end == buffer.data() + buffer.size();
+}
+
+// parse a complete field as floating point number (a leading '+' is accepted)
+inline bool parse_number(std::string_view field, double_t& value)
+{
+  if (!field.empty() && field.front() == '+') {
+    field.remove_prefix(1);
+    if (!field.empty() && field.front() == '-') return false;
+  }
+#if defined(__cpp_lib_to_chars)
+  if (field.empty()) return false;
+  auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  return error == std::errc() && end == field.data() + field.size();
+#else
+  // floating point std::from_chars is not available (gcc < 11, libc++)
+  return parse_number_strtod(field, value);
+#endif
+}
+
+} // end namespace PlottingFramework
+#endif /* TextFile_h */
@@ -0,0 +1,84 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TreeFiller_h
+#define TreeFiller_h
+
+#include "PlottingFramework.h"
+
+class TObject;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Histogram that is filled from a tree of the input files. It is requested via the data name
+ *   "<tree>::<expression>>>(<binning>)[|<selection>]"
+ * following the syntax of TTree::Draw, e.g. "Events::pt>>(100,0,10)|abs(eta) < 0.8" or
+ * "Events::eta:pt>>(100,0,10,[-0.8,-0.4,0,0.4,0.8])" for 2d histograms ("y:x"). The binning of each
+ * axis is given as number of bins, minimum and maximum or as list of bin edges in brackets.
+ */
+//**************************************************************************************************
+struct tree_request_t {
+  struct axis_t {
+    int32_t nBins{};
+    double_t min{};
+    double_t max{};
+    vector<double_t> edges; // variable binning
+  };
+  string tree;
+  vector<string> expressions; // x[, y]
+  vector<axis_t> axes;
+  string selection;
+
+  static bool IsTreeRequest(const string& name) { return name.find("::") != string::npos && name.find(">>(") != string::npos; }
+  static optional<tree_request_t> FromName(const string& name);
+};
+
+//**************************************************************************************************
+/**
+ * Fills the requested histograms from the trees in the input files. All requests for the same tree
+ * are booked lazily in one RDataFrame and filled in a single (implicitly multi-threaded) event loop.
+ * Results can be cached in a root file, where they are identified by a hash of the request and
+ * the names, sizes and modification times of the input files.
+ */
+//**************************************************************************************************
+class TreeFiller
+{
+public:
+  TreeFiller(const string& cacheFileName = "", uint32_t nThreads = 0);
+  ~TreeFiller() = default;
+  TreeFiller(const TreeFiller& other) = delete;
+  TreeFiller(TreeFiller&&) = delete;
+  TreeFiller& operator=(const TreeFiller& other) = delete;
+  TreeFiller& operator=(TreeFiller&& other) = delete;
+
+  // input files may be followed by ':' and the directory that contains the tree
+  bool Fill(const vector<string>& inputFileNames, const vector<string>& requestNames, const string& context = "");
+  map<string, unique_ptr<TObject>>& GetObjects() { return mObjects; } // request name, histogram
+
+private:
+  string GetCacheKey(const string& requestName, const vector<string>& inputFileNames) const;
+  bool FillTree(const string& tree, const vector<std::pair<string, tree_request_t>>& requests, const vector<string>& inputFileNames, const string& context);
+
+  string mCacheFileName;
+  uint32_t mNumThreads{}; // 0: all cores
+  map<string, unique_ptr<TObject>> mObjects;
+};
+
+} // end namespace PlottingFramework
+#endif /* TreeFiller_h */
@@ -0,0 +1,59 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YODAReader_h
+#define YODAReader_h
+
+#include "PlottingFramework.h"
+
+#include <string_view>
+
+class TObject;
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Reader for the text format of the YODA data analysis library (.yoda or .yoda.gz), e.g. reference
+ * data shipped with Rivet. Objects are named after their path in the file (without leading '/').
+ * Histo1D objects become TH1D, Scatter2D and Estimate1D objects become TGraphAsymmErrors.
+ * The file is processed in a single pass and only the requested objects are parsed.
+ */
+//**************************************************************************************************
+class YODAReader
+{
+public:
+  YODAReader() = default;
+  ~YODAReader() = default;
+  YODAReader(const YODAReader& other) = delete;
+  YODAReader(YODAReader&&) = delete;
+  YODAReader& operator=(const YODAReader& other) = delete;
+  YODAReader& operator=(YODAReader&& other) = delete;
+
+  bool Read(const string& fileName, const vector<string>& requiredNames);
+  map<string, unique_ptr<TObject>>& GetObjects() { return mObjects; } // name, object
+
+  static bool IsYODAFile(const string& fileName);
+
+private:
+  unique_ptr<TObject> ParseObject(const string& name, std::string_view type, uint8_t version, std::string_view body, const string& fileName);
+
+  map<string, unique_ptr<TObject>> mObjects;
+};
+
+} // end namespace PlottingFramework
+#endif /* YODAReader_h */
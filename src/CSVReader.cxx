@@ -0,0 +1,318 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "CSVReader.h"
+#include "TextFile.h"
+#include "Helpers.h"
+#include "Logging.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Create schema from comma separated list of options (see csv_schema_t).
+ */
+//**************************************************************************************************
+optional<csv_schema_t> csv_schema_t::FromString(const string& options)
+{
+  csv_schema_t schema;
+  if (options.empty()) return schema;
+
+  for (auto& option : split_string(options, ',')) {
+    auto keyValue = split_string(option, '=', true);
+    const string& key = keyValue[0];
+    if (key.empty()) continue;
+    if (key == "header") {
+      schema.header = true;
+      continue;
+    }
+    if (keyValue.size() != 2 || keyValue[1].empty()) {
+      ERROR("Invalid csv option '{}'.", option);
+      return std::nullopt;
+    }
+    const string& value = keyValue[1];
+    if (key == "delimiter") {
+      if (value == "tab") {
+        schema.delimiter = '\t';
+      } else if (value == "comma") {
+        schema.delimiter = ',';
+      } else if (value == "semicolon") {
+        schema.delimiter = ';';
+      } else if (value == "space") {
+        schema.delimiter = ' ';
+      } else if (value.size() == 1) {
+        schema.delimiter = value[0];
+      } else {
+        ERROR("Invalid csv delimiter '{}'.", value);
+        return std::nullopt;
+      }
+    } else if (key == "comment") {
+      schema.comment = value[0];
+    } else if (key == "x") {
+      schema.x = value;
+    } else if (key == "y") {
+      schema.y = split_string(value, '|');
+    } else if (key == "ex") {
+      schema.ex = split_string(value, '|');
+    } else if (key == "ey") {
+      schema.ey = split_string(value, '|');
+    } else if (key == "exl") {
+      schema.exl = split_string(value, '|');
+    } else if (key == "exh") {
+      schema.exh = split_string(value, '|');
+    } else if (key == "eyl") {
+      schema.eyl = split_string(value, '|');
+    } else if (key == "eyh") {
+      schema.eyh = split_string(value, '|');
+    } else {
+      ERROR("Unknown csv option '{}'.", key);
+      return std::nullopt;
+    }
+  }
+
+  for (auto errors : {&schema.ex, &schema.ey, &schema.exl, &schema.exh, &schema.eyl, &schema.eyh}) {
+    if (!errors->empty() && errors->size() != std::max<size_t>(schema.y.size(), 1u)) {
+      ERROR("Number of error columns does not match number of y columns in csv options '{}'.", options);
+      return std::nullopt;
+    }
+  }
+  if (schema.y.empty() && !(schema.ex.empty() && schema.ey.empty() && !schema.HasAsymmErrors())) {
+    ERROR("Error columns were specified without y column in csv options '{}'.", options);
+    return std::nullopt;
+  }
+  if ((!schema.ex.empty() || !schema.ey.empty()) && schema.HasAsymmErrors()) {
+    ERROR("Symmetric and asymmetric errors cannot be combined in csv options '{}'.", options);
+    return std::nullopt;
+  }
+  return schema;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor.
+ */
+//**************************************************************************************************
+CSVReader::CSVReader(const csv_schema_t& schema) : mSchema{schema}
+{
+}
+
+//**************************************************************************************************
+/**
+ * Check if file (optionally followed by ':' and csv options) is a csv or tsv file.
+ */
+//**************************************************************************************************
+bool CSVReader::IsCSVFile(const string& fileName)
+{
+  string name = split_string(fileName, ':', true)[0];
+  auto endsWith = [&name](const string& suffix) { return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0; };
+  if (endsWith(".gz")) name.resize(name.size() - 3);
+  return endsWith(".csv") || endsWith(".tsv");
+}
+
+//**************************************************************************************************
+/**
+ * Read the selected columns from the file.
+ */
+//**************************************************************************************************
+bool CSVReader::Read(const string& fileName)
+{
+  mColumns.clear();
+  mColumnNames.clear();
+  mNumRows = 0;
+
+  TextFile file;
+  return file.Open(fileName) && Parse(file.GetContent(), fileName);
+}
+
+//**************************************************************************************************
+/**
+ * Determine the indices of the selected columns.
+ */
+//**************************************************************************************************
+bool CSVReader::ResolveColumns(const vector<string>& columnNames, const string& fileName)
+{
+  mColumnNames = columnNames;
+  if (mSchema.IsDefault()) {
+    // classic format: x y ex ey, errors are only used if the file contains them
+    mSchema.y = {"1"};
+    if (mColumnNames.empty() || mColumnNames.size() > 2) mSchema.ex = {"2"};
+    if (mColumnNames.empty() || mColumnNames.size() > 3) mSchema.ey = {"3"};
+  }
+  for (auto columns : {&mSchema.y, &mSchema.ex, &mSchema.ey, &mSchema.exl, &mSchema.exh, &mSchema.eyl, &mSchema.eyh}) {
+    for (auto& column : *columns) {
+      auto index = GetColumnIndex(column);
+      if (!index) {
+        ERROR("Column '{}' not found in {}.", column, fileName);
+        return false;
+      }
+      mColumns[*index];
+    }
+  }
+  auto xIndex = GetColumnIndex(mSchema.x);
+  if (!xIndex) {
+    ERROR("Column '{}' not found in {}.", mSchema.x, fileName);
+    return false;
+  }
+  mColumns[*xIndex];
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Get index of column specified by its index or name.
+ */
+//**************************************************************************************************
+optional<size_t> CSVReader::GetColumnIndex(const string& column) const
+{
+  if (!column.empty() && std::all_of(column.begin(), column.end(), ::isdigit)) {
+    size_t index = std::stoul(column);
+    if (!mColumnNames.empty() && index >= mColumnNames.size()) return std::nullopt;
+    return index;
+  }
+  auto iterator = std::find(mColumnNames.begin(), mColumnNames.end(), column);
+  if (iterator == mColumnNames.end()) return std::nullopt;
+  return iterator - mColumnNames.begin();
+}
+
+//**************************************************************************************************
+/**
+ * Get values of a column that was selected in the schema.
+ */
+//**************************************************************************************************
+const vector<double_t>* CSVReader::GetColumn(const string& column) const
+{
+  auto index = GetColumnIndex(column);
+  if (!index) return nullptr;
+  auto iterator = mColumns.find(*index);
+  return (iterator != mColumns.end()) ? &iterator->second : nullptr;
+}
+
+//**************************************************************************************************
+/**
+ * Parse the file content line by line, splitting only as many fields as needed.
+ */
+//**************************************************************************************************
+bool CSVReader::Parse(std::string_view content, const string& fileName)
+{
+  auto isBlank = [](char c) { return c == ' ' || c == '\t'; };
+
+  vector<vector<double_t>*> slots; // pointers to the column storage, indexed by column (nullptr for columns that are skipped)
+  size_t nRequiredFields{};        // rows with less fields are invalid
+  size_t nInvalidRows{};
+  bool isFirstLine = true;
+  bool isClassicFormat = mSchema.IsDefault();
+  char delimiter{};
+
+  // returns the next field and moves the cursor behind it (line is empty after the last field)
+  auto nextField = [&](std::string_view& line, bool& hasMore) {
+    if (delimiter == ' ') {
+      size_t end = 0;
+      while (end < line.size() && !isBlank(line[end])) ++end;
+      std::string_view field = line.substr(0, end);
+      while (end < line.size() && isBlank(line[end])) ++end;
+      line.remove_prefix(end);
+      hasMore = !line.empty();
+      return field;
+    }
+    size_t end = line.find(delimiter);
+    std::string_view field = line.substr(0, end);
+    hasMore = (end != std::string_view::npos);
+    line.remove_prefix(hasMore ? end + 1 : line.size());
+    return trim_blanks(field);
+  };
+
+  size_t position{};
+  std::string_view line;
+  while (next_line(content, position, line)) {
+    std::string_view trimmedLine = trim_blanks(line);
+    if (trimmedLine.empty() || trimmedLine.front() == mSchema.comment) continue;
+
+    if (isFirstLine) {
+      isFirstLine = false;
+      if (mSchema.delimiter) {
+        delimiter = *mSchema.delimiter;
+      } else {
+        delimiter = ' ';
+        for (char candidate : {'\t', ',', ';'}) {
+          if (trimmedLine.find(candidate) != std::string_view::npos) {
+            delimiter = candidate;
+            break;
+          }
+        }
+      }
+      vector<string> columnNames;
+      if (mSchema.header) {
+        std::string_view remaining = trimmedLine;
+        bool hasMore = true;
+        while (hasMore) columnNames.emplace_back(nextField(remaining, hasMore));
+      }
+      if (!ResolveColumns(columnNames, fileName)) return false;
+
+      size_t maxIndex = mColumns.rbegin()->first;
+      slots.assign(maxIndex + 1, nullptr);
+      size_t expectedRows = content.size() / (line.size() + 1) + 1;
+      for (auto& [index, values] : mColumns) {
+        slots[index] = &values;
+        values.reserve(expectedRows);
+      }
+      // in the classic format the error columns are optional
+      nRequiredFields = (isClassicFormat) ? 2u : maxIndex + 1;
+      if (mSchema.header) continue;
+    }
+
+    std::string_view remaining = trimmedLine;
+    size_t nFields{};
+    bool isValid = true;
+    bool hasMore = true;
+    while (hasMore && nFields < slots.size()) {
+      std::string_view field = nextField(remaining, hasMore);
+      if (auto values = slots[nFields]) {
+        double_t value{};
+        if (!parse_number(field, value)) {
+          isValid = false;
+          break;
+        }
+        values->push_back(value);
+      }
+      ++nFields;
+    }
+    if (isValid && nFields < nRequiredFields) isValid = false;
+    if (isValid) {
+      // optional columns of classic format that are missing in this row
+      for (size_t index = nFields; index < slots.size(); ++index) {
+        if (slots[index]) slots[index]->push_back(0.);
+      }
+      ++mNumRows;
+    } else {
+      ++nInvalidRows;
+      for (auto& [index, values] : mColumns) values.resize(mNumRows);
+    }
+  }
+
+  if (isFirstLine) {
+    ERROR("No data found in {}.", fileName);
+    return false;
+  }
+  if (nInvalidRows) {
+    WARNING("Skipped {} line{} in {} that could not be parsed.", nInvalidRows, (nInvalidRows == 1) ? "" : "s", fileName);
+  }
+  return true;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,225 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ChunkedSparse.h"
+#include "Profiler.h"
+#include "Logging.h"
+#include "Helpers.h"
+
+// root dependencies
+#include "TFile.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "THnSparse.h"
+#include "TClass.h"
+#include "TList.h"
+
+namespace PlottingFramework
+{
+
+// title of the placeholder objects: "<tag><directory>" as written, "<tag><file>:<directory>" once read
+static const string gPlaceholderTag = "ChunkedSparse:";
+
+//**************************************************************************************************
+/**
+ * Creates an empty sparse histogram with the axes of the specified one.
+ */
+//**************************************************************************************************
+static unique_ptr<THnSparse> create_empty_sparse(const THnBase* source, const string& name)
+{
+  int32_t nDims = source->GetNdimensions();
+  vector<int32_t> nBins;
+  vector<double_t> xMin, xMax;
+  for (int32_t i = 0; i < nDims; ++i) {
+    nBins.push_back(source->GetAxis(i)->GetNbins());
+    xMin.push_back(source->GetAxis(i)->GetXmin());
+    xMax.push_back(source->GetAxis(i)->GetXmax());
+  }
+  unique_ptr<THnSparse> sparse(new THnSparseD(name.data(), source->GetTitle(), nDims, nBins.data(), xMin.data(), xMax.data()));
+  for (int32_t i = 0; i < nDims; ++i) {
+    const TAxis* sourceAxis = source->GetAxis(i);
+    TAxis* axis = sparse->GetAxis(i);
+    if (sourceAxis->GetXbins()->GetSize() > 0) axis->Set(sourceAxis->GetNbins(), sourceAxis->GetXbins()->GetArray());
+    axis->SetName(sourceAxis->GetName());
+    axis->SetTitle(sourceAxis->GetTitle());
+  }
+  if (source->GetCalculateErrors()) sparse->Sumw2();
+  return sparse;
+}
+
+//**************************************************************************************************
+/**
+ * Checks if the axes of the sparse histograms have the same number of bins and the same bin edges.
+ */
+//**************************************************************************************************
+static bool has_same_binning(const THnBase* sparse, const THnBase* otherSparse)
+{
+  if (sparse->GetNdimensions() != otherSparse->GetNdimensions()) return false;
+  for (int32_t i = 0; i < sparse->GetNdimensions(); ++i) {
+    const TAxis* axis = sparse->GetAxis(i);
+    const TAxis* otherAxis = otherSparse->GetAxis(i);
+    if (axis->GetNbins() != otherAxis->GetNbins()) return false;
+    // compares range and (variable) bin edges at once
+    double_t tolerance = 1e-6 * (axis->GetXmax() - axis->GetXmin()) / axis->GetNbins();
+    for (int32_t bin = 1; bin <= axis->GetNbins() + 1; ++bin) {
+      if (std::abs(axis->GetBinLowEdge(bin) - otherAxis->GetBinLowEdge(bin)) > tolerance) return false;
+    }
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Writes the filled bins of the sparse histograms in chunks of the specified size to the output
+ * file. Only one input histogram is loaded at a time, so a histogram that is too large for the
+ * memory can be assembled from the partial outputs it is merged from.
+ */
+//**************************************************************************************************
+bool ChunkedSparse::Convert(const vector<string>& inputNames, const string& outputFileName, const string& name, uint64_t binsPerChunk)
+{
+  TFile outputFile(outputFileName.data(), "UPDATE");
+  if (outputFile.IsZombie()) {
+    ERROR("Cannot open output file {}.", outputFileName);
+    return false;
+  }
+  string directoryName = name + "_chunks";
+  if (outputFile.GetKey(directoryName.data()) || outputFile.GetKey(name.data())) {
+    ERROR("Output file {} already contains {}.", outputFileName, name);
+    return false;
+  }
+  TDirectory* chunkDirectory = outputFile.mkdir(directoryName.data());
+
+  uint32_t nChunks{};
+  uint64_t nFilledBins{};
+  double_t pendingEntries{}; // entries of the inputs are assigned to the next chunk written
+  unique_ptr<THnSparse> reference; // empty histogram with the axes of the first input, template for the chunks
+  unique_ptr<THnSparse> chunk;
+  auto writeChunk = [&]() {
+    chunk->SetEntries(pendingEntries);
+    pendingEntries = 0.;
+    chunkDirectory->WriteTObject(chunk.get(), fmt::format("chunk_{:06}", nChunks++).data());
+    chunk.reset();
+  };
+  vector<int32_t> coordinates;
+  for (auto& inputName : inputNames) {
+    auto fileNamePath = split_string(inputName, ':', true);
+    if (fileNamePath.size() < 2) {
+      ERROR("Input {} does not specify the path of the histogram (file.root:path/to/histogram).", inputName);
+      return false;
+    }
+    TFile inputFile(fileNamePath[0].data(), "READ");
+    if (inputFile.IsZombie()) {
+      ERROR("Cannot open input file {}.", fileNamePath[0]);
+      return false;
+    }
+    unique_ptr<THnBase> input(dynamic_cast<THnBase*>(inputFile.Get(fileNamePath[1].data())));
+    if (!input) {
+      ERROR("Sparse histogram {} not found in file {}.", fileNamePath[1], fileNamePath[0]);
+      return false;
+    }
+    if (!reference) {
+      reference = create_empty_sparse(input.get(), name);
+    } else if (!has_same_binning(reference.get(), input.get())) {
+      ERROR("Binning of sparse histogram {} does not match the one of the previous inputs.", inputName);
+      return false;
+    }
+    INFO("Converting {} ({} filled bins).", inputName, input->GetNbins());
+    pendingEntries += input->GetEntries();
+    coordinates.resize(input->GetNdimensions());
+    unique_ptr<ROOT::Internal::THnBaseBinIter> binIterator(input->CreateIter(false));
+    for (int64_t bin = binIterator->Next(coordinates.data()); bin >= 0; bin = binIterator->Next(coordinates.data())) {
+      if (!chunk) chunk = create_empty_sparse(reference.get(), name);
+      // bins of previous inputs might already be in the current chunk
+      int64_t chunkBin = chunk->GetBin(coordinates.data());
+      chunk->AddBinContent(chunkBin, input->GetBinContent(bin));
+      if (chunk->GetCalculateErrors()) chunk->AddBinError2(chunkBin, input->GetBinError2(bin));
+      ++nFilledBins;
+      if (static_cast<uint64_t>(chunk->GetNbins()) >= binsPerChunk) writeChunk();
+    }
+    // keep the entries in case all bins are already written
+    if (!chunk && pendingEntries > 0.) chunk = create_empty_sparse(reference.get(), name);
+  }
+  if (chunk) writeChunk();
+
+  TNamed placeholder(name.data(), (gPlaceholderTag + directoryName).data());
+  outputFile.WriteTObject(&placeholder);
+  INFO("Wrote {} filled bins in {} chunks to {}.", nFilledBins, nChunks, outputFileName);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Checks if the object is the placeholder of a chunked sparse histogram.
+ */
+//**************************************************************************************************
+bool ChunkedSparse::IsPlaceholder(const TObject* obj)
+{
+  return obj && obj->IsA() == TNamed::Class() && string(obj->GetTitle()).rfind(gPlaceholderTag, 0) == 0;
+}
+
+//**************************************************************************************************
+/**
+ * Adds the file the placeholder was read from to its title.
+ */
+//**************************************************************************************************
+void ChunkedSparse::SetFileName(TObject* placeholder, const string& fileName)
+{
+  if (!IsPlaceholder(placeholder)) return;
+  TNamed* named = static_cast<TNamed*>(placeholder);
+  string directoryName = string(named->GetTitle()).substr(gPlaceholderTag.size());
+  named->SetTitle((gPlaceholderTag + fileName + ":" + directoryName).data());
+}
+
+//**************************************************************************************************
+/**
+ * Reads the chunks one after the other and passes them to the processing function, which may
+ * return false to stop. The chunks are deleted after processing.
+ */
+//**************************************************************************************************
+bool ChunkedSparse::ForEachChunk(const TObject* placeholder, const std::function<bool(THnBase*)>& process)
+{
+  if (!IsPlaceholder(placeholder)) return false;
+  string location = string(placeholder->GetTitle()).substr(gPlaceholderTag.size());
+  auto separatorPos = location.rfind(':');
+  if (separatorPos == string::npos) {
+    ERROR("Location of the chunks of {} is unknown.", placeholder->GetName());
+    return false;
+  }
+  string fileName = location.substr(0, separatorPos);
+  string directoryName = location.substr(separatorPos + 1);
+
+  TFile file(fileName.data(), "READ");
+  TDirectory* directory = (file.IsZombie()) ? nullptr : file.GetDirectory(directoryName.data());
+  if (!directory) {
+    ERROR("Chunks of {} not found in file {}.", placeholder->GetName(), fileName);
+    return false;
+  }
+  for (TObject* obj : *directory->GetListOfKeys()) {
+    TKey* key = static_cast<TKey*>(obj);
+    ScopedTimer readTimer(Profiler::object_read, fileName);
+    unique_ptr<THnBase> chunk(dynamic_cast<THnBase*>(key->ReadObj()));
+    readTimer.Stop();
+    if (!chunk) {
+      ERROR("Invalid chunk {} of {} in file {}.", key->GetName(), placeholder->GetName(), fileName);
+      return false;
+    }
+    if (!process(chunk.get())) return false;
+  }
+  return true;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,141 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ContainerCache.h"
+#include "Logging.h"
+
+// root dependencies
+#include "TKey.h"
+#include "TCollection.h"
+#include "TDirectory.h"
+#include "TDatime.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Constructor.
+ */
+//**************************************************************************************************
+ContainerCache::ContainerCache(uint64_t maxSize) : mMaxSize{maxSize}
+{
+}
+
+//**************************************************************************************************
+/**
+ * Destructor.
+ */
+//**************************************************************************************************
+ContainerCache::~ContainerCache()
+{
+  Clear();
+}
+
+//**************************************************************************************************
+/**
+ * Sets the memory limit; containers exceeding it are dropped immediately.
+ */
+//**************************************************************************************************
+void ContainerCache::SetMaxSize(uint64_t maxSize)
+{
+  mMaxSize = maxSize;
+  while (mSize > mMaxSize && !mUsage.empty()) {
+    Remove(mUsage.back());
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Returns the cached container belonging to the key (if it was not modified in the meantime).
+ */
+//**************************************************************************************************
+TCollection* ContainerCache::Get(TKey* key)
+{
+  string identifier = GetIdentifier(key);
+  auto it = mEntries.find(identifier);
+  if (it == mEntries.end()) return nullptr;
+  if (it->second.seekKey != key->GetSeekKey() || it->second.datime != key->GetDatime().Get()) {
+    Remove(identifier);
+    return nullptr;
+  }
+  mUsage.remove(identifier);
+  mUsage.push_front(identifier);
+  return it->second.container.get();
+}
+
+//**************************************************************************************************
+/**
+ * Adds a container that was read from the key. Containers that are larger than the memory limit
+ * are not cached (the caller then keeps ownership).
+ */
+//**************************************************************************************************
+bool ContainerCache::Add(TKey* key, TCollection* container)
+{
+  uint64_t size = key->GetObjlen();
+  if (!container || size > mMaxSize) return false;
+  string identifier = GetIdentifier(key);
+  Remove(identifier);
+  while (mSize + size > mMaxSize && !mUsage.empty()) {
+    Remove(mUsage.back());
+  }
+  container->SetOwner();
+  mEntries[identifier] = {unique_ptr<TCollection>(container), key->GetSeekKey(), key->GetDatime().Get(), size};
+  mUsage.push_front(identifier);
+  mSize += size;
+  DEBUG("Caching {} ({:.1f} MB, {:.1f} MB in total).", identifier, size / 1024. / 1024., mSize / 1024. / 1024.);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Removes all containers from the cache.
+ */
+//**************************************************************************************************
+void ContainerCache::Clear()
+{
+  mEntries.clear();
+  mUsage.clear();
+  mSize = 0;
+}
+
+//**************************************************************************************************
+/**
+ * Removes a container from the cache.
+ */
+//**************************************************************************************************
+void ContainerCache::Remove(const string& identifier)
+{
+  auto it = mEntries.find(identifier);
+  if (it == mEntries.end()) return;
+  mSize -= it->second.size;
+  mEntries.erase(it);
+  mUsage.remove(identifier);
+}
+
+//**************************************************************************************************
+/**
+ * Full path of the key including the file and its cycle.
+ */
+//**************************************************************************************************
+string ContainerCache::GetIdentifier(TKey* key)
+{
+  string directory = (key->GetMotherDir()) ? key->GetMotherDir()->GetPath() : "";
+  return directory + "/" + key->GetName() + ";" + std::to_string(key->GetCycle());
+}
+
+} // end namespace PlottingFramework
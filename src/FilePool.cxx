@@ -0,0 +1,150 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "FilePool.h"
+#include "Profiler.h"
+#include "Logging.h"
+#include "Helpers.h"
+
+// std dependencies
+#include <filesystem>
+
+// root dependencies
+#include "TFile.h"
+#include "TKey.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Constructor.
+ */
+//**************************************************************************************************
+FilePool::FilePool(uint32_t maxOpenFiles) : mMaxOpenFiles((maxOpenFiles > 0) ? maxOpenFiles : 1)
+{
+}
+
+//**************************************************************************************************
+/**
+ * Destructor. Closes all files.
+ */
+//**************************************************************************************************
+FilePool::~FilePool()
+{
+  Clear();
+}
+
+//**************************************************************************************************
+/**
+ * Sets the maximum number of files that are kept open.
+ */
+//**************************************************************************************************
+void FilePool::SetMaxOpenFiles(uint32_t maxOpenFiles)
+{
+  mMaxOpenFiles = (maxOpenFiles > 0) ? maxOpenFiles : 1;
+}
+
+//**************************************************************************************************
+/**
+ * Returns the open file, which is opened first in case it is not yet in the pool.
+ */
+//**************************************************************************************************
+TFile* FilePool::Open(const string& fileName)
+{
+  std::error_code errorCode;
+  string path = std::filesystem::weakly_canonical(fileName, errorCode).string();
+  if (errorCode) path = fileName;
+
+  mUsage.remove(path);
+  mUsage.push_front(path);
+  if (auto it = mFiles.find(path); it != mFiles.end()) {
+    return it->second.file.get();
+  }
+
+  ScopedTimer openTimer(Profiler::file_open, fileName);
+  unique_ptr<TFile> file(TFile::Open(fileName.data(), "READ"));
+  openTimer.Stop();
+  if (!file || file->IsZombie()) {
+    mUsage.pop_front();
+    return nullptr;
+  }
+  TFile* openFile = file.get();
+  mFiles[path].file = std::move(file);
+
+  while (mFiles.size() > mMaxOpenFiles) {
+    DEBUG("Closing input file {}.", mUsage.back());
+    mFiles.erase(mUsage.back());
+    mUsage.pop_back();
+  }
+  return openFile;
+}
+
+//**************************************************************************************************
+/**
+ * Follows the path as long as it consists of directories and returns the last one. The directories
+ * found are removed from the path, which then only contains the part within lists, folders, etc.
+ */
+//**************************************************************************************************
+TDirectory* FilePool::GetDirectory(TDirectory* directory, vector<string>& path)
+{
+  file_entry_t* entry = FindEntry(directory->GetFile());
+  while (directory && !path.empty()) {
+    TDirectory* subDirectory{};
+    if (entry) {
+      if (auto it = entry->subDirectories.find({directory, path[0]}); it != entry->subDirectories.end()) {
+        subDirectory = it->second;
+      }
+    }
+    if (!subDirectory) {
+      TKey* key = directory->FindKey(path[0].data());
+      if (!key || !str_contains(key->GetClassName(), "TDirectory")) break;
+      subDirectory = directory->GetDirectory(path[0].data());
+      if (!subDirectory) break;
+      if (entry) entry->subDirectories[{directory, path[0]}] = subDirectory;
+    }
+    directory = subDirectory;
+    path.erase(path.begin());
+  }
+  return directory;
+}
+
+//**************************************************************************************************
+/**
+ * Closes all files.
+ */
+//**************************************************************************************************
+void FilePool::Clear()
+{
+  mFiles.clear();
+  mUsage.clear();
+}
+
+//**************************************************************************************************
+/**
+ * Pool entry of an open file.
+ */
+//**************************************************************************************************
+FilePool::file_entry_t* FilePool::FindEntry(TFile* file)
+{
+  for (auto& [path, entry] : mFiles) {
+    if (entry.file.get() == file) return &entry;
+  }
+  return nullptr;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,156 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// framework dependencies
+#include "FileWatcher.h"
+#include "Logging.h"
+
+// std dependencies
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+namespace PlottingFramework
+{
+namespace fs = std::filesystem;
+
+//**************************************************************************************************
+/**
+ * Constructor for FileWatcher.
+ */
+//**************************************************************************************************
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+  mInotify = inotify_init1(IN_CLOEXEC);
+  if (mInotify < 0) {
+    WARNING("Could not initialize inotify. Falling back to polling.");
+  }
+#endif
+}
+
+//**************************************************************************************************
+/**
+ * Destructor for FileWatcher.
+ */
+//**************************************************************************************************
+FileWatcher::~FileWatcher()
+{
+  if (mInotify >= 0) close(mInotify);
+}
+
+//**************************************************************************************************
+/**
+ * Defines the files that should be watched.
+ */
+//**************************************************************************************************
+void FileWatcher::SetFiles(const vector<string>& fileNames)
+{
+  mFiles.clear();
+  mTimestamps.clear();
+  set<string> directories;
+  for (auto& fileName : fileNames) {
+    std::error_code errorCode;
+    fs::path filePath = fs::absolute(fileName, errorCode).lexically_normal();
+    mFiles.insert(filePath.string());
+    mTimestamps[filePath.string()] = fs::last_write_time(filePath, errorCode);
+    directories.insert(filePath.parent_path().string());
+  }
+#ifdef __linux__
+  if (mInotify < 0) return;
+  for (auto it = mWatchedDirectories.begin(); it != mWatchedDirectories.end();) {
+    if (directories.find(it->second) == directories.end()) {
+      inotify_rm_watch(mInotify, it->first);
+      it = mWatchedDirectories.erase(it);
+    } else {
+      directories.erase(it->second);
+      ++it;
+    }
+  }
+  for (auto& directory : directories) {
+    int32_t watchDescriptor = inotify_add_watch(mInotify, directory.data(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchDescriptor < 0) {
+      WARNING("Cannot watch directory {}.", directory);
+      continue;
+    }
+    mWatchedDirectories[watchDescriptor] = directory;
+  }
+#endif
+}
+
+//**************************************************************************************************
+/**
+ * Blocks until at least one of the files was modified. Changes are collected until there was no further
+ * modification for the specified settle time, such that files that are still being written are not reported too early.
+ */
+//**************************************************************************************************
+vector<string> FileWatcher::WaitForChanges(uint32_t settleTimeMs)
+{
+  set<string> modifiedFiles;
+#ifdef __linux__
+  if (mInotify >= 0) {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+      pollfd pollInfo{mInotify, POLLIN, 0};
+      int32_t timeout = (modifiedFiles.empty()) ? -1 : static_cast<int32_t>(settleTimeMs);
+      int32_t result = poll(&pollInfo, 1, timeout);
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        break;
+      }
+      if (result == 0) break; // nothing happened within settle time
+      ssize_t length = read(mInotify, buffer, sizeof(buffer));
+      if (length <= 0) continue;
+      for (char* pos = buffer; pos < buffer + length;) {
+        auto event = reinterpret_cast<inotify_event*>(pos);
+        pos += sizeof(inotify_event) + event->len;
+        if (event->len == 0) continue;
+        auto directory = mWatchedDirectories.find(event->wd);
+        if (directory == mWatchedDirectories.end()) continue;
+        string fileName = (fs::path(directory->second) / event->name).string();
+        if (mFiles.find(fileName) != mFiles.end()) modifiedFiles.insert(fileName);
+      }
+    }
+    for (auto& fileName : modifiedFiles) {
+      std::error_code errorCode;
+      mTimestamps[fileName] = fs::last_write_time(fileName, errorCode);
+    }
+    return {modifiedFiles.begin(), modifiedFiles.end()};
+  }
+#endif
+  while (true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(settleTimeMs));
+    bool foundModifications = false;
+    for (auto& [fileName, timestamp] : mTimestamps) {
+      std::error_code errorCode;
+      auto lastModified = fs::last_write_time(fileName, errorCode);
+      if (lastModified != timestamp) {
+        timestamp = lastModified;
+        modifiedFiles.insert(fileName);
+        foundModifications = true;
+      }
+    }
+    if (!modifiedFiles.empty() && !foundModifications) break;
+  }
+  return {modifiedFiles.begin(), modifiedFiles.end()};
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,569 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "HEPDataReader.h"
+#include "TextFile.h"
+#include "Helpers.h"
+#include "Logging.h"
+
+// std dependencies
+#include <cmath>
+#include <filesystem>
+
+// root dependencies
+#include "TGraphAsymmErrors.h"
+
+namespace PlottingFramework
+{
+static constexpr double_t kNaN = std::numeric_limits<double_t>::quiet_NaN();
+
+//**************************************************************************************************
+/**
+ * Check if path matches the pattern of keys ("-" for sequence items).
+ */
+//**************************************************************************************************
+static bool is_path(const vector<std::string_view>& path, std::initializer_list<std::string_view> pattern)
+{
+  return std::equal(path.begin(), path.end(), pattern.begin(), pattern.end());
+}
+
+//**************************************************************************************************
+/**
+ * Remove quotes around a scalar.
+ */
+//**************************************************************************************************
+static std::string_view unquote(std::string_view scalar)
+{
+  scalar = trim_blanks(scalar);
+  if (scalar.size() >= 2 && (scalar.front() == '\'' || scalar.front() == '"') && scalar.back() == scalar.front()) {
+    scalar = scalar.substr(1, scalar.size() - 2);
+  }
+  return scalar;
+}
+
+//**************************************************************************************************
+/**
+ * Find the first of the delimiters at or after position, skipping a quoted token at the beginning.
+ */
+//**************************************************************************************************
+static size_t find_delimiter(std::string_view text, size_t position, std::string_view delimiters)
+{
+  while (position < text.size() && text[position] == ' ') ++position;
+  if (position < text.size() && (text[position] == '\'' || text[position] == '"')) {
+    size_t quoteEnd = text.find(text[position], position + 1);
+    if (quoteEnd != std::string_view::npos) position = quoteEnd + 1;
+  }
+  return text.find_first_of(delimiters, position);
+}
+
+//**************************************************************************************************
+/**
+ * Check if all brackets of a flow collection are closed.
+ */
+//**************************************************************************************************
+static bool is_balanced(std::string_view text)
+{
+  int32_t depth{};
+  char quote{};
+  for (char c : text) {
+    if (quote) {
+      if (c == quote) quote = 0;
+    } else if (c == '\'' || c == '"') {
+      quote = c;
+    } else if (c == '{' || c == '[') {
+      ++depth;
+    } else if (c == '}' || c == ']') {
+      --depth;
+    }
+  }
+  return depth <= 0;
+}
+
+//**************************************************************************************************
+/**
+ * Parse a number or a percentage (e.g. "5%").
+ */
+//**************************************************************************************************
+static bool parse_error(std::string_view field, double_t& value, bool& isRelative)
+{
+  field = trim_blanks(field);
+  isRelative = (!field.empty() && field.back() == '%');
+  if (isRelative) field = trim_blanks(field.substr(0, field.size() - 1));
+  return parse_number(field, value);
+}
+
+//**************************************************************************************************
+/**
+ * Split a line of a csv file (fields may be quoted).
+ */
+//**************************************************************************************************
+static void split_csv_line(std::string_view line, vector<std::string_view>& fields)
+{
+  fields.clear();
+  size_t position{};
+  while (true) {
+    size_t end = find_delimiter(line, position, ",");
+    fields.push_back(unquote(line.substr(position, (end == std::string_view::npos) ? end : end - position)));
+    if (end == std::string_view::npos) break;
+    position = end + 1;
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Check if file is a hepdata table.
+ */
+//**************************************************************************************************
+bool HEPDataReader::IsHEPDataFile(const string& fileName)
+{
+  auto nameOptions = split_string(fileName, ':', true);
+  string name = nameOptions[0];
+  auto endsWith = [&name](const string& suffix) { return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0; };
+  if (endsWith(".gz")) name.resize(name.size() - 3);
+  if (endsWith(".yaml") || endsWith(".yml")) return true;
+  return endsWith(".csv") && nameOptions.size() > 1 && nameOptions[1] == "hepdata";
+}
+
+//**************************************************************************************************
+/**
+ * Get name of the table (file name without extensions).
+ */
+//**************************************************************************************************
+string HEPDataReader::GetTableName(const string& fileName)
+{
+  std::filesystem::path filePath(split_string(fileName, ':', true)[0]);
+  if (filePath.extension() == ".gz") filePath.replace_extension();
+  return filePath.stem().string();
+}
+
+//**************************************************************************************************
+/**
+ * Check if (zero based) dependent variable is required.
+ */
+//**************************************************************************************************
+bool HEPDataReader::IsRequired(size_t variable) const
+{
+  string name = "y" + std::to_string(variable + 1);
+  return std::any_of(mRequiredNames.begin(), mRequiredNames.end(), [&](const string& requiredName) { return requiredName == name || requiredName.compare(0, name.size() + 1, name + "/") == 0; });
+}
+
+//**************************************************************************************************
+/**
+ * Read the required graphs from the table.
+ */
+//**************************************************************************************************
+bool HEPDataReader::Read(const string& fileName, const vector<string>& requiredNames)
+{
+  mObjects.clear();
+  mRequiredNames.clear();
+  mNumIndependentVariables = 0;
+  mBins.clear();
+  mVariables.clear();
+  mIsVariableRequired.clear();
+
+  mTableName = GetTableName(fileName);
+  for (auto& name : requiredNames) {
+    if (name.compare(0, mTableName.size() + 1, mTableName + "/") == 0) mRequiredNames.push_back(name.substr(mTableName.size() + 1));
+  }
+  if (mRequiredNames.empty()) return true;
+
+  TextFile file;
+  if (!file.Open(fileName)) return false;
+  string name = fileName;
+  if (std::filesystem::path(name).extension() == ".gz") name.resize(name.size() - 3);
+  bool isCSV = (std::filesystem::path(name).extension() == ".csv");
+  if (!((isCSV) ? ParseCSV(file.GetContent(), fileName) : ParseYAML(file.GetContent(), fileName))) return false;
+  if (mNumIndependentVariables != 1) {
+    ERROR("Only tables with exactly one independent variable are supported ({} has {}).", fileName, mNumIndependentVariables);
+    return false;
+  }
+  CreateGraphs(fileName);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Minimal streaming parser for the yaml subset used by hepdata tables (block and flow collections,
+ * plain and quoted scalars). Each sequence item and scalar is passed on to BeginItem and SetValue
+ * together with its path of keys; sequence items for which BeginItem returns false are skipped.
+ */
+//**************************************************************************************************
+bool HEPDataReader::ParseYAML(std::string_view content, const string& fileName)
+{
+  struct frame_t {
+    size_t indent;
+    std::string_view key; // "-" for sequence items
+  };
+  vector<frame_t> frames;
+  vector<std::string_view> path;
+  auto updatePath = [&]() {
+    path.clear();
+    for (auto& frame : frames) path.push_back(frame.key);
+  };
+  optional<size_t> skipIndent; // lines indented deeper belong to a skipped item or a multi-line scalar
+  size_t position{};
+  string flowText;
+  auto parseFlow = [&](std::string_view text) {
+    // flow collections may span several lines
+    flowText = text;
+    std::string_view line;
+    while (!is_balanced(flowText) && next_line(content, position, line)) {
+      flowText += ' ';
+      flowText += trim_blanks(line);
+    }
+    size_t flowPosition{};
+    if (ParseFlow(flowText, flowPosition, path, true)) return true;
+    ERROR("Malformed flow collection '{}' in {}.", flowText, fileName);
+    return false;
+  };
+
+  std::string_view line;
+  while (next_line(content, position, line)) {
+    size_t indent = line.find_first_not_of(' ');
+    if (indent == std::string_view::npos) continue;
+    std::string_view text = trim_blanks(line.substr(indent));
+    if (text.empty() || text.front() == '#') continue;
+    if (text == "---" || text == "...") {
+      frames.clear();
+      skipIndent.reset();
+      continue;
+    }
+    if (skipIndent) {
+      if (indent > *skipIndent) continue;
+      skipIndent.reset();
+    }
+
+    // sequence items can be placed at the same indentation as the key they belong to
+    auto isItem = [](std::string_view text) { return text == "-" || text.compare(0, 2, "- ") == 0; };
+    while (!frames.empty() && (indent < frames.back().indent || (indent == frames.back().indent && !(isItem(text) && frames.back().key != "-")))) {
+      frames.pop_back();
+    }
+    while (isItem(text)) {
+      frames.push_back({indent, "-"});
+      updatePath();
+      if (!BeginItem(path)) {
+        frames.pop_back();
+        skipIndent = indent;
+        text = {};
+        break;
+      }
+      size_t offset = text.find_first_not_of(' ', 1);
+      if (offset == std::string_view::npos) {
+        text = {};
+        break;
+      }
+      indent += offset;
+      text.remove_prefix(offset);
+    }
+    if (text.empty()) continue;
+    updatePath();
+
+    if (text.front() == '{' || text.front() == '[') {
+      if (!parseFlow(text)) return false;
+      continue;
+    }
+    size_t separator = find_delimiter(text, 0, ":");
+    while (separator != std::string_view::npos && separator + 1 < text.size() && text[separator + 1] != ' ') {
+      separator = text.find(':', separator + 1);
+    }
+    if (separator == std::string_view::npos) {
+      SetValue(path, unquote(text));
+      skipIndent = indent;
+      continue;
+    }
+    std::string_view key = unquote(text.substr(0, separator));
+    std::string_view value = trim_blanks(text.substr(separator + 1));
+    if (value.empty()) {
+      frames.push_back({indent, key});
+      continue;
+    }
+    path.push_back(key);
+    if (value.front() == '{' || value.front() == '[') {
+      if (!parseFlow(value)) return false;
+    } else {
+      if (value.front() != '|' && value.front() != '>') SetValue(path, unquote(value));
+      skipIndent = indent;
+    }
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Parse flow collection or scalar starting at position.
+ */
+//**************************************************************************************************
+bool HEPDataReader::ParseFlow(std::string_view text, size_t& position, vector<std::string_view>& path, bool emit)
+{
+  auto skipBlanks = [&]() {
+    while (position < text.size() && text[position] == ' ') ++position;
+  };
+  skipBlanks();
+  if (position >= text.size()) return false;
+  char open = text[position];
+  if (open != '{' && open != '[') {
+    size_t end = find_delimiter(text, position, ",}]");
+    if (end == std::string_view::npos) end = text.size();
+    if (emit) SetValue(path, unquote(text.substr(position, end - position)));
+    position = end;
+    return true;
+  }
+
+  bool isMap = (open == '{');
+  char close = (isMap) ? '}' : ']';
+  ++position;
+  while (true) {
+    skipBlanks();
+    if (position >= text.size()) return false;
+    if (text[position] == close) {
+      ++position;
+      return true;
+    }
+    bool success{};
+    if (isMap) {
+      size_t keyEnd = find_delimiter(text, position, ":");
+      if (keyEnd == std::string_view::npos) return false;
+      path.push_back(unquote(text.substr(position, keyEnd - position)));
+      position = keyEnd + 1;
+      success = ParseFlow(text, position, path, emit);
+    } else {
+      path.push_back("-");
+      success = ParseFlow(text, position, path, emit && BeginItem(path));
+    }
+    path.pop_back();
+    if (!success) return false;
+    skipBlanks();
+    if (position < text.size() && text[position] == ',') ++position;
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Handle beginning of a sequence item in the yaml file; returns false if the item can be skipped.
+ */
+//**************************************************************************************************
+bool HEPDataReader::BeginItem(const vector<std::string_view>& path)
+{
+  if (is_path(path, {"independent_variables", "-"})) {
+    return (++mNumIndependentVariables == 1);
+  } else if (is_path(path, {"independent_variables", "-", "values", "-"})) {
+    mBins.push_back({kNaN, kNaN, kNaN});
+  } else if (is_path(path, {"dependent_variables", "-"})) {
+    mVariables.emplace_back();
+    mIsVariableRequired.push_back(IsRequired(mVariables.size() - 1));
+    return mIsVariableRequired.back();
+  } else if (is_path(path, {"dependent_variables", "-", "values", "-"})) {
+    mVariables.back().push_back({kNaN, {}});
+  } else if (is_path(path, {"dependent_variables", "-", "values", "-", "errors", "-"})) {
+    mVariables.back().back().errors.emplace_back();
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Handle scalar in the yaml file.
+ */
+//**************************************************************************************************
+void HEPDataReader::SetValue(const vector<std::string_view>& path, std::string_view value)
+{
+  if (path.size() == 5 && is_path({path.begin(), path.end() - 1}, {"independent_variables", "-", "values", "-"})) {
+    std::string_view key = path.back();
+    double_t* target = (key == "value") ? &mBins.back().value : (key == "low") ? &mBins.back().low : (key == "high") ? &mBins.back().high : nullptr;
+    if (target && !parse_number(value, *target)) *target = kNaN; // e.g. labels of categories
+  } else if (is_path(path, {"dependent_variables", "-", "values", "-", "value"})) {
+    if (!parse_number(value, mVariables.back().back().value)) mVariables.back().back().value = kNaN;
+  } else if (path.size() >= 7 && is_path({path.begin(), path.begin() + 6}, {"dependent_variables", "-", "values", "-", "errors", "-"})) {
+    error_t& error = mVariables.back().back().errors.back();
+    vector<std::string_view> key(path.begin() + 6, path.end());
+    double_t number{};
+    if (is_path(key, {"label"})) {
+      error.label = value;
+    } else if (is_path(key, {"symerror"}) && parse_error(value, number, error.isRelative)) {
+      error.plus = std::abs(number);
+      error.minus = -std::abs(number);
+    } else if (is_path(key, {"asymerror", "plus"}) && parse_error(value, number, error.isRelative)) {
+      error.plus = number;
+    } else if (is_path(key, {"asymerror", "minus"}) && parse_error(value, number, error.isRelative)) {
+      error.minus = number;
+    }
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Parse the csv export of a hepdata table. It consists of blocks (separated by empty lines) with a
+ * header line ("x", "x LOW", "x HIGH", "y", "stat +", "stat -", ...) followed by the values.
+ */
+//**************************************************************************************************
+bool HEPDataReader::ParseCSV(std::string_view content, const string& fileName)
+{
+  struct column_t {
+    size_t variable;
+    optional<size_t> error; // index in errors of point
+    bool isPlus{};
+  };
+  vector<column_t> columns; // dependent variable columns of current block
+  size_t nIndependentColumns{};
+  bool isHeader = true;
+  bool isFirstBlock = true;
+  size_t nRows{};
+  vector<string> errorLabels;
+  vector<std::string_view> fields;
+  auto endsWith = [](std::string_view str, std::string_view suffix) { return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0; };
+
+  size_t position{};
+  std::string_view line;
+  while (next_line(content, position, line)) {
+    line = trim_blanks(line);
+    if (line.compare(0, 2, "#:") == 0) continue;
+    if (line.empty()) {
+      if (!isHeader) isFirstBlock = false;
+      isHeader = true;
+      continue;
+    }
+    split_csv_line(line, fields);
+
+    if (isHeader) {
+      isHeader = false;
+      nRows = 0;
+      columns.clear();
+      errorLabels.clear();
+      nIndependentColumns = (fields.size() >= 3 && endsWith(fields[1], "LOW") && endsWith(fields[2], "HIGH")) ? 3u : 1u;
+      mNumIndependentVariables = 1;
+      if (fields.size() >= nIndependentColumns + 3 && endsWith(fields[nIndependentColumns + 1], "LOW") && endsWith(fields[nIndependentColumns + 2], "HIGH")) {
+        mNumIndependentVariables = 2; // not supported
+        return true;
+      }
+      for (size_t i = nIndependentColumns; i < fields.size(); ++i) {
+        bool isPlus = endsWith(fields[i], " +");
+        bool isError = isPlus || endsWith(fields[i], " -");
+        if (isError && !columns.empty()) {
+          string label(trim_blanks(fields[i].substr(0, fields[i].size() - 2)));
+          // plus and minus columns of the same uncertainty are next to each other
+          optional<size_t> errorIndex;
+          if (columns.back().error && errorLabels[*columns.back().error] == label && columns.back().isPlus != isPlus) {
+            errorIndex = columns.back().error;
+          } else {
+            errorIndex = errorLabels.size();
+            errorLabels.push_back(label);
+          }
+          columns.push_back({columns.back().variable, errorIndex, isPlus});
+        } else {
+          mVariables.emplace_back();
+          mIsVariableRequired.push_back(IsRequired(mVariables.size() - 1));
+          errorLabels.clear();
+          columns.push_back({mVariables.size() - 1, std::nullopt});
+        }
+      }
+      continue;
+    }
+
+    if (fields.size() < nIndependentColumns + columns.size()) {
+      ERROR("Unexpected number of columns in line '{}' of {}.", line, fileName);
+      return false;
+    }
+    if (isFirstBlock) {
+      bin_t bin{kNaN, kNaN, kNaN};
+      if (!parse_number(fields[0], bin.value)) bin.value = kNaN;
+      if (nIndependentColumns == 3) {
+        if (!parse_number(fields[1], bin.low)) bin.low = kNaN;
+        if (!parse_number(fields[2], bin.high)) bin.high = kNaN;
+      }
+      mBins.push_back(bin);
+    } else if (nRows >= mBins.size()) {
+      ERROR("Blocks of {} have different number of rows.", fileName);
+      return false;
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto& column = columns[i];
+      if (!mIsVariableRequired[column.variable]) continue;
+      auto& points = mVariables[column.variable];
+      std::string_view field = fields[nIndependentColumns + i];
+      if (!column.error) {
+        points.push_back({kNaN, {}});
+        if (!parse_number(field, points.back().value)) points.back().value = kNaN;
+        continue;
+      }
+      auto& errors = points.back().errors;
+      if (errors.size() <= *column.error) errors.resize(*column.error + 1);
+      error_t& error = errors[*column.error];
+      error.label = errorLabels[*column.error];
+      double_t number{};
+      if (parse_error(field, number, error.isRelative)) (column.isPlus) ? error.plus = number : error.minus = number;
+    }
+    ++nRows;
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Create the requested graphs from the values of the table.
+ */
+//**************************************************************************************************
+void HEPDataReader::CreateGraphs(const string& fileName)
+{
+  for (auto& requiredName : mRequiredNames) {
+    auto nameLabel = split_string(requiredName, '/', true);
+    size_t variable{};
+    auto [end, error] = std::from_chars(nameLabel[0].data() + 1, nameLabel[0].data() + nameLabel[0].size(), variable);
+    if (nameLabel[0].empty() || nameLabel[0][0] != 'y' || error != std::errc() || end != nameLabel[0].data() + nameLabel[0].size() || variable == 0 || variable > mVariables.size()) continue;
+    auto& points = mVariables[variable - 1];
+    if (points.size() != mBins.size()) {
+      ERROR("Number of values of dependent variable {} does not match independent variable in {}.", variable, fileName);
+      continue;
+    }
+    optional<string> label;
+    if (nameLabel.size() > 1) label = nameLabel[1];
+
+    vector<double_t> x, y, exl, exh, eyl, eyh;
+    bool hasLabel = !label;
+    for (size_t i = 0; i < points.size(); ++i) {
+      auto& point = points[i];
+      if (std::isnan(point.value)) continue;
+      auto& bin = mBins[i];
+      double_t xValue = (!std::isnan(bin.value)) ? bin.value : (!std::isnan(bin.low) && !std::isnan(bin.high)) ? (bin.low + bin.high) / 2 : i + 1.;
+      x.push_back(xValue);
+      exl.push_back((!std::isnan(bin.low)) ? xValue - bin.low : 0.);
+      exh.push_back((!std::isnan(bin.high)) ? bin.high - xValue : 0.);
+      y.push_back(point.value);
+      double_t errDown2{}, errUp2{};
+      for (auto& error : point.errors) {
+        if (label && error.label != *label) continue;
+        hasLabel = true;
+        double_t scale = (error.isRelative) ? std::abs(point.value) / 100. : 1.;
+        double_t down = std::min({error.plus, error.minus, 0.}) * scale;
+        double_t up = std::max({error.plus, error.minus, 0.}) * scale;
+        errDown2 += down * down;
+        errUp2 += up * up;
+      }
+      eyl.push_back(std::sqrt(errDown2));
+      eyh.push_back(std::sqrt(errUp2));
+    }
+    if (!hasLabel) {
+      ERROR("There are no uncertainties labeled '{}' in {}.", *label, fileName);
+      continue;
+    }
+    string name = mTableName + "/" + requiredName;
+    auto graph = std::make_unique<TGraphAsymmErrors>(x.size(), x.data(), y.data(), exl.data(), exh.data(), eyl.data(), eyh.data());
+    graph->SetName(name.data());
+    mObjects[name] = std::move(graph);
+  }
+}
+
+} // end namespace PlottingFramework
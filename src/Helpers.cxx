@@ -17,6 +17,7 @@
 
 #include "Helpers.h"
 #include <sys/stat.h>
+#include <glob.h>
 
 namespace PlottingFramework
 {
@@ -55,4 +56,16 @@ bool file_exists(const std::string& name)
   return (stat(name.c_str(), &buffer) == 0);
 }
 
+vector<string> expand_glob(const string& pattern)
+{
+  if (pattern.find_first_of("*?[") == string::npos) return {pattern};
+  vector<string> fileNames;
+  glob_t globResult;
+  if (glob(pattern.data(), 0, nullptr, &globResult) == 0) {
+    fileNames.assign(globResult.gl_pathv, globResult.gl_pathv + globResult.gl_pathc);
+  }
+  globfree(&globResult);
+  return fileNames;
+}
+
 } // end namespace PlottingFramework
@@ -0,0 +1,387 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// framework dependencies
+#include "Logger.h"
+#include "Logging.h"
+
+// std dependencies
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace PlottingFramework
+{
+using std::string;
+
+// plot currently processed by the thread
+static thread_local string tPlotName;
+static thread_local string tFigureGroup;
+
+//**************************************************************************************************
+/**
+ * Translates number or name of a level.
+ */
+//**************************************************************************************************
+static bool ParseLevel(const string& levelStr, Logger::level_t& level)
+{
+  static const std::array<const char*, 5> levelNames{"error", "warning", "info", "log", "debug"};
+  for (size_t i = 0; i < levelNames.size(); ++i) {
+    if (levelStr == levelNames[i] || levelStr == std::to_string(i)) {
+      level = static_cast<Logger::level_t>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//**************************************************************************************************
+/**
+ * The logger lives until the very end of the program, such that also messages from destructors of
+ * static objects can be printed. Pending messages are written when the program exits.
+ */
+//**************************************************************************************************
+Logger& Logger::Instance()
+{
+  static Logger* logger = new Logger();
+  return *logger;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor. Starts the thread writing the messages.
+ */
+//**************************************************************************************************
+Logger::Logger()
+{
+  for (uint64_t i = 0; i < kCapacity; ++i) {
+    mSlots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mIsRunning = true;
+  mSinkThread = std::thread([this]() {
+    while (true) {
+      if (Drain()) continue;
+      if (!mIsRunning.load(std::memory_order_acquire)) break;
+      std::unique_lock<std::mutex> lock(mSinkMutex);
+      mSinkCondition.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  });
+  std::atexit([]() { Instance().Stop(); });
+}
+
+//**************************************************************************************************
+/**
+ * Stops the background thread after all pending messages were written.
+ */
+//**************************************************************************************************
+void Logger::Stop()
+{
+  if (!mIsRunning.exchange(false)) return;
+  mSinkCondition.notify_one();
+  if (mSinkThread.joinable()) mSinkThread.join();
+  Drain();
+}
+
+//**************************************************************************************************
+/**
+ * Assigns an index to the module a message originates from (called once per logging statement).
+ */
+//**************************************************************************************************
+uint16_t Logger::RegisterModule(const char* fileName)
+{
+  string module = fileName;
+  module.erase(0, module.find_last_of("/\\") + 1);
+  module = module.substr(0, module.find('.'));
+
+  Logger& logger = Instance();
+  std::lock_guard<std::mutex> lock(logger.mModuleMutex);
+  auto& moduleNames = logger.mModuleNames;
+  uint16_t index = std::find(moduleNames.begin(), moduleNames.end(), module) - moduleNames.begin();
+  if (index == moduleNames.size()) {
+    if (index == kMaxModules - 1) {
+      module = "other"; // all further modules share the last slot
+    }
+    if (index < kMaxModules) moduleNames.push_back(module);
+    index = std::min<uint16_t>(index, kMaxModules - 1);
+  }
+  auto filter = logger.mModuleFilters.find(module);
+  sModuleLevels[index].store((filter != logger.mModuleFilters.end()) ? filter->second : logger.mVerbosity, std::memory_order_relaxed);
+  return index;
+}
+
+//**************************************************************************************************
+/**
+ * Sets verbosity of all modules that have no individual filter.
+ */
+//**************************************************************************************************
+void Logger::SetVerbosity(level_t level)
+{
+  Logger& logger = Instance();
+  std::lock_guard<std::mutex> lock(logger.mModuleMutex);
+  logger.mVerbosity = level;
+  for (size_t i = 0; i < logger.mModuleNames.size(); ++i) {
+    if (logger.mModuleFilters.find(logger.mModuleNames[i]) == logger.mModuleFilters.end()) sModuleLevels[i].store(level, std::memory_order_relaxed);
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Sets verbosity of an individual module (e.g. "PlotPainter").
+ */
+//**************************************************************************************************
+void Logger::SetModuleVerbosity(const string& module, level_t level)
+{
+  Logger& logger = Instance();
+  std::lock_guard<std::mutex> lock(logger.mModuleMutex);
+  logger.mModuleFilters[module] = level;
+  auto& moduleNames = logger.mModuleNames;
+  if (auto it = std::find(moduleNames.begin(), moduleNames.end(), module); it != moduleNames.end()) {
+    sModuleLevels[it - moduleNames.begin()].store(level, std::memory_order_relaxed);
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Applies filters of the form "warning,PlotPainter=debug,PlotManager=3". Entries without module
+ * name set the global verbosity.
+ */
+//**************************************************************************************************
+bool Logger::SetFilters(const string& filters)
+{
+  size_t start{};
+  while (start <= filters.size()) {
+    size_t end = filters.find(',', start);
+    if (end == string::npos) end = filters.size();
+    string filter = filters.substr(start, end - start);
+    start = end + 1;
+    if (filter.empty()) continue;
+
+    auto separator = filter.find('=');
+    level_t level;
+    if (!ParseLevel(filter.substr((separator == string::npos) ? 0 : separator + 1), level)) {
+      ERROR("Invalid log filter {}.", filter);
+      return false;
+    }
+    if (separator == string::npos) {
+      SetVerbosity(level);
+    } else {
+      SetModuleVerbosity(filter.substr(0, separator), level);
+    }
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Additionally write all messages as JSON lines to the specified file.
+ */
+//**************************************************************************************************
+bool Logger::SetJSONOutput(const string& fileName)
+{
+  Logger& logger = Instance();
+  logger.Flush();
+  std::lock_guard<std::mutex> lock(logger.mSinkMutex);
+  if (logger.mJSONStream) std::fclose(logger.mJSONStream);
+  logger.mJSONStream = std::fopen(fileName.data(), "a");
+  if (!logger.mJSONStream) {
+    fmt::print(stderr, RED_ "[ ERR  ]" _END " Cannot open log file {}.\n", fileName);
+    return false;
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Sets the plot that is currently processed by the calling thread.
+ */
+//**************************************************************************************************
+void Logger::SetContext(const string& plotName, const string& figureGroup)
+{
+  tPlotName = plotName;
+  tFigureGroup = figureGroup;
+}
+
+//**************************************************************************************************
+/**
+ * Queues a formatted message. If the queue is full, the calling thread waits until there is space.
+ * Errors are written before returning, such that they are not lost in case the program crashes.
+ */
+//**************************************************************************************************
+void Logger::Push(kind_t kind, uint16_t module, string&& text)
+{
+  message_t message{kind, module, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), std::move(text), {}, {}};
+  {
+    // the JSON stream is guarded by the same mutex as the console output
+    std::lock_guard<std::mutex> lock(mSinkMutex);
+    if (mJSONStream) {
+      message.plotName = tPlotName;
+      message.figureGroup = tFigureGroup;
+    }
+  }
+  if (!mIsRunning.load(std::memory_order_acquire)) {
+    // after the sink was stopped the message is written right away
+    std::lock_guard<std::mutex> lock(mSinkMutex);
+    string textBuffer;
+    FILE* textStream{};
+    Write(message, textBuffer, textStream);
+    if (textStream) {
+      std::fwrite(textBuffer.data(), 1, textBuffer.size(), textStream);
+      std::fflush(textStream);
+    }
+    return;
+  }
+  while (!TryPush(message)) {
+    mSinkCondition.notify_one();
+    std::this_thread::yield();
+  }
+  if (kind == error_message) Flush();
+}
+
+//**************************************************************************************************
+/**
+ * Waits until all messages queued so far are written.
+ */
+//**************************************************************************************************
+void Logger::Flush()
+{
+  uint64_t target = mEnqueuePos.load(std::memory_order_acquire);
+  while (mIsRunning.load(std::memory_order_acquire) && mWritten.load(std::memory_order_acquire) < target) {
+    mSinkCondition.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Multi-producer enqueue into the ring buffer (bounded queue based on per-slot sequence numbers).
+ */
+//**************************************************************************************************
+bool Logger::TryPush(message_t& message)
+{
+  uint64_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+  slot_t* slot;
+  while (true) {
+    slot = &mSlots[pos & (kCapacity - 1)];
+    uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+    if (difference == 0) {
+      if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (difference < 0) {
+      return false; // queue is full
+    } else {
+      pos = mEnqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  slot->message = std::move(message);
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Single-consumer dequeue from the ring buffer.
+ */
+//**************************************************************************************************
+bool Logger::TryPop(message_t& message)
+{
+  slot_t& slot = mSlots[mDequeuePos & (kCapacity - 1)];
+  if (slot.sequence.load(std::memory_order_acquire) != mDequeuePos + 1) return false;
+  message = std::move(slot.message);
+  slot.sequence.store(mDequeuePos + kCapacity, std::memory_order_release);
+  ++mDequeuePos;
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Writes all queued messages in one batch. Returns whether there were any.
+ */
+//**************************************************************************************************
+bool Logger::Drain()
+{
+  std::lock_guard<std::mutex> lock(mSinkMutex);
+  message_t message;
+  string textBuffer;
+  FILE* textStream{};
+  uint64_t nMessages{};
+  while (TryPop(message)) {
+    Write(message, textBuffer, textStream);
+    ++nMessages;
+  }
+  if (!nMessages) return false;
+  if (textStream) {
+    std::fwrite(textBuffer.data(), 1, textBuffer.size(), textStream);
+    std::fflush(textStream);
+  }
+  if (mJSONStream) std::fflush(mJSONStream);
+  mWritten.fetch_add(nMessages, std::memory_order_release);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Appends message to the buffer of the corresponding output stream (which is written whenever the
+ * stream changes to keep the order of messages) and to the JSON output.
+ */
+//**************************************************************************************************
+void Logger::Write(const message_t& message, string& textBuffer, FILE*& textStream)
+{
+  static const std::array<const char*, 7> prefixes{RED_ "[ ERR  ]" _END " ", YELLOW_ "[ WARN ]" _END " ", "[ INFO ] ", "       | ", "", GREEN_ "[ LOG  ]" _END " ", CYAN_ "[ DEBU ]" _END " "};
+  static const std::array<const char*, 5> levelNames{"error", "warning", "info", "log", "debug"};
+
+  FILE* stream = (message.kind == error_message || message.kind == warning_message || message.kind == debug_message) ? stderr : stdout;
+  if (textStream && stream != textStream && !textBuffer.empty()) {
+    std::fwrite(textBuffer.data(), 1, textBuffer.size(), textStream);
+    std::fflush(textStream);
+    textBuffer.clear();
+  }
+  textStream = stream;
+  textBuffer += prefixes[message.kind];
+  textBuffer += message.text;
+  if (message.kind != print_inline_message) textBuffer += '\n';
+
+  if (!mJSONStream) return;
+  auto escape = [](const string& str) {
+    string escaped;
+    for (size_t i = 0; i < str.size(); ++i) {
+      char c = str[i];
+      if (c == '\033') {
+        // skip ANSI color codes
+        while (i < str.size() && str[i] != 'm') ++i;
+      } else if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        escaped += fmt::format("\\u{:04x}", static_cast<int32_t>(c));
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  };
+  string module;
+  {
+    std::lock_guard<std::mutex> lock(mModuleMutex);
+    if (message.module < mModuleNames.size()) module = mModuleNames[message.module];
+  }
+  fmt::print(mJSONStream, R"({{"time": {}, "level": "{}", "module": "{}", "plot": "{}", "group": "{}", "message": "{}"}})"
+                          "\n",
+             message.time, levelNames[GetLevel(message.kind)], module, escape(message.plotName), escape(message.figureGroup), escape(message.text));
+}
+
+} // end namespace PlottingFramework
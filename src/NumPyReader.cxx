@@ -0,0 +1,480 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "NumPyReader.h"
+#include "Logging.h"
+
+// std dependencies
+#include <cstring>
+#include <filesystem>
+
+// zlib dependencies
+#include <zlib.h>
+
+// root dependencies
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TGraphErrors.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Read little-endian integer at offset.
+ */
+//**************************************************************************************************
+template <typename T>
+static T read_le(std::string_view content, size_t offset)
+{
+  T value{};
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<uint8_t>(content[offset + i])) << (8 * i);
+  }
+  return value;
+}
+
+//**************************************************************************************************
+/**
+ * Check if file is a numpy array or archive of arrays.
+ */
+//**************************************************************************************************
+bool NumPyReader::IsNumPyFile(const string& fileName)
+{
+  auto extension = std::filesystem::path(fileName).extension();
+  return extension == ".npy" || extension == ".npz";
+}
+
+//**************************************************************************************************
+/**
+ * Read the required data from the file.
+ */
+//**************************************************************************************************
+bool NumPyReader::Read(const string& fileName, const vector<string>& requiredNames)
+{
+  mObjects.clear();
+  mArrays.clear();
+  mInflatedMembers.clear();
+  mFiles.clear();
+  mSidecarFileNames.clear();
+
+  bool isArchive = (std::filesystem::path(fileName).extension() == ".npz");
+  string singleName = std::filesystem::path(fileName).stem().string();
+  if (!isArchive && std::find(requiredNames.begin(), requiredNames.end(), singleName) == requiredNames.end()) return true;
+
+  auto& file = mFiles.emplace_back(std::make_unique<TextFile>());
+  if (!file->Open(fileName)) return false;
+  if (isArchive) {
+    if (!ReadArchive(file->GetContent(), fileName, requiredNames)) return false;
+  } else {
+    if (!AddArray(singleName, file->GetContent(), fileName)) return false;
+    for (string role : {"edges", "xedges", "yedges", "range", "xrange", "yrange", "errors"}) {
+      string sidecarName = fileName.substr(0, fileName.size() - 4) + "." + role + ".npy";
+      if (!std::filesystem::exists(sidecarName)) continue;
+      mSidecarFileNames.push_back(sidecarName);
+      auto& sidecar = mFiles.emplace_back(std::make_unique<TextFile>());
+      if (!sidecar->Open(sidecarName) || !AddArray(singleName + "/" + role, sidecar->GetContent(), sidecarName)) return false;
+    }
+  }
+
+  for (auto& name : requiredNames) {
+    if (auto object = CreateObject(name, fileName)) mObjects[name] = std::move(object);
+  }
+  mArrays.clear();
+  mInflatedMembers.clear();
+  mFiles.clear();
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Parse header of npy array and add it to the available arrays.
+ */
+//**************************************************************************************************
+bool NumPyReader::AddArray(const string& name, std::string_view content, const string& fileName)
+{
+  // "\x93NUMPY", major version, minor version, header length, header (python dict literal), data
+  constexpr std::string_view magic = "\x93NUMPY";
+  if (content.size() < 10 || content.substr(0, magic.size()) != magic) {
+    ERROR("Array {} in {} is not in npy format.", name, fileName);
+    return false;
+  }
+  bool isVersion1 = (content[6] == 1);
+  size_t headerStart = (isVersion1) ? 10u : 12u;
+  size_t headerLength = (isVersion1) ? read_le<uint16_t>(content, 8) : read_le<uint32_t>(content, 8);
+  if (content.size() < headerStart + headerLength) {
+    ERROR("Header of array {} in {} is truncated.", name, fileName);
+    return false;
+  }
+  // e.g. "{'descr': '<f8', 'fortran_order': False, 'shape': (1000, 3), }"
+  std::string_view header = content.substr(headerStart, headerLength);
+  auto getValue = [&](std::string_view key) -> std::string_view {
+    size_t position = header.find(key);
+    if (position == std::string_view::npos) return {};
+    position = header.find(':', position + key.size());
+    if (position == std::string_view::npos) return {};
+    return trim_blanks(header.substr(position + 1));
+  };
+
+  array_t array;
+  std::string_view descr = getValue("'descr'");
+  if (descr.size() < 5 || descr.front() != '\'' || descr.find('\'', 1) != 4) {
+    ERROR("Array {} in {} has unsupported data type.", name, fileName);
+    return false;
+  }
+  array.isSwapped = (descr[1] == '>');
+  array.type = descr[2];
+  array.itemSize = descr[3] - '0';
+  bool isSupported = (array.type == 'f' && (array.itemSize == 4 || array.itemSize == 8)) ||
+                     ((array.type == 'i' || array.type == 'u') && (array.itemSize == 1 || array.itemSize == 2 || array.itemSize == 4 || array.itemSize == 8)) ||
+                     (array.type == 'b' && array.itemSize == 1);
+  if (!isSupported) {
+    ERROR("Array {} in {} has unsupported data type {}.", name, fileName, descr.substr(1, 3));
+    return false;
+  }
+  bool isFortranOrder = (getValue("'fortran_order'").compare(0, 4, "True") == 0);
+  std::string_view shape = getValue("'shape'");
+  if (shape.empty() || shape.front() != '(' || shape.find(')') == std::string_view::npos) {
+    ERROR("Array {} in {} has invalid shape.", name, fileName);
+    return false;
+  }
+  shape = shape.substr(1, shape.find(')') - 1);
+  while (!trim_blanks(shape).empty()) {
+    size_t end = shape.find(',');
+    std::string_view dimension = trim_blanks(shape.substr(0, end));
+    size_t length{};
+    auto [ptr, error] = std::from_chars(dimension.data(), dimension.data() + dimension.size(), length);
+    if (error != std::errc() || ptr != dimension.data() + dimension.size()) {
+      ERROR("Array {} in {} has invalid shape.", name, fileName);
+      return false;
+    }
+    array.shape.push_back(length);
+    shape.remove_prefix((end == std::string_view::npos) ? shape.size() : end + 1);
+  }
+
+  size_t nDimensions = array.shape.size();
+  size_t nElements = 1;
+  array.strides.resize(nDimensions);
+  for (size_t i = 0; i < nDimensions; ++i) {
+    size_t dimension = (isFortranOrder) ? i : nDimensions - 1 - i;
+    array.strides[dimension] = nElements;
+    nElements *= array.shape[dimension];
+  }
+  size_t dataStart = headerStart + headerLength;
+  if (content.size() < dataStart + nElements * array.itemSize) {
+    ERROR("Data of array {} in {} is truncated.", name, fileName);
+    return false;
+  }
+  array.data = content.substr(dataStart, nElements * array.itemSize);
+  mArrays[name] = std::move(array);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Add the arrays belonging to the required data from a npz archive (zip file with npy members).
+ */
+//**************************************************************************************************
+bool NumPyReader::ReadArchive(std::string_view content, const string& fileName, const vector<string>& requiredNames)
+{
+  auto invalidArchive = [&]() {
+    ERROR("{} is not a valid npz archive.", fileName);
+    return false;
+  };
+  // end of central directory record
+  constexpr size_t endRecordSize = 22;
+  size_t endRecord = content.rfind(std::string_view("PK\x05\x06", 4));
+  if (endRecord == std::string_view::npos || endRecord + endRecordSize > content.size()) return invalidArchive();
+  uint64_t nEntries = read_le<uint16_t>(content, endRecord + 10);
+  uint64_t directoryOffset = read_le<uint32_t>(content, endRecord + 16);
+  if (nEntries == 0xFFFF || directoryOffset == 0xFFFFFFFF) {
+    // zip64 end of central directory record, referenced by the locator in front of the regular record
+    if (endRecord < 20 || content.substr(endRecord - 20, 4) != std::string_view("PK\x06\x07", 4)) return invalidArchive();
+    uint64_t endRecord64 = read_le<uint64_t>(content, endRecord - 20 + 8);
+    if (endRecord64 + 56 > content.size() || content.substr(endRecord64, 4) != std::string_view("PK\x06\x06", 4)) return invalidArchive();
+    nEntries = read_le<uint64_t>(content, endRecord64 + 32);
+    directoryOffset = read_le<uint64_t>(content, endRecord64 + 48);
+  }
+
+  size_t position = directoryOffset;
+  for (uint64_t entry = 0; entry < nEntries; ++entry) {
+    if (position + 46 > content.size() || content.substr(position, 4) != std::string_view("PK\x01\x02", 4)) return invalidArchive();
+    uint16_t method = read_le<uint16_t>(content, position + 10);
+    uint64_t compressedSize = read_le<uint32_t>(content, position + 20);
+    uint64_t size = read_le<uint32_t>(content, position + 24);
+    uint16_t nameLength = read_le<uint16_t>(content, position + 28);
+    uint16_t extraLength = read_le<uint16_t>(content, position + 30);
+    uint16_t commentLength = read_le<uint16_t>(content, position + 32);
+    uint64_t localOffset = read_le<uint32_t>(content, position + 42);
+    if (position + 46 + nameLength + extraLength > content.size()) return invalidArchive();
+    string memberName(content.substr(position + 46, nameLength));
+    // zip64 extended information (only contains the fields that do not fit in the regular record)
+    std::string_view extra = content.substr(position + 46 + nameLength, extraLength);
+    for (size_t field = 0; field + 4 <= extra.size(); field += 4 + read_le<uint16_t>(extra, field + 2)) {
+      if (read_le<uint16_t>(extra, field) != 1) continue;
+      size_t fieldEnd = std::min<size_t>(extra.size(), field + 4 + read_le<uint16_t>(extra, field + 2));
+      size_t value = field + 4;
+      for (uint64_t* target : {&size, &compressedSize, &localOffset}) {
+        if (*target != 0xFFFFFFFF || value + 8 > fieldEnd) continue;
+        *target = read_le<uint64_t>(extra, value);
+        value += 8;
+      }
+    }
+    position += 46 + nameLength + extraLength + commentLength;
+
+    // members are called "<array name>.npy"
+    if (memberName.size() < 4 || memberName.compare(memberName.size() - 4, 4, ".npy") != 0) continue;
+    memberName.resize(memberName.size() - 4);
+    bool isRequired = std::any_of(requiredNames.begin(), requiredNames.end(), [&](const string& name) { return memberName == name || memberName.compare(0, name.size() + 1, name + "/") == 0; });
+    if (!isRequired) continue;
+
+    if (localOffset + 30 > content.size() || content.substr(localOffset, 4) != std::string_view("PK\x03\x04", 4)) return invalidArchive();
+    size_t dataOffset = localOffset + 30 + read_le<uint16_t>(content, localOffset + 26) + read_le<uint16_t>(content, localOffset + 28);
+    if (dataOffset + compressedSize > content.size()) return invalidArchive();
+    std::string_view member = content.substr(dataOffset, compressedSize);
+    if (method == 8) {
+      // members of archives created via numpy.savez_compressed are deflated
+      auto& buffer = mInflatedMembers.emplace_back(size);
+      z_stream stream{};
+      if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) return invalidArchive();
+      stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(member.data()));
+      stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+      constexpr size_t maxChunkSize = std::numeric_limits<uInt>::max();
+      int32_t status = Z_OK;
+      while (status == Z_OK) {
+        stream.avail_in = std::min<size_t>(member.size() - stream.total_in, maxChunkSize);
+        stream.avail_out = std::min<size_t>(size - stream.total_out, maxChunkSize);
+        status = inflate(&stream, Z_NO_FLUSH);
+      }
+      bool isComplete = (status == Z_STREAM_END && stream.total_out == size);
+      inflateEnd(&stream);
+      if (!isComplete) {
+        ERROR("Cannot decompress array {} in {}.", memberName, fileName);
+        return false;
+      }
+      member = {buffer.data(), buffer.size()};
+    } else if (method != 0) {
+      ERROR("Array {} in {} is compressed with unsupported method {}.", memberName, fileName, method);
+      return false;
+    }
+    if (!AddArray(memberName, member, fileName)) return false;
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Get array by name (nullptr if it does not exist).
+ */
+//**************************************************************************************************
+const NumPyReader::array_t* NumPyReader::GetArray(const string& name) const
+{
+  auto iterator = mArrays.find(name);
+  return (iterator != mArrays.end()) ? &iterator->second : nullptr;
+}
+
+//**************************************************************************************************
+/**
+ * Convert n elements of the array (starting at element offset, with the given stride) to double.
+ */
+//**************************************************************************************************
+void NumPyReader::CopyValues(const array_t& array, size_t offset, size_t stride, size_t n, double_t* output, size_t outputStride)
+{
+  const char* data = array.data.data() + offset * array.itemSize;
+  if (array.type == 'f' && array.itemSize == sizeof(double_t) && !array.isSwapped && stride == 1 && outputStride == 1) {
+    std::memcpy(output, data, n * sizeof(double_t));
+    return;
+  }
+  auto convert = [&](auto type) {
+    using T = decltype(type);
+    char bytes[sizeof(T)];
+    T value;
+    for (size_t i = 0; i < n; ++i) {
+      std::memcpy(bytes, data + i * stride * sizeof(T), sizeof(T));
+      if (array.isSwapped) std::reverse(bytes, bytes + sizeof(T));
+      std::memcpy(&value, bytes, sizeof(T));
+      output[i * outputStride] = static_cast<double_t>(value);
+    }
+  };
+  switch (array.type) {
+    case 'f':
+      (array.itemSize == 4) ? convert(float{}) : convert(double{});
+      break;
+    case 'i':
+      (array.itemSize == 1) ? convert(int8_t{}) : (array.itemSize == 2) ? convert(int16_t{}) : (array.itemSize == 4) ? convert(int32_t{}) : convert(int64_t{});
+      break;
+    default: // unsigned and bool
+      (array.itemSize == 1) ? convert(uint8_t{}) : (array.itemSize == 2) ? convert(uint16_t{}) : (array.itemSize == 4) ? convert(uint32_t{}) : convert(uint64_t{});
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Create graph or histogram from the arrays belonging to name.
+ */
+//**************************************************************************************************
+unique_ptr<TObject> NumPyReader::CreateObject(const string& name, const string& fileName) const
+{
+  const array_t* array = GetArray(name);
+  auto firstMember = mArrays.lower_bound(name + "/");
+  bool hasMembers = (firstMember != mArrays.end() && firstMember->first.compare(0, name.size() + 1, name + "/") == 0);
+  if (!array && !hasMembers) return nullptr;
+
+  if (const array_t* values = GetArray(name + "/values")) return CreateHistogram(name, *values, fileName);
+  for (auto role : {"/edges", "/xedges", "/range", "/xrange"}) {
+    if (array && GetArray(name + role)) return CreateHistogram(name, *array, fileName);
+  }
+
+  // graph with columns x, y, ex, ey
+  struct column_t {
+    const array_t* array;
+    size_t offset;
+    size_t stride;
+  };
+  optional<column_t> columns[4];
+  size_t nPoints{};
+  if (array) {
+    if (array->shape.size() != 2 || array->shape[1] < 2 || array->shape[1] > 4) {
+      ERROR("Array {} in {} must have shape (n, 2), (n, 3) or (n, 4) to be used as graph.", name, fileName);
+      return nullptr;
+    }
+    nPoints = array->shape[0];
+    size_t nColumns = array->shape[1];
+    for (size_t j = 0; j < nColumns; ++j) {
+      // columns x, y, ey or x, y, ex, ey
+      size_t target = (nColumns == 3 && j == 2) ? 3u : j;
+      columns[target] = column_t{array, j * array->strides[1], array->strides[0]};
+    }
+  } else {
+    const array_t* x = GetArray(name + "/x");
+    if (!x || !GetArray(name + "/y") || x->shape.size() != 1) {
+      ERROR("Arrays of {} in {} do not match any of the supported layouts.", name, fileName);
+      return nullptr;
+    }
+    nPoints = x->shape[0];
+    size_t j{};
+    for (auto role : {"/x", "/y", "/ex", "/ey"}) {
+      if (const array_t* column = GetArray(name + role)) {
+        if (column->shape.size() != 1 || column->shape[0] != nPoints) {
+          ERROR("Array {}{} in {} must be one-dimensional and of same length as {}/x.", name, role, fileName, name);
+          return nullptr;
+        }
+        columns[j] = column_t{column, 0, column->strides[0]};
+      }
+      ++j;
+    }
+  }
+
+  unique_ptr<TGraph> graph;
+  if (columns[2] || columns[3]) {
+    graph = std::make_unique<TGraphErrors>(nPoints);
+  } else {
+    graph = std::make_unique<TGraph>(nPoints);
+  }
+  double_t* targets[4] = {graph->GetX(), graph->GetY(), graph->GetEX(), graph->GetEY()};
+  for (size_t j = 0; j < 4; ++j) {
+    if (columns[j]) CopyValues(*columns[j]->array, columns[j]->offset, columns[j]->stride, nPoints, targets[j]);
+  }
+  graph->SetName(name.data());
+  return graph;
+}
+
+//**************************************************************************************************
+/**
+ * Create histogram with the given bin contents.
+ */
+//**************************************************************************************************
+unique_ptr<TObject> NumPyReader::CreateHistogram(const string& name, const array_t& values, const string& fileName) const
+{
+  size_t nDimensions = values.shape.size();
+  if (nDimensions != 1 && nDimensions != 2) {
+    ERROR("Values of histogram {} in {} must be one- or two-dimensional.", name, fileName);
+    return nullptr;
+  }
+  vector<double_t> axisEdges[2]; // only lower and upper edge in case of fixed binning
+  for (size_t axis = 0; axis < nDimensions; ++axis) {
+    size_t nBins = values.shape[axis];
+    string axisName = (axis == 0) ? "x" : "y";
+    const array_t* edges = GetArray(name + "/" + axisName + "edges");
+    const array_t* range = GetArray(name + "/" + axisName + "range");
+    if (nDimensions == 1 && !edges) edges = GetArray(name + "/edges");
+    if (nDimensions == 1 && !range) range = GetArray(name + "/range");
+    vector<double_t>& binEdges = axisEdges[axis];
+    if (edges && edges->shape.size() == 1 && edges->shape[0] == nBins + 1) {
+      binEdges.resize(nBins + 1);
+      CopyValues(*edges, 0, edges->strides[0], nBins + 1, binEdges.data());
+      double_t width = (binEdges.back() - binEdges.front()) / nBins;
+      bool isFixed = true;
+      for (size_t i = 1; i < nBins && isFixed; ++i) {
+        isFixed = std::abs(binEdges[i] - (binEdges.front() + i * width)) <= 1e-9 * std::abs(width);
+      }
+      if (isFixed) binEdges = {binEdges.front(), binEdges.back()};
+    } else if (range && range->shape.size() == 1 && range->shape[0] == 2) {
+      binEdges.resize(2);
+      CopyValues(*range, 0, range->strides[0], 2, binEdges.data());
+    } else {
+      ERROR("Binning of {} axis of histogram {} in {} is missing or does not match the shape of the values.", axisName, name, fileName);
+      return nullptr;
+    }
+    if (nBins == 0) {
+      ERROR("Histogram {} in {} has no bins.", name, fileName);
+      return nullptr;
+    }
+  }
+  const array_t* errors = GetArray(name + "/errors");
+  if (errors && errors->shape != values.shape) {
+    ERROR("Shape of {}/errors in {} does not match the values.", name, fileName);
+    return nullptr;
+  }
+
+  // root stores the bins (incl. under- and overflow) with x running fastest
+  auto copyBins = [&](const array_t& array, double_t* output) {
+    size_t nBinsX = values.shape[0];
+    size_t nBinsY = (nDimensions == 2) ? values.shape[1] : 1u;
+    size_t rowLength = (nDimensions == 2) ? nBinsX + 2 : 0u;
+    for (size_t iy = 0; iy < nBinsY; ++iy) {
+      size_t offset = (nDimensions == 2) ? iy * array.strides[1] : 0u;
+      CopyValues(array, offset, array.strides[0], nBinsX, output + (iy + 1) * rowLength + 1);
+    }
+  };
+  auto fill = [&](auto histo) -> unique_ptr<TObject> {
+    histo->SetDirectory(nullptr);
+    copyBins(values, histo->GetArray());
+    if (errors) {
+      histo->Sumw2();
+      double_t* sumw2 = histo->GetSumw2()->GetArray();
+      copyBins(*errors, sumw2);
+      for (int32_t bin = 0; bin < histo->GetSumw2N(); ++bin) sumw2[bin] *= sumw2[bin];
+    }
+    histo->ResetStats();
+    return histo;
+  };
+
+  auto [xEdges, yEdges] = std::tie(axisEdges[0], axisEdges[1]);
+  int32_t nBinsX = values.shape[0];
+  if (nDimensions == 1) {
+    if (xEdges.size() == 2) return fill(std::make_unique<TH1D>(name.data(), "", nBinsX, xEdges[0], xEdges[1]));
+    return fill(std::make_unique<TH1D>(name.data(), "", nBinsX, xEdges.data()));
+  }
+  int32_t nBinsY = values.shape[1];
+  if (xEdges.size() == 2 && yEdges.size() == 2) return fill(std::make_unique<TH2D>(name.data(), "", nBinsX, xEdges[0], xEdges[1], nBinsY, yEdges[0], yEdges[1]));
+  if (xEdges.size() == 2) return fill(std::make_unique<TH2D>(name.data(), "", nBinsX, xEdges[0], xEdges[1], nBinsY, yEdges.data()));
+  if (yEdges.size() == 2) return fill(std::make_unique<TH2D>(name.data(), "", nBinsX, xEdges.data(), nBinsY, yEdges[0], yEdges[1]));
+  return fill(std::make_unique<TH2D>(name.data(), "", nBinsX, xEdges.data(), nBinsY, yEdges.data()));
+}
+
+} // end namespace PlottingFramework
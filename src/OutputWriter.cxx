@@ -0,0 +1,251 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// framework dependencies
+#include "OutputWriter.h"
+#include "Logging.h"
+
+// std dependencies
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace PlottingFramework
+{
+namespace fs = std::filesystem;
+
+//**************************************************************************************************
+/**
+ * Constructor for OutputWriter. The writer threads are only started once the first file is committed.
+ */
+//**************************************************************************************************
+OutputWriter::OutputWriter(uint8_t nThreads) : mNumThreads((nThreads > 0) ? nThreads : 1)
+{
+}
+
+//**************************************************************************************************
+/**
+ * Destructor for OutputWriter. Waits until all queued files are written and removes the staging area.
+ */
+//**************************************************************************************************
+OutputWriter::~OutputWriter()
+{
+  Flush();
+  StopThreads();
+  if (!mStagingDirectory.empty()) {
+    std::error_code errorCode;
+    fs::remove_all(mStagingDirectory, errorCode);
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Defines how many files can be written in parallel.
+ */
+//**************************************************************************************************
+void OutputWriter::SetNumThreads(uint8_t nThreads)
+{
+  Flush();
+  StopThreads();
+  mNumThreads = (nThreads > 0) ? nThreads : 1;
+}
+
+//**************************************************************************************************
+/**
+ * Creates directory (including parents) and remembers it to avoid repeated file-system calls.
+ */
+//**************************************************************************************************
+bool OutputWriter::CreateDirectories(const string& path)
+{
+  std::lock_guard<std::mutex> lock(mDirectoryMutex);
+  if (mCreatedDirectories.find(path) != mCreatedDirectories.end()) return true;
+  std::error_code errorCode;
+  fs::create_directories(path, errorCode);
+  if (errorCode) return false;
+  mCreatedDirectories.insert(path);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Returns a unique local path where a file with the given name can be written before it is committed.
+ * Every file gets its own folder such that the file name itself (which e.g. determines the name of root macros) is kept.
+ */
+//**************************************************************************************************
+string OutputWriter::GetStagingPath(const string& fileName)
+{
+  std::error_code errorCode;
+  if (mStagingDirectory.empty()) {
+    // unique per writer, since several writers in the same process must not share (and remove) it
+    string directoryTemplate = (fs::temp_directory_path(errorCode) / ("PlottingFramework_" + std::to_string(::getpid()) + "_XXXXXX")).string();
+    if (errorCode || !mkdtemp(directoryTemplate.data())) return {};
+    mStagingDirectory = directoryTemplate;
+  }
+  fs::path stagingFolder = mStagingDirectory / std::to_string(mStagingCounter++);
+  fs::create_directories(stagingFolder, errorCode);
+  if (errorCode) return {};
+  return (stagingFolder / fileName).string();
+}
+
+//**************************************************************************************************
+/**
+ * Queues a staged file to be moved to its target location.
+ * A file that is still waiting for the same target is outdated and replaced by the new one.
+ */
+//**************************************************************************************************
+void OutputWriter::Commit(const string& stagingPath, const string& targetPath)
+{
+  if (mThreads.empty()) StartThreads();
+  string outdatedStagingPath;
+  {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    auto queued = std::find_if(mQueue.begin(), mQueue.end(), [&targetPath](const auto& job) { return job.second == targetPath; });
+    if (queued != mQueue.end()) {
+      outdatedStagingPath = std::exchange(queued->first, stagingPath);
+    } else {
+      mQueue.emplace_back(stagingPath, targetPath);
+      ++mPendingJobs;
+    }
+  }
+  mQueueCondition.notify_one();
+  if (!outdatedStagingPath.empty()) {
+    std::error_code errorCode;
+    fs::remove_all(fs::path(outdatedStagingPath).parent_path(), errorCode);
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Blocks until all queued files are written and reports the errors that occurred in the meantime.
+ */
+//**************************************************************************************************
+bool OutputWriter::Flush()
+{
+  vector<string> errors;
+  {
+    std::unique_lock<std::mutex> lock(mQueueMutex);
+    mIdleCondition.wait(lock, [this] { return mPendingJobs == 0; });
+    std::swap(errors, mErrors);
+  }
+  for (auto& error : errors) {
+    ERROR("{}", error);
+  }
+  return errors.empty();
+}
+
+//**************************************************************************************************
+/**
+ * Starts the writer threads.
+ */
+//**************************************************************************************************
+void OutputWriter::StartThreads()
+{
+  mStopThreads = false;
+  for (uint8_t i = 0; i < mNumThreads; ++i) {
+    mThreads.emplace_back(&OutputWriter::ProcessQueue, this);
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Stops the writer threads after the queue was processed.
+ */
+//**************************************************************************************************
+void OutputWriter::StopThreads()
+{
+  {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    mStopThreads = true;
+  }
+  mQueueCondition.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+  mThreads.clear();
+}
+
+//**************************************************************************************************
+/**
+ * Work loop of the writer threads. Files for the same target are written one after another in the order
+ * they were committed, such that an older file can never replace a newer one.
+ */
+//**************************************************************************************************
+void OutputWriter::ProcessQueue()
+{
+  while (true) {
+    std::pair<string, string> job;
+    {
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      auto nextJob = mQueue.end();
+      mQueueCondition.wait(lock, [this, &nextJob] {
+        nextJob = std::find_if(mQueue.begin(), mQueue.end(), [this](const auto& job) { return mActiveTargets.find(job.second) == mActiveTargets.end(); });
+        return nextJob != mQueue.end() || (mStopThreads && mQueue.empty());
+      });
+      if (nextJob == mQueue.end()) return;
+      job = std::move(*nextJob);
+      mQueue.erase(nextJob);
+      mActiveTargets.insert(job.second);
+    }
+    string error;
+    bool success = MoveToTarget(job.first, job.second, error);
+    {
+      std::lock_guard<std::mutex> lock(mQueueMutex);
+      if (!success) mErrors.push_back(std::move(error));
+      mActiveTargets.erase(job.second);
+      --mPendingJobs;
+    }
+    // jobs waiting for this target can now be picked up
+    mQueueCondition.notify_all();
+    mIdleCondition.notify_all();
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Moves staged file to its target. The target only ever appears as complete file.
+ */
+//**************************************************************************************************
+bool OutputWriter::MoveToTarget(const string& stagingPath, const string& targetPath, string& error)
+{
+  fs::path target{targetPath};
+  if (!CreateDirectories(target.parent_path().string())) {
+    error = fmt::format("Could not create output directory {}.", target.parent_path().string());
+    return false;
+  }
+  std::error_code errorCode;
+  if (!fs::exists(stagingPath, errorCode)) {
+    error = fmt::format("Could not write {}.", targetPath);
+    return false;
+  }
+  // within one file system a rename is sufficient, otherwise copy to temporary file next to the target first
+  fs::rename(stagingPath, target, errorCode);
+  if (errorCode) {
+    fs::path tempTarget = target.parent_path() / ("." + target.filename().string() + ".part" + std::to_string(std::hash<string>{}(stagingPath)));
+    fs::copy_file(stagingPath, tempTarget, fs::copy_options::overwrite_existing, errorCode);
+    if (!errorCode) fs::rename(tempTarget, target, errorCode);
+    if (errorCode) {
+      error = fmt::format("Could not write {} ({}).", targetPath, errorCode.message());
+      fs::remove(tempTarget, errorCode);
+      return false;
+    }
+    fs::remove(stagingPath, errorCode);
+  }
+  fs::remove(fs::path(stagingPath).parent_path(), errorCode);
+  return true;
+}
+
+} // end namespace PlottingFramework
@@ -17,6 +17,7 @@
 
 #include "Plot.h"
 #include "Helpers.h"
+#include "PropertyTable.h"
 #include "Logging.h"
 
 namespace PlottingFramework
@@ -51,6 +52,60 @@ Plot::Plot(const string& name, const string& figureGroupAndCategory, const optio
   UpdateUniqueName();
 }
 
+//**************************************************************************************************
+/**
+ * Copy constructor. The copy does not share any pads, data or boxes with the original, such that
+ * references obtained from the original (e.g. via operator[]) never modify the copy.
+ */
+//**************************************************************************************************
+Plot::Plot(const Plot& otherPlot) : Plot(otherPlot, shared_copy_t{})
+{
+  for (auto& [padID, pad] : mPads.Mutable()) {
+    for (auto& data : pad.GetData()) data.Mutable();
+    for (auto& legendBox : pad.GetLegendBoxes()) legendBox.Mutable();
+    for (auto& textBox : pad.GetTextBoxes()) textBox.Mutable();
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Copy assignment, which does not share any pads, data or boxes with the original.
+ */
+//**************************************************************************************************
+Plot& Plot::operator=(const Plot& otherPlot)
+{
+  if (this != &otherPlot) *this = Plot(otherPlot);
+  return *this;
+}
+
+//**************************************************************************************************
+/**
+ * Copy that shares all pads, data and boxes with the original until either of them is modified.
+ * Only used internally, where no references to the contents of the original are kept.
+ */
+//**************************************************************************************************
+Plot::Plot(const Plot& otherPlot, shared_copy_t)
+  : mName(otherPlot.mName),
+    mFigureGroup(otherPlot.mFigureGroup),
+    mFigureCategory(otherPlot.mFigureCategory),
+    mUniqueName(otherPlot.mUniqueName),
+    mPlotTemplateName(otherPlot.mPlotTemplateName),
+    mPlotDimensions(otherPlot.mPlotDimensions),
+    mFill(otherPlot.mFill),
+    mPads(otherPlot.mPads)
+{
+}
+
+//**************************************************************************************************
+/**
+ * Copy sharing all contents with the original (for internal use only).
+ */
+//**************************************************************************************************
+Plot Plot::SharedCopy() const
+{
+  return Plot(*this, shared_copy_t{});
+}
+
 //**************************************************************************************************
 /**
  * Constructor from existing plot.
@@ -65,6 +120,25 @@ Plot::Plot(const Plot& otherPlot, const string& name, const string& figureGroup,
   UpdateUniqueName();
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the plot as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::GetPropertyTable()
+{
+  using kind = property_kind;
+  return property_table(
+    property<kind::manual>("figure_category", &Plot::mFigureCategory),
+    property<kind::manual>("plot_template_name", &Plot::mPlotTemplateName),
+    property("width", &Plot::mPlotDimensions, &dimension_t::width),
+    property("height", &Plot::mPlotDimensions, &dimension_t::height),
+    property("fix_aspect_ratio", &Plot::mPlotDimensions, &dimension_t::fixAspectRatio),
+    property("fill_color", &Plot::mFill, &layout_t::color),
+    property("fill_style", &Plot::mFill, &layout_t::style),
+    property("fill_opacity", &Plot::mFill, &layout_t::scale));
+}
+
 //**************************************************************************************************
 /**
  * Constructor from property tree.
@@ -79,20 +153,13 @@ Plot::Plot(const ptree& plotTree)
     ERROR("Could not construct data from ptree.");
     std::exit(EXIT_FAILURE);
   }
-  read_from_tree(plotTree, mFigureCategory, "figure_category");
-  read_from_tree(plotTree, mPlotTemplateName, "plot_template_name");
-  read_from_tree(plotTree, mPlotDimensions.width, "width");
-  read_from_tree(plotTree, mPlotDimensions.height, "height");
-  read_from_tree(plotTree, mPlotDimensions.fixAspectRatio, "fix_aspect_ratio");
-  read_from_tree(plotTree, mFill.color, "fill_color");
-  read_from_tree(plotTree, mFill.style, "fill_style");
-  read_from_tree(plotTree, mFill.scale, "fill_opacity");
+  read_properties(plotTree, *this, GetPropertyTable());
 
   // loop over all pads defined in property tree
   for (auto& pad : plotTree) {
     if (str_contains(pad.first, "PAD")) {
       uint8_t padID = std::stoi(pad.first.substr(pad.first.find("_") + 1));
-      mPads[padID] = Pad(pad.second);
+      mPads.Mutable()[padID] = Pad(pad.second);
     }
   }
   UpdateUniqueName();
@@ -105,7 +172,7 @@ Plot::Plot(const ptree& plotTree)
 //**************************************************************************************************
 void Plot::UpdateUniqueName()
 {
-  mUniqueName = mName + gNameGroupSeparator + mFigureGroup + ((mFigureCategory) ? "/" + *mFigureCategory : "");
+  mUniqueName = mName.str() + gNameGroupSeparator + mFigureGroup.str() + ((mFigureCategory) ? "/" + *mFigureCategory : "");
 }
 
 //**************************************************************************************************
@@ -116,18 +183,11 @@ void Plot::UpdateUniqueName()
 ptree Plot::GetPropertyTree() const
 {
   ptree plotTree;
-  plotTree.put("name", mName);
-  plotTree.put("figure_group", mFigureGroup);
-  put_in_tree(plotTree, mFigureCategory, "figure_category");
-  put_in_tree(plotTree, mPlotTemplateName, "plot_template_name");
-  put_in_tree(plotTree, mPlotDimensions.width, "width");
-  put_in_tree(plotTree, mPlotDimensions.height, "height");
-  put_in_tree(plotTree, mPlotDimensions.fixAspectRatio, "fix_aspect_ratio");
-  put_in_tree(plotTree, mFill.color, "fill_color");
-  put_in_tree(plotTree, mFill.style, "fill_style");
-  put_in_tree(plotTree, mFill.scale, "fill_opacity");
-
-  for (auto& [padID, pad] : mPads) {
+  plotTree.put("name", mName.str());
+  plotTree.put("figure_group", mFigureGroup.str());
+  write_properties(plotTree, *this, GetPropertyTable());
+
+  for (auto& [padID, pad] : *mPads) {
     plotTree.put_child("PAD_" + std::to_string(padID), pad.GetPropertyTree());
   }
   return plotTree;
@@ -135,27 +195,12 @@ ptree Plot::GetPropertyTree() const
 
 //**************************************************************************************************
 /**
- * Make a deep copy of the Plot where also data and boxes are copied.
+ * Make a deep copy of the Plot where also data and boxes are copied (same as a plain copy).
  */
 //**************************************************************************************************
 Plot Plot::Clone() const
 {
-  Plot newPlot(*this);
-  for (auto& [padID, pad] : newPlot.GetPads()) {
-    std::transform(newPlot[padID].GetData().begin(), newPlot[padID].GetData().end(),
-                   newPlot[padID].GetData().begin(),
-                   [](auto& data_ptr) { return data_ptr->Clone(); });
-
-    std::transform(newPlot[padID].GetLegendBoxes().begin(), newPlot[padID].GetLegendBoxes().end(),
-                   newPlot[padID].GetLegendBoxes().begin(), [](auto& legend_ptr) {
-                     return std::make_shared<Plot::Pad::LegendBox>(*legend_ptr);
-                   });
-
-    std::transform(newPlot[padID].GetTextBoxes().begin(), newPlot[padID].GetTextBoxes().end(),
-                   newPlot[padID].GetTextBoxes().begin(),
-                   [](auto& text_ptr) { return std::make_shared<Plot::Pad::TextBox>(*text_ptr); });
-  }
-  return newPlot;
+  return Plot(*this);
 }
 
 //**************************************************************************************************
@@ -166,7 +211,7 @@ Plot Plot::Clone() const
 uint8_t Plot::GetDataCount() const
 {
   uint8_t count{};
-  for (auto& [padID, pad] : mPads) {
+  for (auto& [padID, pad] : *mPads) {
     count += pad.GetDataCount();
   }
   return count;
@@ -266,18 +311,12 @@ void Plot::operator+=(const Plot& plot)
   mFigureCategory = plot.mFigureCategory;
   if (plot.mFigureCategory) mFigureCategory = plot.mFigureCategory;
   mPlotTemplateName = plot.mPlotTemplateName;
+  merge_properties(plot, *this, GetPropertyTable());
 
-  if (plot.mPlotDimensions.width) mPlotDimensions.width = plot.mPlotDimensions.width;
-  if (plot.mPlotDimensions.height) mPlotDimensions.height = plot.mPlotDimensions.height;
-  if (plot.mPlotDimensions.fixAspectRatio) mPlotDimensions.fixAspectRatio = plot.mPlotDimensions.fixAspectRatio;
-
-  if (plot.mFill.color) mFill.color = plot.mFill.color;
-  if (plot.mFill.style) mFill.style = plot.mFill.style;
-  if (plot.mFill.scale) mFill.scale = plot.mFill.scale;
-
-  for (auto& [padID, pad] : plot.mPads) {
-    mPads[padID]; // initializes the pad in case it was not yet defined in this plot
-    mPads[padID] += pad;
+  auto& pads = mPads.Mutable();
+  for (auto& [padID, pad] : *plot.mPads) {
+    pads[padID]; // initializes the pad in case it was not yet defined in this plot
+    pads[padID] += pad;
   }
   UpdateUniqueName();
 }
@@ -289,7 +328,7 @@ void Plot::operator+=(const Plot& plot)
 //**************************************************************************************************
 Plot operator+(const Plot& templatePlot, const Plot& plot)
 {
-  Plot combinedPlot = templatePlot;
+  Plot combinedPlot = templatePlot.SharedCopy();
   combinedPlot += plot;
   return combinedPlot;
 }
@@ -702,6 +741,64 @@ auto Plot::Pad::SetMargins(float_t top, float_t bottom, float_t left, float_t ri
   return *this;
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the pad as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::Pad::GetPropertyTable()
+{
+  using kind = property_kind;
+  return property_table(
+    property("options", &Pad::mOptions),
+    property("position_xlow", &Pad::mPosition, &pad_position_t::xlow),
+    property("position_ylow", &Pad::mPosition, &pad_position_t::ylow),
+    property("position_xup", &Pad::mPosition, &pad_position_t::xup),
+    property("position_yup", &Pad::mPosition, &pad_position_t::yup),
+    property("margins_top", &Pad::mMargins, &pad_margin_t::top),
+    property("margins_bottom", &Pad::mMargins, &pad_margin_t::bottom),
+    property("margins_left", &Pad::mMargins, &pad_margin_t::left),
+    property("margins_right", &Pad::mMargins, &pad_margin_t::right),
+    property("palette", &Pad::mPalette),
+    property("fill_color", &Pad::mFill, &layout_t::color),
+    property("fill_style", &Pad::mFill, &layout_t::style),
+    property("fill_opacity", &Pad::mFill, &layout_t::scale),
+    property("frame_fill_color", &Pad::mFrameFill, &layout_t::color),
+    property("frame_fill_style", &Pad::mFrameFill, &layout_t::style),
+    property("frame_fill_opacity", &Pad::mFrameFill, &layout_t::scale),
+    property("frame_border_color", &Pad::mFrameBorder, &layout_t::color),
+    property("frame_border_style", &Pad::mFrameBorder, &layout_t::style),
+    property("frame_border_width", &Pad::mFrameBorder, &layout_t::scale),
+    property("text_font", &Pad::mText, &layout_t::style),
+    property("text_color", &Pad::mText, &layout_t::color),
+    property("text_size", &Pad::mText, &layout_t::scale),
+    property("default_marker_size", &Pad::mMarkerDefaults, &view_defaults_t::scale),
+    property("default_marker_styles", &Pad::mMarkerDefaults, &view_defaults_t::styles),
+    property<kind::manual>("default_marker_colors", &Pad::mMarkerDefaults, &view_defaults_t::colors),
+    property<kind::manual>("default_marker_colors_gradient_endpoints", &Pad::mMarkerDefaults, &view_defaults_t::colorGradient, &gradient_color_t::rgbEndpoints),
+    property<kind::manual>("default_marker_colors_gradient_alpha", &Pad::mMarkerDefaults, &view_defaults_t::colorGradient, &gradient_color_t::alpha),
+    property<kind::manual>("default_marker_colors_gradient_nColors", &Pad::mMarkerDefaults, &view_defaults_t::colorGradient, &gradient_color_t::nColors),
+    property("default_line_width", &Pad::mLineDefaults, &view_defaults_t::scale),
+    property("default_line_styles", &Pad::mLineDefaults, &view_defaults_t::styles),
+    property<kind::manual>("default_line_colors", &Pad::mLineDefaults, &view_defaults_t::colors),
+    property<kind::manual>("default_line_colors_gradient_endpoints", &Pad::mLineDefaults, &view_defaults_t::colorGradient, &gradient_color_t::rgbEndpoints),
+    property<kind::manual>("default_line_colors_gradient_alpha", &Pad::mLineDefaults, &view_defaults_t::colorGradient, &gradient_color_t::alpha),
+    property<kind::manual>("default_line_colors_gradient_nColors", &Pad::mLineDefaults, &view_defaults_t::colorGradient, &gradient_color_t::nColors),
+    property("default_fill_opacity", &Pad::mFillDefaults, &view_defaults_t::scale),
+    property("default_fill_styles", &Pad::mFillDefaults, &view_defaults_t::styles),
+    property<kind::manual>("default_fill_colors", &Pad::mFillDefaults, &view_defaults_t::colors),
+    property<kind::manual>("default_fill_colors_gradient_endpoints", &Pad::mFillDefaults, &view_defaults_t::colorGradient, &gradient_color_t::rgbEndpoints),
+    property<kind::manual>("default_fill_colors_gradient_alpha", &Pad::mFillDefaults, &view_defaults_t::colorGradient, &gradient_color_t::alpha),
+    property<kind::manual>("default_fill_colors_gradient_nColors", &Pad::mFillDefaults, &view_defaults_t::colorGradient, &gradient_color_t::nColors),
+    property("default_drawing_option_graph", &Pad::mDrawingOptionDefaults, &data_defaults_t::graph),
+    property("default_drawing_option_hist", &Pad::mDrawingOptionDefaults, &data_defaults_t::hist),
+    property("default_drawing_option_hist2d", &Pad::mDrawingOptionDefaults, &data_defaults_t::hist2d),
+    property("default_candle_option_boxrange", &Pad::mCandleOptionDefaults, &candle_defaults_t::boxRange),
+    property("default_candle_option_whiskerrange", &Pad::mCandleOptionDefaults, &candle_defaults_t::whiskerRange),
+    property("redraw_axes", &Pad::mRedrawAxes),
+    property("ref_func", &Pad::mRefFunc));
+}
+
 //**************************************************************************************************
 /**
  * Constructor from property tree.
@@ -709,53 +806,7 @@ auto Plot::Pad::SetMargins(float_t top, float_t bottom, float_t left, float_t ri
 //**************************************************************************************************
 Plot::Pad::Pad(const ptree& padTree)
 {
-  read_from_tree(padTree, mOptions, "options");
-  read_from_tree(padTree, mPosition.xlow, "position_xlow");
-  read_from_tree(padTree, mPosition.ylow, "position_ylow");
-  read_from_tree(padTree, mPosition.xup, "position_xup");
-  read_from_tree(padTree, mPosition.yup, "position_yup");
-  read_from_tree(padTree, mMargins.top, "margins_top");
-  read_from_tree(padTree, mMargins.bottom, "margins_bottom");
-  read_from_tree(padTree, mMargins.left, "margins_left");
-  read_from_tree(padTree, mMargins.right, "margins_right");
-  read_from_tree(padTree, mPalette, "palette");
-  read_from_tree(padTree, mFill.color, "fill_color");
-  read_from_tree(padTree, mFill.style, "fill_style");
-  read_from_tree(padTree, mFill.scale, "fill_opacity");
-  read_from_tree(padTree, mFrameFill.color, "frame_fill_color");
-  read_from_tree(padTree, mFrameFill.style, "frame_fill_style");
-  read_from_tree(padTree, mFrameFill.scale, "frame_fill_opacity");
-  read_from_tree(padTree, mFrameBorder.color, "frame_border_color");
-  read_from_tree(padTree, mFrameBorder.style, "frame_border_style");
-  read_from_tree(padTree, mFrameBorder.scale, "frame_border_width");
-  read_from_tree(padTree, mText.style, "text_font");
-  read_from_tree(padTree, mText.color, "text_color");
-  read_from_tree(padTree, mText.scale, "text_size");
-  read_from_tree(padTree, mMarkerDefaults.scale, "default_marker_size");
-  read_from_tree(padTree, mMarkerDefaults.styles, "default_marker_styles");
-  read_from_tree(padTree, mMarkerDefaults.colors, "default_marker_colors");
-  read_from_tree(padTree, mMarkerDefaults.colorGradient.rgbEndpoints, "default_marker_colors_gradient_endpoints");
-  read_from_tree(padTree, mMarkerDefaults.colorGradient.alpha, "default_marker_colors_gradient_alpha");
-  read_from_tree(padTree, mMarkerDefaults.colorGradient.nColors, "default_marker_colors_gradient_nColors");
-  read_from_tree(padTree, mLineDefaults.scale, "default_line_width");
-  read_from_tree(padTree, mLineDefaults.styles, "default_line_styles");
-  read_from_tree(padTree, mLineDefaults.colors, "default_line_colors");
-  read_from_tree(padTree, mLineDefaults.colorGradient.rgbEndpoints, "default_line_colors_gradient_endpoints");
-  read_from_tree(padTree, mLineDefaults.colorGradient.alpha, "default_line_colors_gradient_alpha");
-  read_from_tree(padTree, mLineDefaults.colorGradient.nColors, "default_line_colors_gradient_nColors");
-  read_from_tree(padTree, mFillDefaults.scale, "default_fill_opacity");
-  read_from_tree(padTree, mFillDefaults.styles, "default_fill_styles");
-  read_from_tree(padTree, mFillDefaults.colors, "default_fill_colors");
-  read_from_tree(padTree, mFillDefaults.colorGradient.rgbEndpoints, "default_fill_colors_gradient_endpoints");
-  read_from_tree(padTree, mFillDefaults.colorGradient.alpha, "default_fill_colors_gradient_alpha");
-  read_from_tree(padTree, mFillDefaults.colorGradient.nColors, "default_fill_colors_gradient_nColors");
-  read_from_tree(padTree, mDrawingOptionDefaults.graph, "default_drawing_option_graph");
-  read_from_tree(padTree, mDrawingOptionDefaults.hist, "default_drawing_option_hist");
-  read_from_tree(padTree, mDrawingOptionDefaults.hist2d, "default_drawing_option_hist2d");
-  read_from_tree(padTree, mCandleOptionDefaults.boxRange, "default_candle_option_boxrange");
-  read_from_tree(padTree, mCandleOptionDefaults.whiskerRange, "default_candle_option_whiskerrange");
-  read_from_tree(padTree, mRedrawAxes, "redraw_axes");
-  read_from_tree(padTree, mRefFunc, "ref_func");
+  read_properties(padTree, *this, GetPropertyTable());
 
   for (auto& content : padTree) {
     // add data
@@ -792,53 +843,7 @@ ptree Plot::Pad::GetPropertyTree() const
 {
   // convert properties of plot to ptree
   ptree padTree;
-  put_in_tree(padTree, mOptions, "options");
-  put_in_tree(padTree, mPosition.xlow, "position_xlow");
-  put_in_tree(padTree, mPosition.ylow, "position_ylow");
-  put_in_tree(padTree, mPosition.xup, "position_xup");
-  put_in_tree(padTree, mPosition.yup, "position_yup");
-  put_in_tree(padTree, mMargins.top, "margins_top");
-  put_in_tree(padTree, mMargins.bottom, "margins_bottom");
-  put_in_tree(padTree, mMargins.left, "margins_left");
-  put_in_tree(padTree, mMargins.right, "margins_right");
-  put_in_tree(padTree, mPalette, "palette");
-  put_in_tree(padTree, mFill.color, "fill_color");
-  put_in_tree(padTree, mFill.style, "fill_style");
-  put_in_tree(padTree, mFill.scale, "fill_opacity");
-  put_in_tree(padTree, mFrameFill.color, "frame_fill_color");
-  put_in_tree(padTree, mFrameFill.style, "frame_fill_style");
-  put_in_tree(padTree, mFrameFill.scale, "frame_fill_opacity");
-  put_in_tree(padTree, mFrameBorder.color, "frame_border_color");
-  put_in_tree(padTree, mFrameBorder.style, "frame_border_style");
-  put_in_tree(padTree, mFrameBorder.scale, "frame_border_width");
-  put_in_tree(padTree, mText.style, "text_font");
-  put_in_tree(padTree, mText.color, "text_color");
-  put_in_tree(padTree, mText.scale, "text_size");
-  put_in_tree(padTree, mMarkerDefaults.scale, "default_marker_size");
-  put_in_tree(padTree, mMarkerDefaults.styles, "default_marker_styles");
-  put_in_tree(padTree, mMarkerDefaults.colors, "default_marker_colors");
-  put_in_tree(padTree, mMarkerDefaults.colorGradient.rgbEndpoints, "default_marker_colors_gradient_endpoints");
-  put_in_tree(padTree, mMarkerDefaults.colorGradient.alpha, "default_marker_colors_gradient_alpha");
-  put_in_tree(padTree, mMarkerDefaults.colorGradient.nColors, "default_marker_colors_gradient_nColors");
-  put_in_tree(padTree, mLineDefaults.scale, "default_line_width");
-  put_in_tree(padTree, mLineDefaults.styles, "default_line_styles");
-  put_in_tree(padTree, mLineDefaults.colors, "default_line_colors");
-  put_in_tree(padTree, mLineDefaults.colorGradient.rgbEndpoints, "default_line_colors_gradient_endpoints");
-  put_in_tree(padTree, mLineDefaults.colorGradient.alpha, "default_line_colors_gradient_alpha");
-  put_in_tree(padTree, mLineDefaults.colorGradient.nColors, "default_line_colors_gradient_nColors");
-  put_in_tree(padTree, mFillDefaults.scale, "default_fill_opacity");
-  put_in_tree(padTree, mFillDefaults.styles, "default_fill_styles");
-  put_in_tree(padTree, mFillDefaults.colors, "default_fill_colors");
-  put_in_tree(padTree, mFillDefaults.colorGradient.rgbEndpoints, "default_fill_colors_gradient_endpoints");
-  put_in_tree(padTree, mFillDefaults.colorGradient.alpha, "default_fill_colors_gradient_alpha");
-  put_in_tree(padTree, mFillDefaults.colorGradient.nColors, "default_fill_colors_gradient_nColors");
-  put_in_tree(padTree, mDrawingOptionDefaults.graph, "default_drawing_option_graph");
-  put_in_tree(padTree, mDrawingOptionDefaults.hist, "default_drawing_option_hist");
-  put_in_tree(padTree, mDrawingOptionDefaults.hist2d, "default_drawing_option_hist2d");
-  put_in_tree(padTree, mCandleOptionDefaults.boxRange, "default_candle_option_boxrange");
-  put_in_tree(padTree, mCandleOptionDefaults.whiskerRange, "default_candle_option_whiskerrange");
-  put_in_tree(padTree, mRedrawAxes, "redraw_axes");
-  put_in_tree(padTree, mRefFunc, "ref_func");
+  write_properties(padTree, *this, GetPropertyTable());
 
   int32_t dataID = 1;
   for (auto& data : mData) {
@@ -873,71 +878,39 @@ ptree Plot::Pad::GetPropertyTree() const
 //**************************************************************************************************
 void Plot::Pad::operator+=(const Pad& pad)
 {
-  if (pad.mOptions) mOptions = pad.mOptions;
-  if (pad.mPosition.xlow) mPosition.xlow = pad.mPosition.xlow;
-  if (pad.mPosition.ylow) mPosition.ylow = pad.mPosition.ylow;
-  if (pad.mPosition.xup) mPosition.xup = pad.mPosition.xup;
-  if (pad.mPosition.yup) mPosition.yup = pad.mPosition.yup;
-  if (pad.mMargins.top) mMargins.top = pad.mMargins.top;
-  if (pad.mMargins.bottom) mMargins.bottom = pad.mMargins.bottom;
-  if (pad.mMargins.left) mMargins.left = pad.mMargins.left;
-  if (pad.mMargins.right) mMargins.right = pad.mMargins.right;
-  if (pad.mFill.color) mFill.color = pad.mFill.color;
-  if (pad.mFill.style) mFill.style = pad.mFill.style;
-  if (pad.mFill.scale) mFill.scale = pad.mFill.scale;
-  if (pad.mFrameFill.color) mFrameFill.color = pad.mFrameFill.color;
-  if (pad.mFrameFill.style) mFrameFill.style = pad.mFrameFill.style;
-  if (pad.mFrameFill.scale) mFrameFill.scale = pad.mFrameFill.scale;
-  if (pad.mFrameBorder.color) mFrameBorder.color = pad.mFrameBorder.color;
-  if (pad.mFrameBorder.style) mFrameBorder.style = pad.mFrameBorder.style;
-  if (pad.mFrameBorder.scale) mFrameBorder.scale = pad.mFrameBorder.scale;
-  if (pad.mText.scale) mText.scale = pad.mText.scale;
-  if (pad.mText.style) mText.style = pad.mText.style;
-  if (pad.mText.color) mText.color = pad.mText.color;
-  if (pad.mMarkerDefaults.scale) mMarkerDefaults.scale = pad.mMarkerDefaults.scale;
-  if (pad.mMarkerDefaults.styles) mMarkerDefaults.styles = pad.mMarkerDefaults.styles;
+  merge_properties(pad, *this, GetPropertyTable());
+
+  // colors can be defined either explicitly or via a gradient
   if (pad.mMarkerDefaults.colors) {
     mMarkerDefaults.colors = pad.mMarkerDefaults.colors;
     mMarkerDefaults.colorGradient = {};
-  };
+  }
   if (pad.mMarkerDefaults.colorGradient.rgbEndpoints) {
     mMarkerDefaults.colorGradient.rgbEndpoints = pad.mMarkerDefaults.colorGradient.rgbEndpoints;
     if (pad.mMarkerDefaults.colorGradient.alpha) mMarkerDefaults.colorGradient.alpha = pad.mMarkerDefaults.colorGradient.alpha;
     if (pad.mMarkerDefaults.colorGradient.nColors) mMarkerDefaults.colorGradient.nColors = pad.mMarkerDefaults.colorGradient.nColors;
     mMarkerDefaults.colors = std::nullopt;
   }
-  if (pad.mLineDefaults.scale) mLineDefaults.scale = pad.mLineDefaults.scale;
-  if (pad.mLineDefaults.styles) mLineDefaults.styles = pad.mLineDefaults.styles;
   if (pad.mLineDefaults.colors) {
     mLineDefaults.colors = pad.mLineDefaults.colors;
     mLineDefaults.colorGradient = {};
-  };
+  }
   if (pad.mLineDefaults.colorGradient.rgbEndpoints) {
     mLineDefaults.colorGradient.rgbEndpoints = pad.mLineDefaults.colorGradient.rgbEndpoints;
     if (pad.mLineDefaults.colorGradient.alpha) mLineDefaults.colorGradient.alpha = pad.mLineDefaults.colorGradient.alpha;
     if (pad.mLineDefaults.colorGradient.nColors) mLineDefaults.colorGradient.nColors = pad.mLineDefaults.colorGradient.nColors;
     mLineDefaults.colors = std::nullopt;
   }
-  if (pad.mFillDefaults.scale) mFillDefaults.scale = pad.mFillDefaults.scale;
-  if (pad.mFillDefaults.styles) mFillDefaults.styles = pad.mFillDefaults.styles;
   if (pad.mFillDefaults.colors) {
     mFillDefaults.colors = pad.mFillDefaults.colors;
     mFillDefaults.colorGradient = {};
-  };
+  }
   if (pad.mFillDefaults.colorGradient.rgbEndpoints) {
     mFillDefaults.colorGradient.rgbEndpoints = pad.mFillDefaults.colorGradient.rgbEndpoints;
     if (pad.mFillDefaults.colorGradient.alpha) mFillDefaults.colorGradient.alpha = pad.mFillDefaults.colorGradient.alpha;
     if (pad.mFillDefaults.colorGradient.nColors) mFillDefaults.colorGradient.nColors = pad.mFillDefaults.colorGradient.nColors;
     mFillDefaults.colors = std::nullopt;
   }
-  if (pad.mDrawingOptionDefaults.graph) mDrawingOptionDefaults.graph = pad.mDrawingOptionDefaults.graph;
-  if (pad.mDrawingOptionDefaults.hist) mDrawingOptionDefaults.hist = pad.mDrawingOptionDefaults.hist;
-  if (pad.mDrawingOptionDefaults.hist2d) mDrawingOptionDefaults.hist2d = pad.mDrawingOptionDefaults.hist2d;
-  if (pad.mCandleOptionDefaults.boxRange) mCandleOptionDefaults.boxRange = pad.mCandleOptionDefaults.boxRange;
-  if (pad.mCandleOptionDefaults.whiskerRange) mCandleOptionDefaults.whiskerRange = pad.mCandleOptionDefaults.whiskerRange;
-  if (pad.mPalette) mPalette = pad.mPalette;
-  if (pad.mRedrawAxes) mRedrawAxes = pad.mRedrawAxes;
-  if (pad.mRefFunc) mRefFunc = pad.mRefFunc;
   for (auto& [axisLabel, axis] : pad.mAxes) {
     mAxes[axisLabel]; // default initiialize in case this axis was not yet defined
     mAxes[axisLabel] += axis;
@@ -945,9 +918,8 @@ void Plot::Pad::operator+=(const Pad& pad)
   mLegendBoxes.insert(mLegendBoxes.end(), pad.mLegendBoxes.begin(), pad.mLegendBoxes.end());
   mTextBoxes.insert(mTextBoxes.end(), pad.mTextBoxes.begin(), pad.mTextBoxes.end());
 
-  // due to the way this function is (currently) used, the 'pad' is only a temporary object
-  // and therefore we can 'steal' its data by copying the pointers
-  mData = pad.mData; // this does not copy the data (!!)
+  // the data is shared with 'pad' until one of them is modified
+  mData = pad.mData;
 }
 
 //**************************************************************************************************
@@ -989,7 +961,7 @@ Plot::Pad::Data& Plot::Pad::GetData(uint8_t dataID)
     ERROR("Data with ID '{}' is not defined! You can access only data that was already added to the pad.", dataID);
     std::exit(EXIT_FAILURE);
   }
-  return *mData[dataID - 1];
+  return mData[dataID - 1].Mutable();
 }
 
 //**************************************************************************************************
@@ -1003,7 +975,7 @@ Plot::Pad::LegendBox& Plot::Pad::GetLegend(uint8_t legendID)
     ERROR("Legend with ID {} is not defined! You can access only legends that have already been added to the pad.", legendID);
     std::exit(EXIT_FAILURE);
   }
-  return *mLegendBoxes[legendID - 1];
+  return mLegendBoxes[legendID - 1].Mutable();
 }
 
 //**************************************************************************************************
@@ -1017,7 +989,7 @@ Plot::Pad::TextBox& Plot::Pad::GetText(uint8_t textID)
     ERROR("Text with ID {} is not defined! You can access only texts that have already been added to the pad.", textID);
     std::exit(EXIT_FAILURE);
   }
-  return *mTextBoxes[textID - 1];
+  return mTextBoxes[textID - 1].Mutable();
 }
 
 //**************************************************************************************************
@@ -1028,15 +1000,16 @@ Plot::Pad::TextBox& Plot::Pad::GetText(uint8_t textID)
 Plot::Pad::Data& Plot::Pad::AddData(const string& name, const string& inputIdentifier, const optional<string>& label)
 {
   mData.push_back(std::make_shared<Data>(name, inputIdentifier, label));
-  return *mData.back();
+  return mData.back().Mutable();
 }
 
 Plot::Pad::Data& Plot::Pad::AddData(const string& name, const Data& data, const optional<string>& label)
 {
   mData.push_back(std::make_shared<Data>(name, data.GetInputID(), label));
-  mData.back()->SetLayout(data);
-  if (!label && data.GetLegendLabel()) mData.back()->SetLegendLabel(*data.GetLegendLabel());
-  return *mData.back();
+  auto& newData = mData.back().Mutable();
+  newData.SetLayout(data);
+  if (!label && data.GetLegendLabel()) newData.SetLegendLabel(*data.GetLegendLabel());
+  return newData;
 }
 
 //**************************************************************************************************
@@ -1048,15 +1021,16 @@ Plot::Pad::Ratio& Plot::Pad::AddRatio(const string& numeratorName, const string&
 {
   mData.push_back(std::make_shared<Ratio>(numeratorName, numeratorInputIdentifier,
                                           denominatorName, denominatorInputIdentifier, label));
-  return *std::dynamic_pointer_cast<Ratio>(mData.back());
+  return mData.back().Mutable<Ratio>();
 }
 
 Plot::Pad::Ratio& Plot::Pad::AddRatio(const string& numeratorName, const Data& data, const string& denominatorName, const string& denominatorInputIdentifier, const optional<string>& label)
 {
   mData.push_back(std::make_shared<Ratio>(numeratorName, data.GetInputID(),
                                           denominatorName, denominatorInputIdentifier, label));
-  mData.back()->SetLayout(data);
-  return *std::dynamic_pointer_cast<Ratio>(mData.back());
+  auto& newRatio = mData.back().Mutable<Ratio>();
+  newRatio.SetLayout(data);
+  return newRatio;
 }
 
 //**************************************************************************************************
@@ -1067,7 +1041,7 @@ Plot::Pad::Ratio& Plot::Pad::AddRatio(const string& numeratorName, const Data& d
 Plot::Pad::TextBox& Plot::Pad::AddText(double_t xPos, double_t yPos, const string& text)
 {
   mTextBoxes.push_back(std::make_shared<TextBox>(xPos, yPos, text));
-  return *mTextBoxes.back();
+  return mTextBoxes.back().Mutable();
 }
 
 //**************************************************************************************************
@@ -1078,7 +1052,7 @@ Plot::Pad::TextBox& Plot::Pad::AddText(double_t xPos, double_t yPos, const strin
 Plot::Pad::TextBox& Plot::Pad::AddText(const string& text)
 {
   mTextBoxes.push_back(std::make_shared<TextBox>(text));
-  return *mTextBoxes.back();
+  return mTextBoxes.back().Mutable();
 }
 
 //**************************************************************************************************
@@ -1089,7 +1063,7 @@ Plot::Pad::TextBox& Plot::Pad::AddText(const string& text)
 Plot::Pad::LegendBox& Plot::Pad::AddLegend(double_t xPos, double_t yPos)
 {
   mLegendBoxes.push_back(std::make_shared<LegendBox>(xPos, yPos));
-  return *mLegendBoxes.back();
+  return mLegendBoxes.back().Mutable();
 }
 
 //**************************************************************************************************
@@ -1100,7 +1074,7 @@ Plot::Pad::LegendBox& Plot::Pad::AddLegend(double_t xPos, double_t yPos)
 Plot::Pad::LegendBox& Plot::Pad::AddLegend()
 {
   mLegendBoxes.push_back(std::make_shared<LegendBox>());
-  return *mLegendBoxes.back();
+  return mLegendBoxes.back().Mutable();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1133,6 +1107,41 @@ Plot::Pad::Data::Data(const string& name, const string& inputIdentifier, const o
   }
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the data as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::Pad::Data::GetPropertyTable()
+{
+  using kind = property_kind;
+  return property_table(
+    property("legend_label", &Data::mLegend, &legend_t::label),
+    property("legend_id", &Data::mLegend, &legend_t::identifier),
+    property<kind::layout>("drawing_options", &Data::mDrawingOptions),
+    property<kind::layout>("drawing_option_alias", &Data::mDrawingOptionAlias),
+    property<kind::layout>("text_format", &Data::mTextFormat),
+    property<kind::layout>("marker_color", &Data::mMarker, &layout_t::color),
+    property<kind::layout>("marker_style", &Data::mMarker, &layout_t::style),
+    property<kind::layout>("marker_size", &Data::mMarker, &layout_t::scale),
+    property<kind::layout>("line_color", &Data::mLine, &layout_t::color),
+    property<kind::layout>("line_style", &Data::mLine, &layout_t::style),
+    property<kind::layout>("line_width", &Data::mLine, &layout_t::scale),
+    property<kind::layout>("fill_color", &Data::mFill, &layout_t::color),
+    property<kind::layout>("fill_style", &Data::mFill, &layout_t::style),
+    property<kind::layout>("fill_opacity", &Data::mFill, &layout_t::scale),
+    property("scale_factor", &Data::mModify, &modify_t::scaleFactor),
+    property("norm_mode", &Data::mModify, &modify_t::normMode),
+    property<kind::layout>("rangeX_min", &Data::mRangeX, &dataRange_t::min),
+    property<kind::layout>("rangeX_max", &Data::mRangeX, &dataRange_t::max),
+    property<kind::layout>("rangeY_min", &Data::mRangeY, &dataRange_t::min),
+    property<kind::layout>("rangeY_max", &Data::mRangeY, &dataRange_t::max),
+    property<kind::layout>("scale_range_min", &Data::mScaleRange, &dataRange_t::min),
+    property<kind::layout>("scale_range_max", &Data::mScaleRange, &dataRange_t::max),
+    property<kind::layout>("contours", &Data::mContours),
+    property<kind::layout>("number_of_contours", &Data::mNContours));
+}
+
 //**************************************************************************************************
 /**
  * Constructor for Data objects from property tree.
@@ -1149,30 +1158,7 @@ Plot::Pad::Data::Data(const ptree& dataTree) : Data()
     std::exit(EXIT_FAILURE);
   }
   if (auto var = dataTree.get_optional<bool>("defines_frame")) mDefinesFrame = *var;
-  read_from_tree(dataTree, mLegend.label, "legend_label");
-  read_from_tree(dataTree, mLegend.identifier, "legend_id");
-  read_from_tree(dataTree, mDrawingOptions, "drawing_options");
-  read_from_tree(dataTree, mDrawingOptionAlias, "drawing_option_alias");
-  read_from_tree(dataTree, mTextFormat, "text_format");
-  read_from_tree(dataTree, mMarker.color, "marker_color");
-  read_from_tree(dataTree, mMarker.style, "marker_style");
-  read_from_tree(dataTree, mMarker.scale, "marker_size");
-  read_from_tree(dataTree, mLine.color, "line_color");
-  read_from_tree(dataTree, mLine.style, "line_style");
-  read_from_tree(dataTree, mLine.scale, "line_width");
-  read_from_tree(dataTree, mFill.color, "fill_color");
-  read_from_tree(dataTree, mFill.style, "fill_style");
-  read_from_tree(dataTree, mFill.scale, "fill_opacity");
-  read_from_tree(dataTree, mModify.scaleFactor, "scale_factor");
-  read_from_tree(dataTree, mModify.normMode, "norm_mode");
-  read_from_tree(dataTree, mRangeX.min, "rangeX_min");
-  read_from_tree(dataTree, mRangeX.max, "rangeX_max");
-  read_from_tree(dataTree, mRangeY.min, "rangeY_min");
-  read_from_tree(dataTree, mRangeY.max, "rangeY_max");
-  read_from_tree(dataTree, mScaleRange.min, "scale_range_min");
-  read_from_tree(dataTree, mScaleRange.max, "scale_range_max");
-  read_from_tree(dataTree, mContours, "contours");
-  read_from_tree(dataTree, mNContours, "number_of_contours");
+  read_properties(dataTree, *this, GetPropertyTable());
 
   // ugly workaround
   std::optional<vector<uint8_t>> dims;
@@ -1198,33 +1184,10 @@ ptree Plot::Pad::Data::GetPropertyTree() const
 {
   ptree dataTree;
   dataTree.put("type", mType);
-  dataTree.put("name", mName);
-  dataTree.put("inputIdentifier", mInputIdentifier);
+  dataTree.put("name", mName.str());
+  dataTree.put("inputIdentifier", mInputIdentifier.str());
   if (mDefinesFrame) dataTree.put("defines_frame", mDefinesFrame);
-  put_in_tree(dataTree, mLegend.label, "legend_label");
-  put_in_tree(dataTree, mLegend.identifier, "legend_id");
-  put_in_tree(dataTree, mDrawingOptions, "drawing_options");
-  put_in_tree(dataTree, mDrawingOptionAlias, "drawing_option_alias");
-  put_in_tree(dataTree, mTextFormat, "text_format");
-  put_in_tree(dataTree, mMarker.color, "marker_color");
-  put_in_tree(dataTree, mMarker.style, "marker_style");
-  put_in_tree(dataTree, mMarker.scale, "marker_size");
-  put_in_tree(dataTree, mLine.color, "line_color");
-  put_in_tree(dataTree, mLine.style, "line_style");
-  put_in_tree(dataTree, mLine.scale, "line_width");
-  put_in_tree(dataTree, mFill.color, "fill_color");
-  put_in_tree(dataTree, mFill.style, "fill_style");
-  put_in_tree(dataTree, mFill.scale, "fill_opacity");
-  put_in_tree(dataTree, mModify.scaleFactor, "scale_factor");
-  put_in_tree(dataTree, mModify.normMode, "norm_mode");
-  put_in_tree(dataTree, mRangeX.min, "rangeX_min");
-  put_in_tree(dataTree, mRangeX.max, "rangeX_max");
-  put_in_tree(dataTree, mRangeY.min, "rangeY_min");
-  put_in_tree(dataTree, mRangeY.max, "rangeY_max");
-  put_in_tree(dataTree, mScaleRange.min, "scale_range_min");
-  put_in_tree(dataTree, mScaleRange.max, "scale_range_max");
-  put_in_tree(dataTree, mContours, "contours");
-  put_in_tree(dataTree, mNContours, "number_of_contours");
+  write_properties(dataTree, *this, GetPropertyTable());
 
   // ugly workaround
   if (mProjInfo) {
@@ -1245,51 +1208,13 @@ ptree Plot::Pad::Data::GetPropertyTree() const
 auto Plot::Pad::Data::SetLayout(const Data& dataLayout) -> decltype(*this)
 {
   // set all properties related to the appearance of the data exactly as specified in the layout
-  mDrawingOptions = dataLayout.mDrawingOptions;
-  mDrawingOptionAlias = dataLayout.mDrawingOptionAlias;
-  mTextFormat = dataLayout.mTextFormat;
-  mRangeX.min = dataLayout.mRangeX.min;
-  mRangeX.max = dataLayout.mRangeX.max;
-  mRangeY.min = dataLayout.mRangeY.min;
-  mRangeY.max = dataLayout.mRangeY.max;
-  mScaleRange.min = dataLayout.mScaleRange.min;
-  mScaleRange.max = dataLayout.mScaleRange.max;
-  mMarker.color = dataLayout.mMarker.color;
-  mMarker.style = dataLayout.mMarker.style;
-  mMarker.scale = dataLayout.mMarker.scale;
-  mLine.color = dataLayout.mLine.color;
-  mLine.style = dataLayout.mLine.style;
-  mLine.scale = dataLayout.mLine.scale;
-  mFill.color = dataLayout.mFill.color;
-  mFill.style = dataLayout.mFill.style;
-  mFill.scale = dataLayout.mFill.scale;
-  mContours = dataLayout.mContours;
-  mNContours = dataLayout.mNContours;
+  transfer_properties<property_kind::layout>(dataLayout, *this, GetPropertyTable(), true);
   return *this;
 }
 auto Plot::Pad::Data::ApplyLayout(const Data& dataLayout) -> decltype(*this)
 {
   // apply only the properties of the layout which are set
-  set_if(dataLayout.mDrawingOptions, mDrawingOptions);
-  set_if(dataLayout.mDrawingOptionAlias, mDrawingOptionAlias);
-  set_if(dataLayout.mTextFormat, mTextFormat);
-  set_if(dataLayout.mRangeX.min, mRangeX.min);
-  set_if(dataLayout.mRangeX.max, mRangeX.max);
-  set_if(dataLayout.mRangeY.min, mRangeY.min);
-  set_if(dataLayout.mRangeY.max, mRangeY.max);
-  set_if(dataLayout.mScaleRange.min, mScaleRange.min);
-  set_if(dataLayout.mScaleRange.max, mScaleRange.max);
-  set_if(dataLayout.mMarker.color, mMarker.color);
-  set_if(dataLayout.mMarker.style, mMarker.style);
-  set_if(dataLayout.mMarker.scale, mMarker.scale);
-  set_if(dataLayout.mLine.color, mLine.color);
-  set_if(dataLayout.mLine.style, mLine.style);
-  set_if(dataLayout.mLine.scale, mLine.scale);
-  set_if(dataLayout.mFill.color, mFill.color);
-  set_if(dataLayout.mFill.style, mFill.style);
-  set_if(dataLayout.mFill.scale, mFill.scale);
-  set_if(dataLayout.mContours, mContours);
-  set_if(dataLayout.mNContours, mNContours);
+  transfer_properties<property_kind::layout>(dataLayout, *this, GetPropertyTable(), false);
   return *this;
 }
 auto Plot::Pad::Data::SetInputID(const string& inputIdentifier) -> decltype(*this)
@@ -1606,8 +1531,8 @@ Plot::Pad::Ratio::Ratio(const ptree& dataTree) : Data(dataTree)
 ptree Plot::Pad::Ratio::GetPropertyTree() const
 {
   ptree dataTree = Data::GetPropertyTree();
-  dataTree.put("denomName", mDenomName);
-  dataTree.put("denomInputID", mDenomInputIdentifier);
+  dataTree.put("denomName", mDenomName.str());
+  dataTree.put("denomInputID", mDenomInputIdentifier.str());
   dataTree.put("isCorrelated", mIsCorrelated);
 
   // ugly workaround
@@ -1680,6 +1605,39 @@ Plot::Pad::Axis::Axis(const char axisName) : Axis()
   mName = axisName;
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the axis as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::Pad::Axis::GetPropertyTable()
+{
+  return property_table(
+    property("title", &Axis::mTitle),
+    property("range_min", &Axis::mRange, &axisRange_t::min),
+    property("range_max", &Axis::mRange, &axisRange_t::max),
+    property("num_divisions", &Axis::mNumDivisions),
+    property("max_digits", &Axis::mMaxDigits),
+    property("tick_length", &Axis::mTickLength),
+    property("axis_color", &Axis::mAxisColor),
+    property("title_font", &Axis::mTitleProperties, &axisTextProperties_t::font),
+    property("title_size", &Axis::mTitleProperties, &axisTextProperties_t::size),
+    property("title_color", &Axis::mTitleProperties, &axisTextProperties_t::color),
+    property("title_offset", &Axis::mTitleProperties, &axisTextProperties_t::offset),
+    property("title_center", &Axis::mTitleProperties, &axisTextProperties_t::center),
+    property("label_font", &Axis::mLabelProperties, &axisTextProperties_t::font),
+    property("label_size", &Axis::mLabelProperties, &axisTextProperties_t::size),
+    property("label_color", &Axis::mLabelProperties, &axisTextProperties_t::color),
+    property("label_offset", &Axis::mLabelProperties, &axisTextProperties_t::offset),
+    property("label_center", &Axis::mLabelProperties, &axisTextProperties_t::center),
+    property("is_log", &Axis::mIsLog),
+    property("is_grid", &Axis::mIsGrid),
+    property("is_opposite_ticks", &Axis::mIsOppositeTicks),
+    property("is_no_exponent", &Axis::mIsNoExponent),
+    property("tick_orientation", &Axis::mTickOrientation),
+    property("time_format", &Axis::mTimeFormat));
+}
+
 //**************************************************************************************************
 /**
  * Constructor to define entry from file.
@@ -1692,29 +1650,7 @@ Plot::Pad::Axis::Axis(const ptree& axisTree) : Axis()
   } catch (...) {
     ERROR("Could not construct axis from ptree.");
   }
-  read_from_tree(axisTree, mTitle, "title");
-  read_from_tree(axisTree, mRange.min, "range_min");
-  read_from_tree(axisTree, mRange.max, "range_max");
-  read_from_tree(axisTree, mNumDivisions, "num_divisions");
-  read_from_tree(axisTree, mMaxDigits, "max_digits");
-  read_from_tree(axisTree, mTickLength, "tick_length");
-  read_from_tree(axisTree, mAxisColor, "axis_color");
-  read_from_tree(axisTree, mTitleProperties.font, "title_font");
-  read_from_tree(axisTree, mTitleProperties.size, "title_size");
-  read_from_tree(axisTree, mTitleProperties.color, "title_color");
-  read_from_tree(axisTree, mTitleProperties.offset, "title_offset");
-  read_from_tree(axisTree, mTitleProperties.center, "title_center");
-  read_from_tree(axisTree, mLabelProperties.font, "label_font");
-  read_from_tree(axisTree, mLabelProperties.size, "label_size");
-  read_from_tree(axisTree, mLabelProperties.color, "label_color");
-  read_from_tree(axisTree, mLabelProperties.offset, "label_offset");
-  read_from_tree(axisTree, mLabelProperties.center, "label_center");
-  read_from_tree(axisTree, mIsLog, "is_log");
-  read_from_tree(axisTree, mIsGrid, "is_grid");
-  read_from_tree(axisTree, mIsOppositeTicks, "is_opposite_ticks");
-  read_from_tree(axisTree, mIsNoExponent, "is_no_exponent");
-  read_from_tree(axisTree, mTickOrientation, "tick_orientation");
-  read_from_tree(axisTree, mTimeFormat, "time_format");
+  read_properties(axisTree, *this, GetPropertyTable());
 }
 
 //**************************************************************************************************
@@ -1726,29 +1662,7 @@ ptree Plot::Pad::Axis::GetPropertyTree() const
 {
   ptree axisTree;
   axisTree.put("name", mName);
-  put_in_tree(axisTree, mTitle, "title");
-  put_in_tree(axisTree, mRange.min, "range_min");
-  put_in_tree(axisTree, mRange.max, "range_max");
-  put_in_tree(axisTree, mNumDivisions, "num_divisions");
-  put_in_tree(axisTree, mMaxDigits, "max_digits");
-  put_in_tree(axisTree, mTickLength, "tick_length");
-  put_in_tree(axisTree, mAxisColor, "axis_color");
-  put_in_tree(axisTree, mTitleProperties.font, "title_font");
-  put_in_tree(axisTree, mTitleProperties.size, "title_size");
-  put_in_tree(axisTree, mTitleProperties.color, "title_color");
-  put_in_tree(axisTree, mTitleProperties.offset, "title_offset");
-  put_in_tree(axisTree, mTitleProperties.center, "title_center");
-  put_in_tree(axisTree, mLabelProperties.font, "label_font");
-  put_in_tree(axisTree, mLabelProperties.size, "label_size");
-  put_in_tree(axisTree, mLabelProperties.color, "label_color");
-  put_in_tree(axisTree, mLabelProperties.offset, "label_offset");
-  put_in_tree(axisTree, mLabelProperties.center, "label_center");
-  put_in_tree(axisTree, mIsLog, "is_log");
-  put_in_tree(axisTree, mIsGrid, "is_grid");
-  put_in_tree(axisTree, mIsOppositeTicks, "is_opposite_ticks");
-  put_in_tree(axisTree, mIsNoExponent, "is_no_exponent");
-  put_in_tree(axisTree, mTickOrientation, "tick_orientation");
-  put_in_tree(axisTree, mTimeFormat, "time_format");
+  write_properties(axisTree, *this, GetPropertyTable());
 
   return axisTree;
 }
@@ -1761,29 +1675,7 @@ ptree Plot::Pad::Axis::GetPropertyTree() const
 void Plot::Pad::Axis::Axis::operator+=(const Axis& axis)
 {
   mName = axis.mName;
-  if (axis.mRange.min) mRange.min = axis.mRange.min;
-  if (axis.mRange.max) mRange.max = axis.mRange.max;
-  if (axis.mTitle) mTitle = axis.mTitle;
-  if (axis.mNumDivisions) mNumDivisions = axis.mNumDivisions;
-  if (axis.mMaxDigits) mMaxDigits = axis.mMaxDigits;
-  if (axis.mTickLength) mTickLength = axis.mTickLength;
-  if (axis.mAxisColor) mAxisColor = axis.mAxisColor;
-  if (axis.mIsLog) mIsLog = axis.mIsLog;
-  if (axis.mIsGrid) mIsGrid = axis.mIsGrid;
-  if (axis.mIsOppositeTicks) mIsOppositeTicks = axis.mIsOppositeTicks;
-  if (axis.mIsNoExponent) mIsNoExponent = axis.mIsNoExponent;
-  if (axis.mTitleProperties.font) mTitleProperties.font = axis.mTitleProperties.font;
-  if (axis.mTitleProperties.size) mTitleProperties.size = axis.mTitleProperties.size;
-  if (axis.mTitleProperties.color) mTitleProperties.color = axis.mTitleProperties.color;
-  if (axis.mTitleProperties.offset) mTitleProperties.offset = axis.mTitleProperties.offset;
-  if (axis.mTitleProperties.center) mTitleProperties.center = axis.mTitleProperties.center;
-  if (axis.mLabelProperties.font) mLabelProperties.font = axis.mLabelProperties.font;
-  if (axis.mLabelProperties.size) mLabelProperties.size = axis.mLabelProperties.size;
-  if (axis.mLabelProperties.color) mLabelProperties.color = axis.mLabelProperties.color;
-  if (axis.mLabelProperties.offset) mLabelProperties.offset = axis.mLabelProperties.offset;
-  if (axis.mLabelProperties.center) mLabelProperties.center = axis.mLabelProperties.center;
-  if (axis.mTimeFormat) mTimeFormat = axis.mTimeFormat;
-  if (axis.mTickOrientation) mTickOrientation = axis.mTickOrientation;
+  merge_properties(axis, *this, GetPropertyTable());
 }
 
 //**************************************************************************************************
@@ -1937,6 +1829,29 @@ Plot::Pad::Box<BoxType>::Box(double_t xPos, double_t yPos) : Box()
   mPos.y = yPos;
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties common to all boxes as stored in the property tree.
+ */
+//**************************************************************************************************
+template <typename BoxType>
+constexpr auto Plot::Pad::Box<BoxType>::GetPropertyTable()
+{
+  return property_table(
+    property("x", &Box::mPos, &position_t::x),
+    property("y", &Box::mPos, &position_t::y),
+    property("is_user_coordinates", &Box::mPos, &position_t::isUserCoord),
+    property("border_style", &Box::mBorder, &layout_t::style),
+    property("border_color", &Box::mBorder, &layout_t::color),
+    property("border_width", &Box::mBorder, &layout_t::scale),
+    property("fill_style", &Box::mFill, &layout_t::style),
+    property("fill_color", &Box::mFill, &layout_t::color),
+    property("fill_opacity", &Box::mFill, &layout_t::scale),
+    property("text_style", &Box::mText, &layout_t::style),
+    property("text_color", &Box::mText, &layout_t::color),
+    property("text_size", &Box::mText, &layout_t::scale));
+}
+
 //**************************************************************************************************
 /**
  * Construct box from property tree.
@@ -1945,18 +1860,7 @@ Plot::Pad::Box<BoxType>::Box(double_t xPos, double_t yPos) : Box()
 template <typename BoxType>
 Plot::Pad::Box<BoxType>::Box(const ptree& boxTree) : Box()
 {
-  read_from_tree(boxTree, mPos.x, "x");
-  read_from_tree(boxTree, mPos.y, "y");
-  read_from_tree(boxTree, mPos.isUserCoord, "is_user_coordinates");
-  read_from_tree(boxTree, mBorder.style, "border_style");
-  read_from_tree(boxTree, mBorder.color, "border_color");
-  read_from_tree(boxTree, mBorder.scale, "border_width");
-  read_from_tree(boxTree, mFill.style, "fill_style");
-  read_from_tree(boxTree, mFill.color, "fill_color");
-  read_from_tree(boxTree, mFill.scale, "fill_opacity");
-  read_from_tree(boxTree, mText.style, "text_style");
-  read_from_tree(boxTree, mText.color, "text_color");
-  read_from_tree(boxTree, mText.scale, "text_size");
+  read_properties(boxTree, *this, GetPropertyTable());
 }
 
 //**************************************************************************************************
@@ -1968,18 +1872,7 @@ template <typename BoxType>
 ptree Plot::Pad::Box<BoxType>::GetPropertyTree() const
 {
   ptree boxTree;
-  put_in_tree(boxTree, mPos.x, "x");
-  put_in_tree(boxTree, mPos.y, "y");
-  put_in_tree(boxTree, mPos.isUserCoord, "is_user_coordinates");
-  put_in_tree(boxTree, mBorder.style, "border_style");
-  put_in_tree(boxTree, mBorder.color, "border_color");
-  put_in_tree(boxTree, mBorder.scale, "border_width");
-  put_in_tree(boxTree, mFill.style, "fill_style");
-  put_in_tree(boxTree, mFill.color, "fill_color");
-  put_in_tree(boxTree, mFill.scale, "fill_opacity");
-  put_in_tree(boxTree, mText.style, "text_style");
-  put_in_tree(boxTree, mText.color, "text_color");
-  put_in_tree(boxTree, mText.scale, "text_size");
+  write_properties(boxTree, *this, GetPropertyTable());
 
   return boxTree;
 };
@@ -2206,6 +2099,28 @@ Plot::Pad::LegendBox::LegendBox() : Box(), mTitle{}, mNumColumns{}
   SetAutoPlacement();
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the legend box as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::Pad::LegendBox::GetPropertyTable()
+{
+  return property_table(
+    property("title", &LegendBox::mTitle),
+    property("num_columns", &LegendBox::mNumColumns),
+    property("default_draw_style", &LegendBox::mDrawStyleDefault),
+    property("default_marker_color", &LegendBox::mMarkerDefault, &layout_t::color),
+    property("default_marker_style", &LegendBox::mMarkerDefault, &layout_t::style),
+    property("default_marker_size", &LegendBox::mMarkerDefault, &layout_t::scale),
+    property("default_line_color", &LegendBox::mLineDefault, &layout_t::color),
+    property("default_line_style", &LegendBox::mLineDefault, &layout_t::style),
+    property("default_line_width", &LegendBox::mLineDefault, &layout_t::scale),
+    property("default_fill_color", &LegendBox::mFillDefault, &layout_t::color),
+    property("default_fill_style", &LegendBox::mFillDefault, &layout_t::style),
+    property("default_fill_opacity", &LegendBox::mFillDefault, &layout_t::scale));
+}
+
 //**************************************************************************************************
 /**
  * LegendBox constructor from property tree.
@@ -2213,18 +2128,7 @@ Plot::Pad::LegendBox::LegendBox() : Box(), mTitle{}, mNumColumns{}
 //**************************************************************************************************
 Plot::Pad::LegendBox::LegendBox(const ptree& legendBoxTree) : Box(legendBoxTree)
 {
-  read_from_tree(legendBoxTree, mTitle, "title");
-  read_from_tree(legendBoxTree, mNumColumns, "num_columns");
-  read_from_tree(legendBoxTree, mDrawStyleDefault, "default_draw_style");
-  read_from_tree(legendBoxTree, mMarkerDefault.color, "default_marker_color");
-  read_from_tree(legendBoxTree, mMarkerDefault.style, "default_marker_style");
-  read_from_tree(legendBoxTree, mMarkerDefault.scale, "default_marker_size");
-  read_from_tree(legendBoxTree, mLineDefault.color, "default_line_color");
-  read_from_tree(legendBoxTree, mLineDefault.style, "default_line_style");
-  read_from_tree(legendBoxTree, mLineDefault.scale, "default_line_width");
-  read_from_tree(legendBoxTree, mFillDefault.color, "default_fill_color");
-  read_from_tree(legendBoxTree, mFillDefault.style, "default_fill_style");
-  read_from_tree(legendBoxTree, mFillDefault.scale, "default_fill_opacity");
+  read_properties(legendBoxTree, *this, GetPropertyTable());
 
   for (auto& content : legendBoxTree) {
     if (str_contains(content.first, "ENTRY")) {
@@ -2242,18 +2146,7 @@ Plot::Pad::LegendBox::LegendBox(const ptree& legendBoxTree) : Box(legendBoxTree)
 ptree Plot::Pad::LegendBox::GetPropertyTree() const
 {
   ptree legendBoxTree = Box::GetPropertyTree();
-  put_in_tree(legendBoxTree, mTitle, "title");
-  put_in_tree(legendBoxTree, mNumColumns, "num_columns");
-  put_in_tree(legendBoxTree, mDrawStyleDefault, "default_draw_style");
-  put_in_tree(legendBoxTree, mMarkerDefault.color, "default_marker_color");
-  put_in_tree(legendBoxTree, mMarkerDefault.style, "default_marker_style");
-  put_in_tree(legendBoxTree, mMarkerDefault.scale, "default_marker_size");
-  put_in_tree(legendBoxTree, mLineDefault.color, "default_line_color");
-  put_in_tree(legendBoxTree, mLineDefault.style, "default_line_style");
-  put_in_tree(legendBoxTree, mLineDefault.scale, "default_line_width");
-  put_in_tree(legendBoxTree, mFillDefault.color, "default_fill_color");
-  put_in_tree(legendBoxTree, mFillDefault.style, "default_fill_style");
-  put_in_tree(legendBoxTree, mFillDefault.scale, "default_fill_opacity");
+  write_properties(legendBoxTree, *this, GetPropertyTable());
 
   for (auto& [legendEntryID, legendEntry] : mLegendEntriesUser) {
     legendBoxTree.put_child("ENTRY_" + std::to_string(legendEntryID),
@@ -2381,6 +2274,32 @@ Plot::Pad::LegendBox::LegendEntry::LegendEntry(const optional<string>& label, co
   mDrawStyle = drawStyle;
 }
 
+//**************************************************************************************************
+/**
+ * Optional properties of the legend entry as stored in the property tree.
+ */
+//**************************************************************************************************
+constexpr auto Plot::Pad::LegendBox::LegendEntry::GetPropertyTable()
+{
+  using kind = property_kind;
+  return property_table(
+    property("label", &LegendEntry::mLabel),
+    property("ref_data_name", &LegendEntry::mRefDataName),
+    property<kind::layout>("draw_style", &LegendEntry::mDrawStyle),
+    property<kind::layout>("fill_color", &LegendEntry::mFill, &layout_t::color),
+    property<kind::layout>("fill_style", &LegendEntry::mFill, &layout_t::style),
+    property<kind::layout>("fill_opacity", &LegendEntry::mFill, &layout_t::scale),
+    property<kind::layout>("line_color", &LegendEntry::mLine, &layout_t::color),
+    property<kind::layout>("line_style", &LegendEntry::mLine, &layout_t::style),
+    property<kind::layout>("line_width", &LegendEntry::mLine, &layout_t::scale),
+    property<kind::layout>("marker_color", &LegendEntry::mMarker, &layout_t::color),
+    property<kind::layout>("marker_style", &LegendEntry::mMarker, &layout_t::style),
+    property<kind::layout>("marker_width", &LegendEntry::mMarker, &layout_t::scale),
+    property<kind::layout>("text_color", &LegendEntry::mText, &layout_t::color),
+    property<kind::layout>("text_font", &LegendEntry::mText, &layout_t::style),
+    property<kind::layout>("text_size", &LegendEntry::mText, &layout_t::scale));
+}
+
 //**************************************************************************************************
 /**
  * Construct LegendEntry from property tree.
@@ -2388,21 +2307,7 @@ Plot::Pad::LegendBox::LegendEntry::LegendEntry(const optional<string>& label, co
 //**************************************************************************************************
 Plot::Pad::LegendBox::LegendEntry::LegendEntry(const ptree& legendEntryTree)
 {
-  read_from_tree(legendEntryTree, mLabel, "label");
-  read_from_tree(legendEntryTree, mRefDataName, "ref_data_name");
-  read_from_tree(legendEntryTree, mDrawStyle, "draw_style");
-  read_from_tree(legendEntryTree, mFill.color, "fill_color");
-  read_from_tree(legendEntryTree, mFill.style, "fill_style");
-  read_from_tree(legendEntryTree, mFill.scale, "fill_opacity");
-  read_from_tree(legendEntryTree, mLine.color, "line_color");
-  read_from_tree(legendEntryTree, mLine.style, "line_style");
-  read_from_tree(legendEntryTree, mLine.scale, "line_width");
-  read_from_tree(legendEntryTree, mMarker.color, "marker_color");
-  read_from_tree(legendEntryTree, mMarker.style, "marker_style");
-  read_from_tree(legendEntryTree, mMarker.scale, "marker_width");
-  read_from_tree(legendEntryTree, mText.color, "text_color");
-  read_from_tree(legendEntryTree, mText.style, "text_font");
-  read_from_tree(legendEntryTree, mText.scale, "text_size");
+  read_properties(legendEntryTree, *this, GetPropertyTable());
 }
 
 //**************************************************************************************************
@@ -2413,21 +2318,7 @@ Plot::Pad::LegendBox::LegendEntry::LegendEntry(const ptree& legendEntryTree)
 ptree Plot::Pad::LegendBox::LegendEntry::GetPropertyTree() const
 {
   ptree legendEntryTree;
-  put_in_tree(legendEntryTree, mLabel, "label");
-  put_in_tree(legendEntryTree, mRefDataName, "ref_data_name");
-  put_in_tree(legendEntryTree, mDrawStyle, "draw_style");
-  put_in_tree(legendEntryTree, mFill.color, "fill_color");
-  put_in_tree(legendEntryTree, mFill.style, "fill_style");
-  put_in_tree(legendEntryTree, mFill.scale, "fill_opacity");
-  put_in_tree(legendEntryTree, mLine.color, "line_color");
-  put_in_tree(legendEntryTree, mLine.style, "line_style");
-  put_in_tree(legendEntryTree, mLine.scale, "line_width");
-  put_in_tree(legendEntryTree, mMarker.color, "marker_color");
-  put_in_tree(legendEntryTree, mMarker.style, "marker_style");
-  put_in_tree(legendEntryTree, mMarker.scale, "marker_width");
-  put_in_tree(legendEntryTree, mText.color, "text_color");
-  put_in_tree(legendEntryTree, mText.style, "text_font");
-  put_in_tree(legendEntryTree, mText.scale, "text_size");
+  write_properties(legendEntryTree, *this, GetPropertyTable());
   return legendEntryTree;
 };
 
@@ -2439,19 +2330,8 @@ ptree Plot::Pad::LegendBox::LegendEntry::GetPropertyTree() const
 void Plot::Pad::LegendBox::LegendEntry::operator+=(
   const Plot::Pad::LegendBox::LegendEntry& legendEntry)
 {
-  this->mDrawStyle = legendEntry.mDrawStyle;
-  this->mMarker.color = legendEntry.mMarker.color;
-  this->mMarker.scale = legendEntry.mMarker.scale;
-  this->mMarker.style = legendEntry.mMarker.style;
-  this->mLine.color = legendEntry.mLine.color;
-  this->mLine.scale = legendEntry.mLine.scale;
-  this->mLine.style = legendEntry.mLine.style;
-  this->mFill.color = legendEntry.mFill.color;
-  this->mFill.scale = legendEntry.mFill.scale;
-  this->mFill.style = legendEntry.mFill.style;
-  this->mText.color = legendEntry.mText.color;
-  this->mText.scale = legendEntry.mText.scale;
-  this->mText.style = legendEntry.mText.style;
+  // the appearance of the entry is taken over completely
+  transfer_properties<property_kind::layout>(legendEntry, *this, GetPropertyTable(), true);
 }
 
 //**************************************************************************************************
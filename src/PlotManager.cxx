@@ -18,12 +18,30 @@
 // framework dependencies
 #include "PlotManager.h"
 #include "PlotPainter.h"
+#include "OutputWriter.h"
+#include "FilePool.h"
+#include "ContainerCache.h"
+#include "ChunkedSparse.h"
+#include "Profiler.h"
 #include "Logging.h"
 #include "Helpers.h"
+#include "CSVReader.h"
+#include "YODAReader.h"
+#include "HEPDataReader.h"
+#include "NumPyReader.h"
+#include "TreeFiller.h"
 
 // std dependencies
 #include <regex>
 #include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstring>
 
 // boost dependencies
 #include <boost/property_tree/xml_parser.hpp>
@@ -39,21 +57,91 @@
 #include "TKey.h"
 #include "TH1.h"
 #include "TGraphErrors.h"
+#include "TGraphAsymmErrors.h"
 #include "TFolder.h"
+#include "TList.h"
+#include "TClass.h"
+#include "TBufferFile.h"
+#include "RZip.h"
 #include "TPave.h"
+#include "TImage.h"
+#include "TStyle.h"
+#include "RVersion.h"
 
 namespace PlottingFramework
 {
 
 //**************************************************************************************************
 /**
- * Constructor for PlotManager.
+ * Decompresses and deserializes the object of a key from a buffer that holds the complete key as
+ * stored in the file. Other than TKey::ReadObj this does not touch the directory of the key and can
+ * therefore be used concurrently for different keys.
  */
 //**************************************************************************************************
-PlotManager::PlotManager() : mApp(new TApplication("MainApp", 0, nullptr)), mOutputFileName("ResultPlots.root")
+static TObject* read_object(TKey* key, const char* keyBuffer, TFile* file)
+{
+  TClass* objectClass = TClass::GetClass(key->GetClassName());
+  if (!objectClass || !objectClass->IsTObject()) return nullptr;
+  int32_t keyLength = key->GetKeylen();
+  int32_t objectLength = key->GetObjlen();
+
+  TBufferFile buffer(TBuffer::kRead, objectLength + keyLength);
+  buffer.SetParent(file);
+  buffer.SetPidOffset(key->GetPidOffset());
+  if (objectLength > key->GetNbytes() - keyLength) {
+    // the object is stored in one or more compressed blocks
+    auto input = reinterpret_cast<unsigned char*>(const_cast<char*>(keyBuffer + keyLength));
+    auto output = reinterpret_cast<unsigned char*>(buffer.Buffer() + keyLength);
+    int32_t nDecompressed{};
+    while (nDecompressed < objectLength) {
+      int32_t nInput{}, nOutput{}, nBlock{};
+      if (R__unzip_header(&nInput, input, &nBlock) != 0) break;
+      R__unzip(&nInput, input, &nBlock, output, &nOutput);
+      if (!nOutput) break;
+      nDecompressed += nOutput;
+      input += nInput;
+      output += nOutput;
+    }
+    if (nDecompressed != objectLength) return nullptr;
+  } else {
+    std::memcpy(buffer.Buffer() + keyLength, keyBuffer + keyLength, objectLength);
+  }
+  buffer.SetBufferOffset(keyLength);
+
+  int32_t baseOffset = objectClass->GetBaseClassOffset(TObject::Class());
+  if (baseOffset < 0) return nullptr;
+  char* object = static_cast<char*>(objectClass->New());
+  auto obj = reinterpret_cast<TObject*>(object + baseOffset);
+  // register the object to resolve self-references as TKey::ReadObj does; unlike ReadObj the object
+  // is deliberately not added to the directory (e.g. histograms) since it is owned by the caller
+  if (key->GetVersion() > 1) buffer.MapObject(object, objectClass);
+  obj->Streamer(buffer);
+  return obj;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor for PlotManager. The graphical user interface is only initialized once it is needed.
+ */
+//**************************************************************************************************
+PlotManager::PlotManager() : mOutputFileName("ResultPlots.root"), mOutputWriter(new OutputWriter()), mFilePool(new FilePool()), mContainerCache(new ContainerCache())
 {
-  TQObject::Connect("TGMainFrame", "CloseWindow()", "TApplication", gApplication, "Terminate()");
   gErrorIgnoreLevel = kWarning;
+  gROOT->SetBatch(true);
+}
+
+//**************************************************************************************************
+/**
+ * Initializes the graphical user interface required for interactive mode.
+ */
+//**************************************************************************************************
+void PlotManager::InitializeGUI()
+{
+  if (mApp) return;
+  auto startTime = std::chrono::steady_clock::now();
+  gROOT->SetBatch(false);
+  mApp.reset(new TApplication("MainApp", 0, nullptr));
+  TQObject::Connect("TGMainFrame", "CloseWindow()", "TApplication", gApplication, "Terminate()");
 
   // determine OS dependent offset between window and frame
   // (GetWindowTopY gives the current coordinates of the window, but SetWindowPosition moves the frame instead of the window)
@@ -62,6 +150,7 @@ PlotManager::PlotManager() : mApp(new TApplication("MainApp", 0, nullptr)), mOut
   dummyCanvas.SetCanvasSize(1, 1);
   dummyCanvas.SetWindowPosition(50, 50);
   mWindowOffsetY = dummyCanvas.GetWindowTopY() - static_cast<TRootCanvas*>(dummyCanvas.GetCanvasImp())->GetY();
+  DEBUG("Initialized graphical user interface in {} ms.", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
 }
 
 //**************************************************************************************************
@@ -71,38 +160,63 @@ PlotManager::PlotManager() : mApp(new TApplication("MainApp", 0, nullptr)), mOut
 //**************************************************************************************************
 PlotManager::~PlotManager()
 {
-  if (mSaveToRootFile) SavePlotsToFile();
+  CloseBundle();
+  FlushOutput();
+  CloseOutputFile();
 }
 
 //**************************************************************************************************
 /**
- * Save stored plots to .root file.
+ * Writes canvas to the output .root file right away. The directory structure inside the file
+ * corresponds to the figure groups and categories. The file is created by the first request and
+ * updated by further ones (e.g. in watch or server mode).
  */
 //**************************************************************************************************
-void PlotManager::SavePlotsToFile() const
+bool PlotManager::SaveToOutputFile(TCanvas* canvas, const Plot& plot)
 {
-  if (!mPlotLedger.empty()) {
-    TFile outputFile((mOutputDirectory + "/" + mOutputFileName).data(), "RECREATE");
-    if (outputFile.IsZombie()) {
-      return;
+  ScopedTimer timer(Profiler::save_as);
+  if (!mOutputFile) {
+    if (!mOutputWriter->CreateDirectories(mOutputDirectory)) {
+      ERROR("Could not create output directory {}.", mOutputDirectory);
+      return false;
     }
-    outputFile.cd();
-    uint32_t nPlots{0u};
-    for (auto& [uniqueName, canvas] : mPlotLedger) {
-      size_t delimiterPos = uniqueName.find(gNameGroupSeparator.data());
-      string plotName = uniqueName.substr(0, delimiterPos);
-      string subfolder = uniqueName.substr(delimiterPos + gNameGroupSeparator.size());
-      std::replace(subfolder.begin(), subfolder.end(), ':', '/');
-      if (!outputFile.GetDirectory(subfolder.data(), kFALSE, "cd")) {
-        outputFile.mkdir(subfolder.data());
-      }
-      outputFile.cd(subfolder.data());
-      canvas->Write(plotName.data());
-      ++nPlots;
+    string outputFileName = mOutputDirectory + "/" + mOutputFileName;
+    bool isCreated = (outputFileName == mCreatedOutputFile && std::filesystem::exists(outputFileName));
+    mOutputFile.reset(TFile::Open(outputFileName.data(), (isCreated) ? "UPDATE" : "RECREATE"));
+    if (!mOutputFile || mOutputFile->IsZombie()) {
+      ERROR("Could not {} output file {}.", (isCreated) ? "open" : "create", outputFileName);
+      mOutputFile.reset();
+      return false;
     }
-    outputFile.Close();
-    INFO("Saved {} plots to file {}.", nPlots, mOutputFileName);
+    mCreatedOutputFile = outputFileName;
+    if (mOutputFileCompression) mOutputFile->SetCompressionSettings(*mOutputFileCompression);
+    mNumPlotsInOutputFile = 0u;
+  }
+  string subfolder = plot.GetFigureGroup() + ((plot.GetFigureCategory()) ? "/" + *plot.GetFigureCategory() : "");
+  TDirectory* directory = mOutputFile->GetDirectory(subfolder.data());
+  if (!directory) {
+    mOutputFile->mkdir(subfolder.data());
+    directory = mOutputFile->GetDirectory(subfolder.data());
+  }
+  if (!directory || directory->WriteTObject(canvas, plot.GetName().data(), "WriteDelete") <= 0) {
+    ERROR("Could not write plot {} to output file {}.", plot.GetName(), mOutputFileName);
+    return false;
   }
+  ++mNumPlotsInOutputFile;
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Closes output .root file.
+ */
+//**************************************************************************************************
+void PlotManager::CloseOutputFile()
+{
+  if (!mOutputFile) return;
+  mOutputFile->Close();
+  INFO("Saved {} plots to file {}.", mNumPlotsInOutputFile, mOutputFileName);
+  mOutputFile.reset();
 }
 
 //**************************************************************************************************
@@ -113,8 +227,56 @@ void PlotManager::SavePlotsToFile() const
 void PlotManager::ClearDataBuffer()
 {
   mDataBuffer.clear();
+  mInputFileTimestamps.clear();
+  mInputFileContent.clear();
+  mContainerCache->Clear();
 };
 
+//**************************************************************************************************
+/**
+ * Remove all plots and plot templates from the manager.
+ */
+//**************************************************************************************************
+void PlotManager::ClearPlots()
+{
+  mPlots.clear();
+  mPlotTemplates.clear();
+  mPlotsFromFile.clear();
+  mTemplatesFromFile.clear();
+}
+
+//**************************************************************************************************
+/**
+ * Returns the input files that were modified after data was read from them.
+ */
+//**************************************************************************************************
+vector<string> PlotManager::GetModifiedInputFiles() const
+{
+  vector<string> modifiedFiles;
+  for (auto& [fileName, timestamp] : mInputFileTimestamps) {
+    std::error_code errorCode;
+    if (std::filesystem::last_write_time(fileName, errorCode) != timestamp) {
+      modifiedFiles.push_back(fileName);
+    }
+  }
+  return modifiedFiles;
+}
+
+//**************************************************************************************************
+/**
+ * Returns the defined input files together with all files that were registered while reading data from them.
+ */
+//**************************************************************************************************
+vector<string> PlotManager::GetWatchedFiles() const
+{
+  vector<string> inputFileNames = GetInputFileNames();
+  set<string> watchedFiles(inputFileNames.begin(), inputFileNames.end());
+  for (auto& [fileName, timestamp] : mInputFileTimestamps) {
+    watchedFiles.insert(fileName);
+  }
+  return {watchedFiles.begin(), watchedFiles.end()};
+}
+
 //**************************************************************************************************
 /**
  * Sets path for output files. Plots wil be stored in hierarchical structure according to figure groups and categories.
@@ -142,9 +304,60 @@ void PlotManager::SetUseUniquePlotNames(bool useUniquePlotNames)
 //**************************************************************************************************
 void PlotManager::SetOutputFileName(const string& fileName)
 {
+  CloseOutputFile();
   mOutputFileName = fileName;
 }
 
+//**************************************************************************************************
+/**
+ * Compression algorithm ("zlib", "lzma", "lz4" or "zstd") and level (0-9) used for the output root file.
+ */
+//**************************************************************************************************
+void PlotManager::SetOutputFileCompression(const string& algorithm, uint8_t level)
+{
+  const map<string, int32_t> algorithms{{"zlib", 1}, {"lzma", 2}, {"lz4", 4}, {"zstd", 5}};
+  if (algorithms.find(algorithm) == algorithms.end()) {
+    ERROR("Unknown compression algorithm {}.", algorithm);
+    return;
+  }
+  if (level > 9) {
+    ERROR("Compression level must be between 0 and 9.");
+    return;
+  }
+  CloseOutputFile();
+  mOutputFileCompression = 100 * algorithms.at(algorithm) + level;
+}
+
+//**************************************************************************************************
+/**
+ * Number of threads that write the plot files to the output directory in the background.
+ */
+//**************************************************************************************************
+void PlotManager::SetOutputWriterThreads(uint8_t nThreads)
+{
+  mOutputWriter->SetNumThreads(nThreads);
+}
+
+//**************************************************************************************************
+/**
+ * Wait until all plot files are written to disk. Returns false if some of them could not be written.
+ */
+//**************************************************************************************************
+bool PlotManager::FlushOutput()
+{
+  return mOutputWriter->Flush();
+}
+
+//**************************************************************************************************
+/**
+ * Number of plots before and after the currently displayed one that are kept in memory in interactive mode.
+ */
+//**************************************************************************************************
+void PlotManager::SetViewerCacheWindow(uint32_t nNeighbours)
+{
+  mViewerCacheWindow = nNeighbours;
+}
+
 //**************************************************************************************************
 /**
  * Define input file paths for user defined unique inputIdentifier.
@@ -155,13 +368,100 @@ void PlotManager::AddInputDataFiles(const string& inputIdentifier, const vector<
   if (mInputFiles.find(inputIdentifier) != mInputFiles.end()) {
     WARNING("Replacing input identifier {}.", inputIdentifier);
   }
-  mInputFiles[inputIdentifier] = inputFilePathList;
+  vector<string>& inputFiles = mInputFiles[inputIdentifier];
+  inputFiles.clear();
+  for (auto& inputFilePath : inputFilePathList) {
+    // options following the file name are kept for all files matching the pattern
+    auto fileNameOptions = split_string(inputFilePath, ':', true);
+    string options = (fileNameOptions.size() > 1) ? ":" + fileNameOptions[1] : "";
+    auto fileNames = expand_glob(fileNameOptions[0]);
+    if (fileNames.empty()) WARNING("No input files matching {}.", fileNameOptions[0]);
+    for (auto& fileName : fileNames) {
+      inputFiles.push_back(fileName + options);
+    }
+  }
 }
 void PlotManager::AddInputDataFile(const string& inputIdentifier, const string& inputFilePath)
 {
   vector<string> inputFilePathList = {inputFilePath};
   AddInputDataFiles(inputIdentifier, inputFilePathList);
 }
+void PlotManager::ClearInputDataFiles()
+{
+  mInputFiles.clear();
+  mMergedInputs.clear();
+}
+void PlotManager::SetMergeInputFiles(const string& inputIdentifier, bool merge)
+{
+  if (merge) {
+    mMergedInputs.insert(inputIdentifier);
+  } else {
+    mMergedInputs.erase(inputIdentifier);
+  }
+}
+vector<string> PlotManager::GetInputFileNames() const
+{
+  set<string> inputFileNames;
+  for (auto& [inputIdentifier, inputFilePathList] : mInputFiles) {
+    for (auto& inputFilePath : inputFilePathList) {
+      inputFileNames.insert(split_string(inputFilePath, ':', true)[0]);
+    }
+  }
+  return {inputFileNames.begin(), inputFileNames.end()};
+}
+
+//**************************************************************************************************
+/**
+ * Whether to print statistics about reading the input files after creating plots.
+ */
+//**************************************************************************************************
+void PlotManager::SetReportIOStatistics(bool report)
+{
+  mReportIOStatistics = report;
+}
+
+//**************************************************************************************************
+/**
+ * Maximum size of the sequential reads in which neighbouring objects of a directory are fetched
+ * (0: each object is read separately in the order of the directory).
+ */
+//**************************************************************************************************
+void PlotManager::SetReadPrefetchSize(uint32_t megaBytes)
+{
+  mReadPrefetchSize = megaBytes * 1024u * 1024u;
+}
+
+//**************************************************************************************************
+/**
+ * Number of threads that decompress and deserialize the objects read from the input files
+ * (0: all available cores, 1: no additional threads).
+ */
+//**************************************************************************************************
+void PlotManager::SetDecompressionThreads(uint32_t nThreads)
+{
+  mDecompressionThreads = nThreads;
+}
+
+//**************************************************************************************************
+/**
+ * Maximum number of input files that are kept open while the data for the plots are read.
+ */
+//**************************************************************************************************
+void PlotManager::SetMaxOpenInputFiles(uint32_t maxOpenFiles)
+{
+  mFilePool->SetMaxOpenFiles(maxOpenFiles);
+}
+
+//**************************************************************************************************
+/**
+ * Memory limit for lists etc. read from the input files that are kept such that further members can
+ * be taken from them without reading the whole list again (0: no caching).
+ */
+//**************************************************************************************************
+void PlotManager::SetContainerCacheSize(uint32_t megaBytes)
+{
+  mContainerCache->SetMaxSize(static_cast<uint64_t>(megaBytes) * 1024u * 1024u);
+}
 
 //**************************************************************************************************
 /**
@@ -205,11 +505,12 @@ void PlotManager::LoadInputDataFiles(const string& configFileName)
     set<string> allFileNames;
     for (auto& fileEntry : inputPair.second) {
       string fileOrDirName = expand_path(fileEntry.second.get_value<string>());
-      if (str_contains(fileOrDirName, ".root", true) || str_contains(fileOrDirName, ".csv", true)) {
+      auto isExternalFile = [](const string& name) { return CSVReader::IsCSVFile(name) || YODAReader::IsYODAFile(name) || HEPDataReader::IsHEPDataFile(name) || NumPyReader::IsNumPyFile(name); };
+      if (str_contains(fileOrDirName, ".root", true) || isExternalFile(fileOrDirName)) {
         allFileNames.insert(fileOrDirName);
       } else if (std::filesystem::is_directory(fileOrDirName)) {
         for (auto& file : std::filesystem::recursive_directory_iterator(fileOrDirName)) {
-          if (file.path().extension() == ".root" || file.path().extension() == ".csv") {
+          if (file.path().extension() == ".root" || isExternalFile(file.path().string())) {
             allFileNames.insert(file.path().string());
           }
         }
@@ -230,12 +531,15 @@ void PlotManager::AddPlot(Plot& plot)
     ERROR("You cannot use reserved group name 'PLOT_TEMPLATES'!");
   }
   mPlots.erase(std::remove_if(mPlots.begin(), mPlots.end(),
-                              [plot](Plot& curPlot) mutable {
+                              [&plot](Plot& curPlot) {
                                 bool removePlot = curPlot.GetUniqueName() == plot.GetUniqueName();
                                 if (removePlot) WARNING("Plot {} in {} already exists and will be replaced.", curPlot.GetName(), curPlot.GetFigureGroup());
                                 return removePlot;
                               }),
                mPlots.end());
+  for (auto& [plotFileName, uniqueNames] : mPlotsFromFile) {
+    uniqueNames.erase(plot.GetUniqueName());
+  }
   mPlots.push_back(std::move(plot));
 }
 
@@ -248,12 +552,15 @@ void PlotManager::AddPlotTemplate(Plot& plotTemplate)
 {
   plotTemplate.SetFigureGroup("PLOT_TEMPLATES");
   mPlotTemplates.erase(std::remove_if(mPlotTemplates.begin(), mPlotTemplates.end(),
-                                      [plotTemplate](Plot& curPlotTemplate) mutable {
+                                      [&plotTemplate](Plot& curPlotTemplate) {
                                         bool removePlot = curPlotTemplate.GetUniqueName() == plotTemplate.GetUniqueName();
                                         if (removePlot) WARNING("Plot template {} already exists and will be replaced.", curPlotTemplate.GetName());
                                         return removePlot;
                                       }),
                        mPlotTemplates.end());
+  for (auto& [plotFileName, templateNames] : mTemplatesFromFile) {
+    templateNames.erase(plotTemplate.GetName());
+  }
   mPlotTemplates.push_back(std::move(plotTemplate));
 }
 
@@ -307,18 +614,27 @@ void PlotManager::DumpPlot(const string& plotFileName, const string& figureGroup
 //**************************************************************************************************
 /**
  * Read and cache plots defined in xml file.
+ * If the file cannot be parsed, the previously cached plot definitions are kept.
  */
 //**************************************************************************************************
 ptree& PlotManager::ReadPlotTemplatesFromFile(const string& plotFileName)
 {
-  if (mPropertyTreeCache.find(plotFileName) == mPropertyTreeCache.end()) {
+  // re-read the file in case it was modified in the meantime
+  std::error_code errorCode;
+  auto lastModified = std::filesystem::last_write_time(expand_path(plotFileName), errorCode);
+  auto cachedTimestamp = mPropertyTreeTimestamps.find(plotFileName);
+  if (cachedTimestamp == mPropertyTreeTimestamps.end() || cachedTimestamp->second != lastModified) {
+    // remember the timestamp also for broken files, such that they are only read again once modified
+    mPropertyTreeTimestamps[plotFileName] = lastModified;
     try {
       using boost::property_tree::read_xml;
-      read_xml(expand_path(plotFileName), mPropertyTreeCache[plotFileName]);
+      ptree plotTree;
+      read_xml(expand_path(plotFileName), plotTree);
+      mPropertyTreeCache[plotFileName] = std::move(plotTree);
       INFO("Reading plot definitions from {}.", plotFileName);
     } catch (...) {
+      // keep the plot definitions that were read successfully before (if any)
       ERROR("Cannot load file {}.", plotFileName);
-      std::exit(EXIT_FAILURE);
     }
   }
   return mPropertyTreeCache[plotFileName];
@@ -326,24 +642,19 @@ ptree& PlotManager::ReadPlotTemplatesFromFile(const string& plotFileName)
 
 //**************************************************************************************************
 /**
- * Generates plot based on plot template.
+ * Paints plot based on its plot template and the data currently available in the buffer.
  */
 //**************************************************************************************************
-bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
+unique_ptr<TCanvas> PlotManager::PaintPlot(const Plot& plot)
 {
-  // if plot already exists, delete the old one first
-  if (mPlotLedger.find(plot.GetUniqueName()) != mPlotLedger.end()) {
-    ERROR("Plot {} was already created. Replacing it.", plot.GetUniqueName());
-    mPlotLedger.erase(plot.GetUniqueName());
-  }
   if (plot.GetFigureGroup().empty()) {
     ERROR("No figure group was specified for plot {}.", plot.GetName());
-    return false;
+    return nullptr;
   }
-  if (outputMode == "file") {
-    mSaveToRootFile = true;
-  }
-  Plot fullPlot = plot;
+  if (Profiler::IsEnabled()) Profiler::Instance().SetCurrentPlot(plot.GetUniqueName());
+  Logger::SetContext(plot.GetName(), plot.GetFigureGroup());
+  // the painter modifies the plot; the copy shares all unmodified parts with the original
+  Plot fullPlot = plot.SharedCopy();
   if (plot.GetPlotTemplateName()) {
     const string& plotTemplateName = *plot.GetPlotTemplateName();
     auto iterator = std::find_if(
@@ -356,64 +667,19 @@ bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
     }
   }
   PlotPainter painter;
-  bool isInteractiveMode = (outputMode == "interactive");
-  gROOT->SetBatch(!isInteractiveMode);
-  shared_ptr<TCanvas> canvas{painter.GeneratePlot(fullPlot, mDataBuffer)};
-  if (!canvas) return false;
+  unique_ptr<TCanvas> canvas{painter.GeneratePlot(fullPlot, mDataBuffer)};
+  if (!canvas) return nullptr;
   LOG("Created " GREEN_ "{}" _END " from group " YELLOW_ "{}" _END ".", fullPlot.GetName(), fullPlot.GetFigureGroup() + ((fullPlot.GetFigureCategory()) ? "/" + *fullPlot.GetFigureCategory() : ""));
+  return canvas;
+}
 
-  // if interactive mode is specified, open window instead of saving the plot
-  if (isInteractiveMode) {
-    mPlotLedger[plot.GetUniqueName()] = canvas;
-    mPlotViewHistory.push_back(&plot.GetUniqueName());
-    uint32_t curPlotIndex{static_cast<uint32_t>(mPlotViewHistory.size() - 1)};
-
-    // move new canvas to position of previous window
-    int32_t curXpos{};
-    int32_t curYpos{};
-    if (curPlotIndex > 0) {
-      curXpos = mPlotLedger[*mPlotViewHistory[curPlotIndex - 1]]->GetWindowTopX();
-      curYpos = mPlotLedger[*mPlotViewHistory[curPlotIndex - 1]]->GetWindowTopY();
-      canvas->SetWindowPosition(curXpos, curYpos - mWindowOffsetY);
-      static_cast<TRootCanvas*>(mPlotLedger[*mPlotViewHistory[curPlotIndex - 1]]->GetCanvasImp())->UnmapWindow();
-    }
-    canvas->Show();
-    bool boxClicked = false;
-    while (!gSystem->ProcessEvents() && gROOT->GetSelectedPad()) {
-      bool isClick = canvas->GetEvent() == kButton1Double;
-      bool isValidKey = canvas->GetEvent() == kKeyPress && (canvas->GetEventX() == 'a' || canvas->GetEventX() == 's');
-      auto selectedBox = dynamic_cast<TPave*>(canvas->GetSelected());
-      if (isClick && selectedBox) {
-        if (!boxClicked) INFO("Current position of {}: ({:.3g}, {:.3g}).", selectedBox->GetName(), selectedBox->GetX1NDC(), selectedBox->GetY2NDC());
-        boxClicked = true;
-      } else if (isClick || isValidKey) {
-        curXpos = canvas->GetWindowTopX();
-        curYpos = canvas->GetWindowTopY();
-        bool forward = false;
-        if (isValidKey) {
-          forward = (canvas->GetEventX() == 's');
-        } else {
-          forward = ((double_t)canvas->GetEventX() / (double_t)canvas->GetWw() > 0.5);
-        }
-        if (forward) {
-          if (curPlotIndex == mPlotViewHistory.size() - 1) break;
-          ++curPlotIndex;
-        } else {
-          if (curPlotIndex == 0) std::exit(EXIT_FAILURE);
-          --curPlotIndex;
-        }
-        static_cast<TRootCanvas*>(canvas->GetCanvasImp())->UnmapWindow();
-        canvas = mPlotLedger[*mPlotViewHistory[curPlotIndex]];
-        canvas->SetWindowPosition(curXpos, curYpos - mWindowOffsetY);
-        canvas->Show();
-      } else {
-        boxClicked = false;
-      }
-      gSystem->Sleep(20);
-    }
-    return true;
-  }
-
+//**************************************************************************************************
+/**
+ * Generates plot and saves it in the requested output formats.
+ */
+//**************************************************************************************************
+bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
+{
   if (mOutputDirectory.empty()) {
     ERROR("No output directory was specified. Cannot save plot.");
     return true;
@@ -424,38 +690,170 @@ bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
     return true;
   }
 
-  if (outputMode == "file") {
-    mPlotLedger[plot.GetUniqueName()] = canvas;
-    return true;
+  gROOT->SetBatch(true);
+  unique_ptr<TCanvas> canvas = PaintPlot(plot);
+  if (!canvas) return false;
+
+  // the plot is painted only once and then saved in all requested output formats
+  for (auto& outputFormat : split_string(outputMode, ',')) {
+    if (outputFormat == "file") {
+      SaveToOutputFile(canvas.get(), plot);
+      continue;
+    }
+    SavePlot(canvas.get(), plot, outputFormat);
+  }
+  // reset TCandle range options to their default values after drawing data
+  TCandle::SetBoxRange(0.5);
+  TCandle::SetWhiskerRange(0.75);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Shows plots in a window that allows to scroll through them.
+ * Only the current plot and a window of neighbouring plots is kept in memory. The neighbours are
+ * painted while the viewer is idle, all others are (re-)painted once they are requested.
+ */
+//**************************************************************************************************
+void PlotManager::ViewPlots(const vector<Plot*>& plots)
+{
+  if (plots.empty()) return;
+  InitializeGUI();
+  gROOT->SetBatch(false);
+  map<size_t, unique_ptr<TCanvas>> canvasCache; // plotIndex, canvas
+  set<size_t> failedPlots;
+  auto getCanvas = [&](size_t plotIndex) -> TCanvas* {
+    if (failedPlots.find(plotIndex) != failedPlots.end()) return nullptr;
+    auto& canvas = canvasCache[plotIndex];
+    if (!canvas) {
+      canvas = PaintPlot(*plots[plotIndex]);
+      if (!canvas) {
+        ERROR("Plot " GREEN_ "{}" _END " from group " YELLOW_ "{}" _END " could not be created.", plots[plotIndex]->GetName(), plots[plotIndex]->GetFigureGroup());
+        failedPlots.insert(plotIndex);
+        canvasCache.erase(plotIndex);
+        return nullptr;
+      }
+    }
+    return canvas.get();
+  };
+
+  size_t curPlotIndex{};
+  TCanvas* canvas{};
+  while (!(canvas = getCanvas(curPlotIndex))) {
+    if (++curPlotIndex == plots.size()) return;
+  }
+  canvas->Show();
+
+  int32_t curXpos{};
+  int32_t curYpos{};
+  bool boxClicked = false;
+  while (!gSystem->ProcessEvents() && gROOT->GetSelectedPad()) {
+    bool isClick = canvas->GetEvent() == kButton1Double;
+    bool isValidKey = canvas->GetEvent() == kKeyPress && (canvas->GetEventX() == 'a' || canvas->GetEventX() == 's');
+    auto selectedBox = dynamic_cast<TPave*>(canvas->GetSelected());
+    if (isClick && selectedBox) {
+      if (!boxClicked) INFO("Current position of {}: ({:.3g}, {:.3g}).", selectedBox->GetName(), selectedBox->GetX1NDC(), selectedBox->GetY2NDC());
+      boxClicked = true;
+    } else if (isClick || isValidKey) {
+      curXpos = canvas->GetWindowTopX();
+      curYpos = canvas->GetWindowTopY();
+      bool forward = false;
+      if (isValidKey) {
+        forward = (canvas->GetEventX() == 's');
+      } else {
+        forward = ((double_t)canvas->GetEventX() / (double_t)canvas->GetWw() > 0.5);
+      }
+      // skip plots that cannot be painted
+      TCanvas* nextCanvas{};
+      do {
+        if (forward) {
+          if (curPlotIndex == plots.size() - 1) return;
+          ++curPlotIndex;
+        } else {
+          if (curPlotIndex == 0) std::exit(EXIT_FAILURE);
+          --curPlotIndex;
+        }
+      } while (!(nextCanvas = getCanvas(curPlotIndex)));
+      static_cast<TRootCanvas*>(canvas->GetCanvasImp())->UnmapWindow();
+      canvas = nextCanvas;
+      canvas->SetWindowPosition(curXpos, curYpos - mWindowOffsetY);
+      canvas->Show();
+
+      // evict canvases outside the cache window
+      for (auto it = canvasCache.begin(); it != canvasCache.end();) {
+        bool isOutside = (it->first + mViewerCacheWindow < curPlotIndex) || (it->first > curPlotIndex + mViewerCacheWindow);
+        it = (isOutside) ? canvasCache.erase(it) : std::next(it);
+      }
+    } else {
+      boxClicked = false;
+      // use idle time to paint the closest neighbour that is not yet available
+      for (size_t distance = 1; distance <= mViewerCacheWindow; ++distance) {
+        if (curPlotIndex + distance < plots.size() && !canvasCache.count(curPlotIndex + distance) && !failedPlots.count(curPlotIndex + distance)) {
+          getCanvas(curPlotIndex + distance);
+          break;
+        }
+        if (curPlotIndex >= distance && !canvasCache.count(curPlotIndex - distance) && !failedPlots.count(curPlotIndex - distance)) {
+          getCanvas(curPlotIndex - distance);
+          break;
+        }
+      }
+    }
+    gSystem->Sleep(20);
   }
+}
 
+//**************************************************************************************************
+/**
+ * Saves painted plot to disk in the specified format.
+ * Image formats can be refined via 'png:<scale>' (resolution) and 'thumb:<width>' (small png preview).
+ */
+//**************************************************************************************************
+void PlotManager::SavePlot(TCanvas* canvas, const Plot& plot, const string& outputFormat)
+{
+  ScopedTimer timer(Profiler::save_as);
   bool isGif = false;
   static string gifName;
   static string gifFolderName;
   string gifRepRate = "+50"; // number of centiseconds between frames
 
+  auto formatOptions = split_string(outputFormat, ':', true);
+  const string& format = formatOptions[0];
+  double_t imageScale{1.};
+  uint32_t thumbnailWidth{200u};
+  bool isThumbnail = false;
+
   string fileEnding;
-  if (outputMode == "pdf") {
+  string fileSuffix;
+  if (format == "pdf") {
     fileEnding = ".pdf";
-  } else if (outputMode == "macro") {
+  } else if (format == "macro") {
     fileEnding = ".C";
-  } else if (outputMode == "png") {
+  } else if (format == "png") {
     fileEnding = ".png";
-  } else if (outputMode == "eps") {
+    if (formatOptions.size() > 1) imageScale = std::stod(formatOptions[1]);
+  } else if (format == "thumb") {
+    fileEnding = ".png";
+    fileSuffix = "_thumb";
+    isThumbnail = true;
+    if (formatOptions.size() > 1) thumbnailWidth = std::stoul(formatOptions[1]);
+  } else if (format == "bundle") {
+    SaveToBundle(canvas, plot, formatOptions.size() > 1 && formatOptions[1] == "group");
+    return;
+  } else if (format == "eps") {
     fileEnding = ".eps";
-  } else if (outputMode == "svg") {
+  } else if (format == "svg") {
     fileEnding = ".svg";
-  } else if (str_contains(outputMode, "gif")) {
+  } else if (str_contains(format, "gif")) {
     fileEnding = ".gif";
     isGif = true;
-    if (auto delimPos = outputMode.find("+"); delimPos != string::npos) {
-      gifRepRate = outputMode.substr(delimPos);
+    if (auto delimPos = format.find("+"); delimPos != string::npos) {
+      gifRepRate = format.substr(delimPos);
     }
   }
 
   if (fileEnding.empty()) {
     ERROR("No valid output format was specified. Cannot save plot.");
-    return true;
+    return;
   }
 
   string fileName = (mUseUniquePlotNames) ? plot.GetUniqueName() : plot.GetName();
@@ -464,7 +862,7 @@ bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
   // create output folders and files
   string folderName = mOutputDirectory + "/" + plot.GetFigureGroup();
   if (plot.GetFigureCategory()) folderName += "/" + *plot.GetFigureCategory();
-  string fullName = folderName + "/" + fileName + fileEnding;
+  string fullName = folderName + "/" + fileName + fileSuffix + fileEnding;
 
   if (isGif) {
     if (gifName.empty()) {
@@ -477,51 +875,171 @@ bool PlotManager::GeneratePlot(const Plot& plot, const string& outputMode)
       fullName = gifName;
       folderName = gifFolderName;
     }
+    // frames are appended to the same file, which therefore cannot be staged
+    if (!mOutputWriter->CreateDirectories(folderName)) {
+      ERROR("Could not create output directory {}.", folderName);
+      return;
+    }
+    canvas->SaveAs(fullName.data());
+    return;
   }
-  gSystem->Exec((string("mkdir -p ") + folderName).data());
-  canvas->SaveAs(fullName.data());
-  // reset TCandle range options to their default values after drawing data
-  TCandle::SetBoxRange(0.5);
-  TCandle::SetWhiskerRange(0.75);
-  return true;
+
+  // write to local staging area first, the output writer then moves the file to its destination in the background
+  string targetName = fullName;
+  fullName = mOutputWriter->GetStagingPath(fileName + fileSuffix + fileEnding);
+  if (fullName.empty()) {
+    ERROR("Could not create staging area for output files.");
+    return;
+  }
+  if (isThumbnail || imageScale != 1.) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 24, 0)
+    if (!isThumbnail) {
+      // render at higher resolution instead of upscaling the pixmap
+      gStyle->SetImageScaling(imageScale);
+      canvas->SaveAs(fullName.data());
+      gStyle->SetImageScaling(1.);
+      mOutputWriter->Commit(fullName, targetName);
+      return;
+    }
+#endif
+    std::unique_ptr<TImage> image{TImage::Create()};
+    image->FromPad(canvas);
+    double_t scale = (isThumbnail) ? thumbnailWidth / static_cast<double_t>(image->GetWidth()) : imageScale;
+    image->Scale(static_cast<uint32_t>(scale * image->GetWidth()), static_cast<uint32_t>(scale * image->GetHeight()));
+    image->WriteImage(fullName.data());
+  } else {
+    canvas->SaveAs(fullName.data());
+  }
+  mOutputWriter->Commit(fullName, targetName);
 }
 
 //**************************************************************************************************
 /**
- * Creates plots.
+ * Appends plot as new page to the multi-page pdf of its figure group (and category).
  */
 //**************************************************************************************************
-void PlotManager::CreatePlots(const string& figureGroup, const string& figureCategory,
-                              vector<string> plotNames, const string& outputMode)
+void PlotManager::SaveToBundle(TCanvas* canvas, const Plot& plot, bool perFigureGroup)
 {
-  // first determine which data needs to be loaded
-  vector<Plot*> selectedPlots;
-  map<int32_t, set<int32_t>> requiredData;
-
-  for (auto& plot : mPlots) {
-    if (!figureGroup.empty() && !(plot.GetFigureGroup() == figureGroup)) {
-      continue;
-    } else if (!figureCategory.empty() && !(plot.GetFigureCategory() && *plot.GetFigureCategory() == figureCategory)) {
-      continue;
-    } else if (!plotNames.empty() && std::find(plotNames.begin(), plotNames.end(), plot.GetName()) == plotNames.end()) {
-      continue;
-    }
-
-    if (!plotNames.empty()) {
-      plotNames.erase(std::remove(plotNames.begin(), plotNames.end(), plot.GetName()), plotNames.end());
+  string bundleName = mOutputDirectory + "/" + plot.GetFigureGroup();
+  if (!perFigureGroup && plot.GetFigureCategory()) bundleName += "/" + *plot.GetFigureCategory();
+  bundleName += ".pdf";
+
+  if (bundleName != mBundleName) {
+    CloseBundle();
+    string stagingName = mOutputWriter->GetStagingPath(std::filesystem::path(bundleName).filename().string());
+    if (stagingName.empty()) {
+      ERROR("Could not create staging area for output files.");
+      return;
     }
-    selectedPlots.push_back(&plot);
+    mBundleName = bundleName;
+    mBundleStagingName = stagingName;
+    canvas->Print((mBundleStagingName + "[").data());
+  }
+  string plotName = (mUseUniquePlotNames) ? plot.GetUniqueName() : plot.GetName();
+  canvas->Print(mBundleStagingName.data(), ("Title:" + plotName).data());
+  mBundleContent.push_back(plotName);
+}
 
-    // determine which input data are needed for plots
-    for (auto& [padID, pad] : plot.GetPads()) {
-      for (auto& data : pad.GetData()) {
-        mDataBuffer[data->GetInputID()][data->GetName()];
-        if (data->GetType() == "ratio") {
-          const auto& ratio = std::dynamic_pointer_cast<Plot::Pad::Ratio>(data);
-          mDataBuffer[ratio->GetDenomIdentifier()][ratio->GetDenomName()];
-        }
-      }
+//**************************************************************************************************
+/**
+ * Closes currently open multi-page pdf and writes table of contents (page number and plot name) next to it.
+ */
+//**************************************************************************************************
+void PlotManager::CloseBundle()
+{
+  if (mBundleName.empty()) return;
+  TCanvas closingCanvas("closingCanvas", "closingCanvas", 1, 1);
+  closingCanvas.Print((mBundleStagingName + "]").data());
+  mOutputWriter->Commit(mBundleStagingName, mBundleName);
+
+  string tocName = std::filesystem::path(mBundleName).replace_extension(".toc").string();
+  string tocStagingName = mOutputWriter->GetStagingPath(std::filesystem::path(tocName).filename().string());
+  std::ofstream tocFile(tocStagingName);
+  if (tocFile) {
+    tocFile << "# page\tplot" << std::endl;
+    for (size_t page = 0; page < mBundleContent.size(); ++page) {
+      tocFile << page + 1 << "\t" << mBundleContent[page] << std::endl;
     }
+    tocFile.close();
+    mOutputWriter->Commit(tocStagingName, tocName);
+  } else {
+    ERROR("Could not write table of contents for {}.", mBundleName);
+  }
+  LOG("Saved {} plots in {}.", mBundleContent.size(), mBundleName);
+  mBundleName.clear();
+  mBundleStagingName.clear();
+  mBundleContent.clear();
+}
+
+//**************************************************************************************************
+/**
+ * Checks if the comma separated list of output formats is valid.
+ */
+//**************************************************************************************************
+bool PlotManager::IsValidOutputMode(const string& outputMode)
+{
+  auto outputFormats = split_string(outputMode, ',');
+  if (outputFormats.empty()) return false;
+  for (auto& outputFormat : outputFormats) {
+    auto formatOptions = split_string(outputFormat, ':', true);
+    const string& format = formatOptions[0];
+    if (format == "interactive") {
+      if (outputFormats.size() > 1) {
+        ERROR("Interactive mode cannot be combined with other output formats.");
+        return false;
+      }
+      continue;
+    }
+    bool isValidFormat = (format == "pdf" || format == "macro" || format == "png" || format == "thumb" || format == "eps" || format == "svg" || format == "file" || format == "bundle" || format.substr(0, 3) == "gif");
+    if (!isValidFormat) {
+      ERROR("Unknown output format '{}'.", outputFormat);
+      return false;
+    }
+    if (format == "bundle" && formatOptions.size() > 1) {
+      if (formatOptions[1] != "group" && formatOptions[1] != "category") {
+        ERROR("Invalid option '{}' for output format '{}'.", formatOptions[1], format);
+        return false;
+      }
+    } else if (formatOptions.size() > 1) {
+      if (format != "png" && format != "thumb") {
+        ERROR("Output format '{}' does not accept options.", format);
+        return false;
+      }
+      try {
+        if (std::stod(formatOptions[1]) <= 0.) throw std::invalid_argument("");
+      } catch (...) {
+        ERROR("Invalid option '{}' for output format '{}'.", formatOptions[1], format);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Creates plots.
+ */
+//**************************************************************************************************
+void PlotManager::CreatePlots(const string& figureGroup, const string& figureCategory,
+                              vector<string> plotNames, const string& outputMode)
+{
+  if (!IsValidOutputMode(outputMode)) return;
+
+  vector<Plot*> selectedPlots;
+  for (auto& plot : mPlots) {
+    if (!figureGroup.empty() && !(plot.GetFigureGroup() == figureGroup)) {
+      continue;
+    } else if (!figureCategory.empty() && !(plot.GetFigureCategory() && *plot.GetFigureCategory() == figureCategory)) {
+      continue;
+    } else if (!plotNames.empty() && std::find(plotNames.begin(), plotNames.end(), plot.GetName()) == plotNames.end()) {
+      continue;
+    }
+
+    if (!plotNames.empty()) {
+      plotNames.erase(std::remove(plotNames.begin(), plotNames.end(), plot.GetName()), plotNames.end());
+    }
+    selectedPlots.push_back(&plot);
   }
 
   // were definitions for all requested plots available?
@@ -530,13 +1048,240 @@ void PlotManager::CreatePlots(const string& figureGroup, const string& figureCat
       WARNING("Could not find plot " GREEN_ "{}" _END " in group " YELLOW_ "{}" _END ".", plotName, figureGroup + ((!figureCategory.empty()) ? "/" + figureCategory : ""));
     }
   }
+  CreateSelectedPlots(selectedPlots, outputMode);
+}
+
+//**************************************************************************************************
+/**
+ * Loads the input data required by the selected plots and creates them.
+ */
+//**************************************************************************************************
+void PlotManager::CreateSelectedPlots(vector<Plot*>& selectedPlots, const string& outputMode)
+{
+  // first determine which data needs to be loaded
+  for (auto plot : selectedPlots) {
+    for (auto dataKey : GetRequiredData(*plot)) {
+      mDataBuffer[dataKey];
+    }
+  }
+
+  if (str_contains(outputMode, "bundle")) {
+    // plots of the same figure group and category must be consecutive to end up in the same multi-page pdf
+    std::stable_sort(selectedPlots.begin(), selectedPlots.end(), [](Plot* a, Plot* b) {
+      return std::make_tuple(a->GetFigureGroup(), a->GetFigureCategory().value_or("")) < std::make_tuple(b->GetFigureGroup(), b->GetFigureCategory().value_or(""));
+    });
+  }
 
   if (!FillBuffer()) PrintBufferStatus(true);
+  mFilePool->Clear();
+  if (outputMode == "interactive") {
+    if (mReportIOStatistics) PrintIOStatistics();
+    ViewPlots(selectedPlots);
+    return;
+  }
   // generate plots
   for (auto plot : selectedPlots) {
     if (!GeneratePlot(*plot, outputMode))
       ERROR("Plot " GREEN_ "{}" _END " from group " YELLOW_ "{}" _END " could not be created.", plot->GetName(), plot->GetFigureGroup() + ((plot->GetFigureCategory()) ? "/" + *plot->GetFigureCategory() : ""));
   }
+  CloseBundle();
+  FlushOutput();
+  // finalize the output file, the process might keep running (watch or server mode)
+  CloseOutputFile();
+  if (mReportIOStatistics) PrintIOStatistics();
+}
+
+//**************************************************************************************************
+/**
+ * Returns input identifiers and names of all data needed for the plot.
+ */
+//**************************************************************************************************
+vector<data_key_t> PlotManager::GetRequiredData(const Plot& plot) const
+{
+  vector<data_key_t> requiredData;
+  for (auto& [padID, pad] : plot.GetPads()) {
+    for (auto& data : pad.GetData()) {
+      requiredData.push_back(data->GetDataKey());
+      if (data->GetType() == "ratio") {
+        const auto* ratio = data.As<Plot::Pad::Ratio>();
+        requiredData.push_back(ratio->GetDenomDataKey());
+      }
+    }
+  }
+  return requiredData;
+}
+
+//**************************************************************************************************
+/**
+ * Removes data read from modified input files from the buffer, such that it is read again when needed.
+ * Returns all buffer entries that need to be (re-)read, which also includes data that was missing
+ * so far and might now be available in the modified files.
+ */
+//**************************************************************************************************
+set<std::pair<string, string>> PlotManager::InvalidateModifiedInputFiles()
+{
+  set<std::pair<string, string>> invalidatedData;
+  for (auto& fileName : GetModifiedInputFiles()) {
+    INFO("Input file {} was modified.", fileName);
+    for (auto dataKey : mInputFileContent[fileName]) {
+      mDataBuffer[dataKey].reset();
+      // also covers files that are not input files themselves (e.g. numpy sidecar files)
+      invalidatedData.emplace(GetInputID(dataKey), GetDataName(dataKey));
+    }
+    mInputFileContent.erase(fileName);
+    RegisterInputFile(fileName);
+
+    for (auto& [inputID, inputFileNames] : mInputFiles) {
+      bool usesFile = std::any_of(inputFileNames.begin(), inputFileNames.end(), [&](auto& inputFileName) { return split_string(inputFileName, ':', true)[0] == fileName; });
+      if (!usesFile) continue;
+      for (auto& [dataKey, dataPtr] : mDataBuffer) {
+        if (!dataPtr && GetInputID(dataKey) == inputID) invalidatedData.emplace(inputID, GetDataName(dataKey));
+      }
+    }
+  }
+  return invalidatedData;
+}
+
+//**************************************************************************************************
+/**
+ * Re-creates only plots that are affected by modifications of the plot definitions or input files since they were last created.
+ * Plot definitions that did not change are not parsed again and only modified data is read from the input files.
+ */
+//**************************************************************************************************
+bool PlotManager::UpdatePlots(const string& plotFileName, const string& outputMode,
+                              const string& plotName, const string& group, const string& category)
+{
+  if (!IsValidOutputMode(outputMode)) return false;
+  set<string> modifiedPlots; // unique names
+
+  // multi-page pdfs are re-created as a whole and therefore need all plots of the affected bundles
+  bool isBundle = str_contains(outputMode, "bundle");
+  bool isBundlePerFigureGroup = str_contains(outputMode, "bundle:group");
+  auto getBundle = [&](const Plot& plot) {
+    return plot.GetFigureGroup() + ((!isBundlePerFigureGroup && plot.GetFigureCategory()) ? "/" + *plot.GetFigureCategory() : "");
+  };
+  set<string> affectedBundles;
+
+  // compare modified plot definitions with the ones read before
+  ptree previousTree;
+  if (auto cachedTree = mPropertyTreeCache.find(plotFileName); cachedTree != mPropertyTreeCache.end()) {
+    previousTree = cachedTree->second;
+  }
+  ptree& inputTree = ReadPlotTemplatesFromFile(plotFileName);
+  if (inputTree != previousTree) {
+    std::regex groupRegex{group};
+    std::regex categoryRegex{category};
+    std::regex plotNameRegex{plotName};
+    set<string> modifiedTemplates;
+    set<string> definedTemplates;
+    set<string> definedPlots;
+
+    for (auto& [groupKey, groupTree] : inputTree) {
+      string groupIdentifier = groupKey.substr(string("GROUP::").size());
+      bool isTemplate = (groupIdentifier == "PLOT_TEMPLATES");
+      if (!isTemplate && !std::regex_match(groupIdentifier, groupRegex)) {
+        continue;
+      }
+      auto previousGroupTree = previousTree.find(groupKey);
+      for (auto& [plotKey, plotTree] : groupTree) {
+        bool isModified = true;
+        if (previousGroupTree != previousTree.not_found()) {
+          auto previousPlotTree = previousGroupTree->second.find(plotKey);
+          isModified = (previousPlotTree == previousGroupTree->second.not_found() || previousPlotTree->second != plotTree);
+        }
+        try {
+          if (isTemplate) {
+            const string& templateName = plotTree.get<string>("name");
+            definedTemplates.insert(templateName);
+            if (!isModified) continue;
+            Plot plot(plotTree);
+            modifiedTemplates.insert(plot.GetName());
+            mPlotTemplates.erase(std::remove_if(mPlotTemplates.begin(), mPlotTemplates.end(), [&](Plot& curPlot) { return curPlot.GetName() == plot.GetName(); }), mPlotTemplates.end());
+            AddPlotTemplate(plot);
+            mTemplatesFromFile[plotFileName].insert(templateName);
+            continue;
+          }
+          const string& curPlotName = plotTree.get<string>("name");
+          optional<string> figureCategory;
+          read_from_tree(plotTree, figureCategory, "figure_category");
+          if (!std::regex_match(figureCategory.value_or(""), categoryRegex) || !std::regex_match(curPlotName, plotNameRegex)) {
+            continue;
+          }
+          string uniqueName = curPlotName + gNameGroupSeparator + plotTree.get<string>("figure_group") + ((figureCategory) ? "/" + *figureCategory : "");
+          definedPlots.insert(uniqueName);
+          bool isLoaded = std::any_of(mPlots.begin(), mPlots.end(), [&](Plot& curPlot) { return curPlot.GetUniqueName() == uniqueName; });
+          if (!isModified && isLoaded) continue;
+
+          Plot plot(plotTree);
+          mPlots.erase(std::remove_if(mPlots.begin(), mPlots.end(), [&](Plot& curPlot) { return curPlot.GetUniqueName() == uniqueName; }), mPlots.end());
+          AddPlot(plot);
+          mPlotsFromFile[plotFileName].insert(uniqueName);
+          modifiedPlots.insert(uniqueName);
+        } catch (...) {
+          ERROR("Could not generate plot {} from XML file.", plotKey);
+        }
+      }
+    }
+    // forget about templates and requested plots that were removed from the definitions file
+    auto& templatesFromFile = mTemplatesFromFile[plotFileName];
+    for (auto templateName = templatesFromFile.begin(); templateName != templatesFromFile.end();) {
+      if (definedTemplates.find(*templateName) != definedTemplates.end()) {
+        ++templateName;
+        continue;
+      }
+      mPlotTemplates.erase(std::remove_if(mPlotTemplates.begin(), mPlotTemplates.end(), [&](Plot& curPlot) { return curPlot.GetName() == *templateName; }), mPlotTemplates.end());
+      modifiedTemplates.insert(*templateName);
+      templateName = templatesFromFile.erase(templateName);
+    }
+    auto& plotsFromFile = mPlotsFromFile[plotFileName];
+    auto isRemoved = [&](Plot& plot) {
+      if (plotsFromFile.find(plot.GetUniqueName()) == plotsFromFile.end() || definedPlots.find(plot.GetUniqueName()) != definedPlots.end()) return false;
+      return std::regex_match(plot.GetFigureGroup(), groupRegex) && std::regex_match(plot.GetFigureCategory().value_or(""), categoryRegex) && std::regex_match(plot.GetName(), plotNameRegex);
+    };
+    mPlots.erase(std::remove_if(mPlots.begin(), mPlots.end(), [&](Plot& plot) {
+                   if (!isRemoved(plot)) return false;
+                   plotsFromFile.erase(plot.GetUniqueName());
+                   if (isBundle) affectedBundles.insert(getBundle(plot));
+                   return true;
+                 }),
+                 mPlots.end());
+    for (auto& plot : mPlots) {
+      if (plot.GetPlotTemplateName() && modifiedTemplates.find(*plot.GetPlotTemplateName()) != modifiedTemplates.end()) {
+        modifiedPlots.insert(plot.GetUniqueName());
+      }
+    }
+  }
+
+  // find plots that depend on data from modified input files
+  set<data_key_t> invalidatedData;
+  for (auto& [inputID, dataName] : InvalidateModifiedInputFiles()) {
+    invalidatedData.insert(MakeDataKey(inputID, dataName));
+  }
+  vector<Plot*> selectedPlots;
+  for (auto& plot : mPlots) {
+    bool isAffected = (modifiedPlots.find(plot.GetUniqueName()) != modifiedPlots.end());
+    if (!isAffected) {
+      auto requiredData = GetRequiredData(plot);
+      isAffected = std::any_of(requiredData.begin(), requiredData.end(), [&](auto& data) { return invalidatedData.find(data) != invalidatedData.end(); });
+    }
+    if (isAffected) selectedPlots.push_back(&plot);
+  }
+  if (isBundle) {
+    for (auto plot : selectedPlots) {
+      affectedBundles.insert(getBundle(*plot));
+    }
+    selectedPlots.clear();
+    for (auto& plot : mPlots) {
+      if (affectedBundles.find(getBundle(plot)) != affectedBundles.end()) selectedPlots.push_back(&plot);
+    }
+  }
+  if (selectedPlots.empty()) {
+    INFO("All plots are up to date.");
+    return true;
+  }
+  INFO("Updating {} plot{}.", selectedPlots.size(), (selectedPlots.size() == 1) ? "" : "s");
+  CreateSelectedPlots(selectedPlots, outputMode);
+  return true;
 }
 
 //**************************************************************************************************
@@ -547,52 +1292,84 @@ void PlotManager::CreatePlots(const string& figureGroup, const string& figureCat
 bool PlotManager::FillBuffer()
 {
   bool success = true;
-  for (auto& [inputID, buffer] : mDataBuffer) {
-    unordered_map<string, vector<string>> requiredData; // subdir, names
-    for (auto& [dataName, dataPtr] : buffer) {
-      if (dataPtr) continue;
-      auto pathPos = dataName.find_last_of("/");
-      string path;
-      string name = dataName;
-      if (pathPos != string::npos) {
-        path = name.substr(0, pathPos);
-        name.erase(0, pathPos + 1);
-      }
-      requiredData[std::move(path)].push_back(std::move(name));
+  map<string, unordered_map<string, vector<string>>> missingData; // inputID, subdir, names
+  map<string, vector<string>> missingTreeData;                     // inputID, histograms to be filled from trees
+  for (auto& [dataKey, dataPtr] : mDataBuffer) {
+    if (dataPtr) continue;
+    const string& dataName = GetDataName(dataKey);
+    if (tree_request_t::IsTreeRequest(dataName)) {
+      missingTreeData[GetInputID(dataKey)].push_back(dataName);
+      continue;
     }
+    auto pathPos = dataName.find_last_of("/");
+    string path;
+    string name = dataName;
+    if (pathPos != string::npos) {
+      path = name.substr(0, pathPos);
+      name.erase(0, pathPos + 1);
+    }
+    missingData[GetInputID(dataKey)][std::move(path)].push_back(std::move(name));
+  }
 
+  for (auto& [inputID, requiredData] : missingData) {
+    if (mMergedInputs.find(inputID) != mMergedInputs.end()) {
+      success &= MergeInputData(inputID, requiredData);
+      continue;
+    }
     // open all input files belonging to the current inputID and extract the data
     for (auto& inputFileName : mInputFiles[inputID]) {
       if (requiredData.empty()) break;
-      if (str_contains(inputFileName, ".csv", true)) {
-        string graphName = inputFileName.substr(inputFileName.rfind('/') + 1, inputFileName.rfind(".csv") - inputFileName.rfind('/') - 1);
-        ReadDataCSV(inputFileName, graphName, inputID);
-        vector<string>& names = requiredData[""];
-        names.erase(std::remove_if(names.begin(), names.end(), [&](auto& name) { return name == graphName; }), names.end());
-        if (names.empty()) requiredData.erase("");
+      bool isCSV = CSVReader::IsCSVFile(inputFileName) && !HEPDataReader::IsHEPDataFile(inputFileName);
+      if (isCSV || YODAReader::IsYODAFile(inputFileName) || HEPDataReader::IsHEPDataFile(inputFileName) || NumPyReader::IsNumPyFile(inputFileName)) {
+        string fileName = split_string(inputFileName, ':', true)[0];
+        vector<string> requiredNames;
+        for (auto& [path, names] : requiredData) {
+          for (auto& name : names) {
+            requiredNames.push_back((path.empty()) ? name : path + "/" + name);
+          }
+        }
+        RegisterInputFile(fileName);
+        auto dataNames = (isCSV) ? ReadDataCSV(inputFileName, inputID, requiredNames) : ReadDataExternal(fileName, inputID, requiredNames);
+        for (auto& dataName : dataNames) {
+          mInputFileContent[fileName].push_back(MakeDataKey(inputID, dataName));
+          auto pathPos = dataName.find_last_of('/');
+          string path = (pathPos != string::npos) ? dataName.substr(0, pathPos) : "";
+          string name = (pathPos != string::npos) ? dataName.substr(pathPos + 1) : dataName;
+          vector<string>& names = requiredData[path];
+          names.erase(std::remove(names.begin(), names.end(), name), names.end());
+          if (names.empty()) requiredData.erase(path);
+        }
+        continue;
       }
       if (!str_contains(inputFileName, ".root", true)) continue;
       // check if only a sub-folder in input file should be searched
       auto fileNamePath = split_string(inputFileName, ':');
       string& fileName = fileNamePath[0];
 
+      // missing files are registered as well, such that they are read once they appear
+      RegisterInputFile(fileName);
       if (!std::filesystem::exists(fileName)) {
         WARNING("Input file {} not found.", fileName);
         continue;
       }
-      TFile inputFile(fileName.data(), "READ");
-      if (inputFile.IsZombie()) {
+      auto& ioStats = mIOStatistics[{inputID, fileName}];
+      // the file stays open for other inputs that use it
+      TFile* inputFile = mFilePool->Open(fileName);
+      if (!inputFile) {
         WARNING("Cannot open input file {}.", fileName);
         continue;
       }
+      int64_t bytesRead = inputFile->GetBytesRead();
+      int32_t readCalls = inputFile->GetReadCalls();
 
-      TObject* folder = &inputFile;
+      TObject* folder = inputFile;
 
       // find top level entry point for this input file
       if (fileNamePath.size() > 1) {
         auto filePath = split_string(fileNamePath[1], '/');
         // append sub-specification from input name
-        folder = FindSubDirectory(folder, filePath);
+        ScopedTimer lookupTimer(Profiler::key_lookup, fileName);
+        folder = FindSubDirectory(mFilePool->GetDirectory(inputFile, filePath), filePath);
         if (!folder) {
           ERROR("Subdirectory {} not found in file {}.", fileNamePath[1], fileName);
           return false;
@@ -602,14 +1379,23 @@ bool PlotManager::FillBuffer()
       vector<string> emptySubDirs;
       for (auto& [pathStr, names] : requiredData) {
         auto path = split_string(pathStr, '/');
-        TObject* subfolder = FindSubDirectory(folder, path);
+        ScopedTimer lookupTimer(Profiler::key_lookup, fileName);
+        TObject* subfolder = (folder->InheritsFrom(TDirectory::Class())) ? FindSubDirectory(mFilePool->GetDirectory(static_cast<TDirectory*>(folder), path), path) : FindSubDirectory(folder, path);
+        lookupTimer.Stop();
         if (subfolder) {
           // recursively traverse the file and look for input files
           string prefix = (pathStr.empty()) ? "" : pathStr + "/";
           string suffix = gNameGroupSeparator + inputID;
-          ReadData(subfolder, names, prefix, suffix, inputID);
-          // in case a subdirectory was opened, properly delete it
-          if (!path.empty() && subfolder != &inputFile) {
+          vector<string> searchedNames = names;
+          ReadData(subfolder, names, prefix, suffix, inputID, fileName);
+          // remember where the data was found
+          for (auto& name : searchedNames) {
+            if (std::find(names.begin(), names.end(), name) == names.end()) {
+              mInputFileContent[fileName].push_back(MakeDataKey(inputID, prefix + name));
+            }
+          }
+          // in case a sub-list was opened, properly delete it (directories belong to the file)
+          if (!path.empty() && !subfolder->InheritsFrom(TDirectory::Class())) {
             delete subfolder;
             subfolder = nullptr;
           }
@@ -617,10 +1403,13 @@ bool PlotManager::FillBuffer()
         if (names.empty()) emptySubDirs.push_back(pathStr);
       }
       // finally also remove top level folder
-      if (folder != &inputFile) {
+      if (!folder->InheritsFrom(TDirectory::Class())) {
         delete folder;
         folder = nullptr;
       }
+      ioStats.bytesRead += inputFile->GetBytesRead() - bytesRead;
+      ioStats.readCalls += inputFile->GetReadCalls() - readCalls;
+      ioStats.nextOffset = -1;
 
       for (auto& pathStr : emptySubDirs) {
         requiredData.erase(pathStr);
@@ -628,9 +1417,269 @@ bool PlotManager::FillBuffer()
     }
     success &= requiredData.empty();
   }
+
+  // histograms that are filled on the fly from trees in the root input files
+  for (auto& [inputID, requestNames] : missingTreeData) {
+    vector<string> treeFileNames;
+    for (auto& inputFileName : mInputFiles[inputID]) {
+      if (!str_contains(inputFileName, ".root", true)) continue;
+      string fileName = split_string(inputFileName, ':', true)[0];
+      // missing files are registered as well, such that they are read once they appear
+      RegisterInputFile(fileName);
+      if (!std::filesystem::exists(fileName)) {
+        WARNING("Input file {} not found.", fileName);
+        continue;
+      }
+      treeFileNames.push_back(inputFileName);
+    }
+    if (treeFileNames.empty()) {
+      success = false;
+      continue;
+    }
+    TreeFiller treeFiller(mTreeCacheFileName, mEventLoopThreads);
+    success &= treeFiller.Fill(treeFileNames, requestNames, inputID + ": ");
+    for (auto& [name, obj] : treeFiller.GetObjects()) {
+      static_cast<TNamed*>(obj.get())->SetName((name + gNameGroupSeparator + inputID).data());
+      auto dataKey = MakeDataKey(inputID, name);
+      for (auto& inputFileName : treeFileNames) {
+        mInputFileContent[split_string(inputFileName, ':', true)[0]].push_back(dataKey);
+      }
+      mDataBuffer[dataKey] = std::move(obj);
+    }
+    success &= (treeFiller.GetObjects().size() == requestNames.size());
+  }
   return success;
 }
 
+//**************************************************************************************************
+/**
+ * Adds up the same-named data of all root files of an input. The files are read in parallel and each
+ * thread accumulates the data of its files, before the partial results are combined pairwise in
+ * a tree reduction. Only the required data are read from the files.
+ */
+//**************************************************************************************************
+bool PlotManager::MergeInputData(const string& inputID, unordered_map<string, vector<string>>& requiredData)
+{
+  // the input files are de-duplicated and grouped by file, such that each file is read only once and by a single thread
+  vector<std::pair<string, vector<string>>> inputFiles; // file name, directories within the file (empty for top level)
+  map<string, size_t> fileIndices;                      // canonical path, index in inputFiles
+  for (auto& inputFileName : mInputFiles[inputID]) {
+    if (!str_contains(inputFileName, ".root", true)) {
+      WARNING("Only root files can be merged, ignoring {}.", inputFileName);
+      continue;
+    }
+    auto fileNamePath = split_string(inputFileName, ':', true);
+    const string& fileName = fileNamePath[0];
+    // missing files are registered as well, such that they are read once they appear
+    RegisterInputFile(fileName);
+    if (!std::filesystem::exists(fileName)) {
+      WARNING("Input file {} not found.", fileName);
+      continue;
+    }
+    std::error_code errorCode;
+    string canonicalPath = std::filesystem::weakly_canonical(fileName, errorCode).string();
+    auto [fileIndex, isNewFile] = fileIndices.try_emplace(canonicalPath, inputFiles.size());
+    if (isNewFile) {
+      inputFiles.emplace_back(fileName, vector<string>{});
+      mIOStatistics[{inputID, fileName}].nextOffset = -1; // statistics of the files are updated concurrently
+    }
+    auto& directories = inputFiles[fileIndex->second].second;
+    string directory = (fileNamePath.size() > 1) ? fileNamePath[1] : "";
+    if (std::find(directories.begin(), directories.end(), directory) != directories.end()) {
+      WARNING("Input file {} is specified multiple times for input {}.", inputFileName, inputID);
+      continue;
+    }
+    directories.push_back(directory);
+  }
+  if (inputFiles.empty()) return false;
+
+  using data_map_t = map<string, unique_ptr<TObject>>; // name, data
+  auto mergeInto = [](data_map_t& target, data_map_t& source) {
+    for (auto& [name, obj] : source) {
+      auto& targetObj = target[name];
+      if (!targetObj) {
+        targetObj = std::move(obj);
+      } else if (targetObj->InheritsFrom(TH1::Class()) && obj->InheritsFrom(TH1::Class())) {
+        static_cast<TH1*>(targetObj.get())->Add(static_cast<TH1*>(obj.get()));
+      } else if (auto merge = targetObj->IsA()->GetMerge()) {
+        // graphs, sparse histograms, ...
+        TList list;
+        list.Add(obj.get());
+        merge(targetObj.get(), &list, nullptr);
+      } else {
+        ERROR("Cannot merge {} of type {}.", name, targetObj->ClassName());
+      }
+    }
+    source.clear();
+  };
+
+  // each thread reads the next file that was not yet processed and adds its data to the thread's result
+  ROOT::EnableThreadSafety();
+  uint32_t nThreads = std::clamp<uint32_t>(std::thread::hardware_concurrency(), 1u, inputFiles.size());
+  vector<data_map_t> partialResults(nThreads);
+  std::atomic<size_t> nextFile{0};
+  auto readFiles = [&](data_map_t& result) {
+    for (size_t i = nextFile++; i < inputFiles.size(); i = nextFile++) {
+      const string& fileName = inputFiles[i].first;
+      ScopedTimer openTimer(Profiler::file_open, fileName);
+      TFile inputFile(fileName.data(), "READ");
+      openTimer.Stop();
+      if (inputFile.IsZombie()) {
+        WARNING("Cannot open input file {}.", fileName);
+        continue;
+      }
+      for (auto& directory : inputFiles[i].second) {
+        TObject* folder = &inputFile;
+        if (!directory.empty()) {
+          auto filePath = split_string(directory, '/');
+          folder = FindSubDirectory(folder, filePath);
+          if (!folder) {
+            WARNING("Subdirectory {} not found in file {}.", directory, fileName);
+            continue;
+          }
+        }
+        data_map_t fileData;
+        for (auto& [pathStr, names] : requiredData) {
+          auto path = split_string(pathStr, '/');
+          TObject* subfolder = FindSubDirectory(folder, path);
+          if (!subfolder) continue;
+          vector<string> missingNames = names;
+          ReadData(subfolder, missingNames, (pathStr.empty()) ? "" : pathStr + "/", gNameGroupSeparator + inputID, inputID, fileName, &fileData);
+          if (!path.empty() && subfolder != &inputFile) delete subfolder;
+        }
+        if (folder != &inputFile) delete folder;
+        mergeInto(result, fileData);
+      }
+      auto& ioStats = mIOStatistics.at({inputID, fileName});
+      ioStats.bytesRead += inputFile.GetBytesRead();
+      ioStats.readCalls += inputFile.GetReadCalls();
+    }
+  };
+  vector<std::thread> readers;
+  for (uint32_t i = 1; i < nThreads; ++i) {
+    readers.emplace_back(readFiles, std::ref(partialResults[i]));
+  }
+  readFiles(partialResults[0]);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  // combine the results of the threads pairwise
+  for (size_t stride = 1; stride < partialResults.size(); stride *= 2) {
+    vector<std::thread> mergers;
+    for (size_t i = 0; i + stride < partialResults.size(); i += 2 * stride) {
+      mergers.emplace_back(mergeInto, std::ref(partialResults[i]), std::ref(partialResults[i + stride]));
+    }
+    for (auto& merger : mergers) {
+      merger.join();
+    }
+  }
+
+  for (auto& [dataName, obj] : partialResults[0]) {
+    auto dataKey = MakeDataKey(inputID, dataName);
+    for (auto& [fileName, directories] : inputFiles) {
+      mInputFileContent[fileName].push_back(dataKey);
+    }
+    mDataBuffer[dataKey] = std::move(obj);
+    auto pathPos = dataName.find_last_of('/');
+    string path = (pathPos != string::npos) ? dataName.substr(0, pathPos) : "";
+    string name = (pathPos != string::npos) ? dataName.substr(pathPos + 1) : dataName;
+    vector<string>& names = requiredData[path];
+    names.erase(std::remove(names.begin(), names.end(), name), names.end());
+    if (names.empty()) requiredData.erase(path);
+  }
+  INFO("Merged {} data from {} files of input {}.", partialResults[0].size(), inputFiles.size(), inputID);
+  return requiredData.empty();
+}
+
+//**************************************************************************************************
+/**
+ * Root file in which histograms filled from trees are cached; they are only re-filled if the
+ * request or the input files change.
+ */
+//**************************************************************************************************
+void PlotManager::SetTreeCacheFile(const string& fileName)
+{
+  mTreeCacheFileName = fileName;
+}
+
+//**************************************************************************************************
+/**
+ * Number of threads used for the event loops over trees (0: all available cores).
+ */
+//**************************************************************************************************
+void PlotManager::SetEventLoopThreads(uint32_t nThreads)
+{
+  mEventLoopThreads = nThreads;
+}
+
+//**************************************************************************************************
+/**
+ * Remembers when the input file was last modified before data is read from it
+ * (files that do not exist get the minimal timestamp, so their creation counts as modification).
+ */
+//**************************************************************************************************
+void PlotManager::RegisterInputFile(const string& fileName)
+{
+  std::error_code errorCode;
+  auto timestamp = std::filesystem::last_write_time(fileName, errorCode);
+  mInputFileTimestamps[fileName] = (errorCode) ? std::filesystem::file_time_type::min() : timestamp;
+}
+
+//**************************************************************************************************
+/**
+ * Prints the I/O statistics per input identifier and per input file collected since the last report.
+ * Containers that are expensive to read but of which only a small part is actually used are highlighted.
+ */
+//**************************************************************************************************
+void PlotManager::PrintIOStatistics()
+{
+  if (mIOStatistics.empty()) return;
+
+  auto addStats = [](io_stats_t& total, const io_stats_t& stats) {
+    total.bytesRead += stats.bytesRead;
+    total.readCalls += stats.readCalls;
+    total.seeks += stats.seeks;
+    total.keysTouched += stats.keysTouched;
+    total.keysListed += stats.keysListed;
+    total.compressedBytes += stats.compressedBytes;
+    total.uncompressedBytes += stats.uncompressedBytes;
+    total.readTime += stats.readTime;
+  };
+  auto printTable = [](const string& title, const map<string, io_stats_t>& statsMap) {
+    PRINT("");
+    PRINT("{:<40} {:>10} {:>8} {:>6} {:>15} {:>11} {:>10}", title, "read [MB]", "calls", "seeks", "keys read/seen", "compr. [x]", "read [ms]");
+    PRINT("{:-<106}", "");
+    for (auto& [name, stats] : statsMap) {
+      double_t compression = (stats.compressedBytes) ? static_cast<double_t>(stats.uncompressedBytes) / stats.compressedBytes : 0.;
+      PRINT("{:<40} {:>10.3f} {:>8} {:>6} {:>15} {:>11.2f} {:>10.2f}", name, stats.bytesRead / 1e6, stats.readCalls, stats.seeks,
+            fmt::format("{}/{}", stats.keysTouched, stats.keysListed), compression, stats.readTime);
+    }
+  };
+
+  map<string, io_stats_t> statsPerInputID;
+  map<string, io_stats_t> statsPerFile;
+  for (auto& [inputIDFile, stats] : mIOStatistics) {
+    addStats(statsPerInputID[inputIDFile.first], stats);
+    addStats(statsPerFile[inputIDFile.second], stats);
+  }
+  INFO("================ I/O Statistics ===============");
+  printTable("input identifier", statsPerInputID);
+  printTable("input file", statsPerFile);
+  PRINT("");
+
+  for (auto& [inputIDFile, stats] : mIOStatistics) {
+    for (auto& container : stats.containerReads) {
+      // reading the container takes a considerable fraction of the time while most of its content is not needed
+      if (container.nUsed * 2 < container.nEntries && container.readTime > 1. && container.readTime > 0.25 * stats.readTime) {
+        WARNING("Reading {} {} ({:.2f} MB) from {} took {:.2f} ms, but only {} of its {} entries were used by {}.", container.className,
+                container.name, container.uncompressedBytes / 1e6, inputIDFile.second, container.readTime, container.nUsed, container.nEntries, inputIDFile.first);
+      }
+    }
+  }
+  mIOStatistics.clear();
+}
+
 //**************************************************************************************************
 /**
  * Show which data could and could not be found.
@@ -646,16 +1695,20 @@ void PlotManager::PrintBufferStatus(bool missingOnly) const
   }
   uint32_t nNeededData{};
   uint32_t nAvailableData{};
-  for (auto& [inputID, buffer] : mDataBuffer) {
+  map<string, map<string, bool>> bufferStatus; // inputID, name, isAvailable
+  for (auto& [dataKey, dataPtr] : mDataBuffer) {
+    bufferStatus[GetInputID(dataKey)][GetDataName(dataKey)] = (dataPtr != nullptr);
+  }
+  for (auto& [inputID, buffer] : bufferStatus) {
     bool printInputID = true;
-    for (auto& [dataName, dataPtr] : buffer) {
+    for (auto& [dataName, isAvailable] : buffer) {
       ++nNeededData;
-      bool show = missingOnly ? (dataPtr == nullptr) : true;
-      if (dataPtr) ++nAvailableData;
+      bool show = missingOnly ? !isAvailable : true;
+      if (isAvailable) ++nAvailableData;
       if (show) {
         if (printInputID) INFO("{}", inputID);
         printInputID = false;
-        INFO(" - {}{}{}", (dataPtr) ? GREEN_ : RED_, dataName, _END);
+        INFO(" - {}{}{}", (isAvailable) ? GREEN_ : RED_, dataName, _END);
       }
     }
   }
@@ -687,12 +1740,43 @@ void PlotManager::PrintLoadedPlots() const
   INFO("===============================================");
 }
 
+//**************************************************************************************************
+/**
+ * Enables the measurement of the time spent in the individual phases of plot creation.
+ */
+//**************************************************************************************************
+void PlotManager::SetProfiling(bool enable)
+{
+  Profiler::SetEnabled(enable);
+}
+
+//**************************************************************************************************
+/**
+ * Prints the timings collected so far.
+ */
+//**************************************************************************************************
+void PlotManager::PrintProfilingSummary() const
+{
+  Profiler::Instance().PrintSummary();
+}
+
+//**************************************************************************************************
+/**
+ * Writes the timings collected so far to a Chrome trace-event file.
+ */
+//**************************************************************************************************
+bool PlotManager::WriteProfilingTrace(const string& fileName) const
+{
+  return Profiler::Instance().WriteTrace(fileName);
+}
+
 //**************************************************************************************************
 /**
  * Recursively reads data from folder / list and adds it to output data array. Found dataNames are removed from the vectors.
  */
 //**************************************************************************************************
-void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const string& prefix, const string& suffix, const string& inputID)
+void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const string& prefix, const string& suffix, const string& inputID, const string& fileName,
+                           map<string, unique_ptr<TObject>>* readData, bool fromCache)
 {
   TCollection* itemList = nullptr;
   if (folder->InheritsFrom(TDirectory::Class())) {
@@ -706,10 +1790,23 @@ void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const str
     return;
   }
   itemList->SetOwner();
+  // the statistics of files that are merged concurrently are registered before, all others are registered here
+  auto ioStatsEntry = mIOStatistics.find({inputID, fileName});
+  if (ioStatsEntry == mIOStatistics.end()) ioStatsEntry = mIOStatistics.try_emplace({inputID, fileName}).first;
+  io_stats_t& ioStats = ioStatsEntry->second;
+  if (folder->InheritsFrom(TDirectory::Class())) ioStats.keysListed += itemList->GetSize();
 
   // first match should always be the one in current level; traverse deeper only if not found
   for (bool traverse : {false, true}) {
 
+    // the required objects of this level are read in the order of their position in the file
+    map<TKey*, unique_ptr<TObject>> prefetchedObjects;
+    if (!traverse && mReadPrefetchSize && folder->InheritsFrom(TDirectory::Class())) {
+      // the readers of merged inputs (which collect into readData) already run concurrently, so each of them decompresses on its own
+      uint32_t nDecompressionThreads = (readData) ? 1u : mDecompressionThreads;
+      prefetchedObjects = PrefetchKeys(static_cast<TDirectory*>(folder), itemList, dataNames, ioStats, fileName, nDecompressionThreads);
+    }
+
     TIter iterator = itemList->begin();
     TObject* obj{};
     bool deleteObject;
@@ -721,15 +1818,41 @@ void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const str
       removeFromList = true;
 
       string curDataName; // name of current key or data
+      optional<io_stats_t::container_read_t> containerRead;
+      bool isCachedContainer{};
       // read actual object to memory when traversing a directory
       if (obj->IsA() == TKey::Class()) {
-        string className = static_cast<TKey*>(obj)->GetClassName();
-        curDataName = obj->GetName();
+        TKey* key = static_cast<TKey*>(obj);
+        string className = key->GetClassName();
+        curDataName = key->GetName();
 
         bool isTraversable = str_contains(className, "TDirectory") || str_contains(className, "TFolder") || str_contains(className, "TList") || str_contains(className, "THashList") || str_contains(className, "TObjArray");
-        if ((traverse && isTraversable) || std::find(dataNames.begin(), dataNames.end(), curDataName) != dataNames.end()) {
-          obj = static_cast<TKey*>(obj)->ReadObj();
+        if (auto prefetched = prefetchedObjects.find(key); prefetched != prefetchedObjects.end()) {
+          obj = prefetched->second.release();
+          removeFromList = false;
+        } else if (TCollection* cachedContainer = (traverse && isTraversable && !readData) ? mContainerCache->Get(key) : nullptr) {
+          // list that was already read before
+          obj = cachedContainer;
+          isCachedContainer = true;
+          removeFromList = false;
+        } else if ((traverse && isTraversable) || std::find(dataNames.begin(), dataNames.end(), curDataName) != dataNames.end()) {
+          ScopedTimer readTimer(Profiler::object_read, fileName);
+          auto readStart = std::chrono::steady_clock::now();
+          obj = key->ReadObj();
+          double_t readTime = std::chrono::duration<double_t, std::milli>(std::chrono::steady_clock::now() - readStart).count();
           removeFromList = false;
+
+          ++ioStats.keysTouched;
+          ioStats.compressedBytes += key->GetNbytes();
+          ioStats.uncompressedBytes += key->GetObjlen();
+          ioStats.readTime += readTime;
+          if (ioStats.nextOffset >= 0 && key->GetSeekKey() != ioStats.nextOffset) ++ioStats.seeks;
+          ioStats.nextOffset = key->GetSeekKey() + key->GetNbytes();
+          if (obj && obj->InheritsFrom(TCollection::Class())) {
+            containerRead = {prefix + curDataName, className, static_cast<uint64_t>(key->GetObjlen()), readTime,
+                             static_cast<uint32_t>(static_cast<TCollection*>(obj)->GetEntries()), 0u};
+            if (traverse && !readData) isCachedContainer = mContainerCache->Add(key, static_cast<TCollection*>(obj));
+          }
         } else {
           ++iterator;
           continue;
@@ -739,7 +1862,13 @@ void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const str
       // in case this object is directory or list, repeat the same for this substructure
       if (obj->InheritsFrom(TDirectory::Class()) || obj->InheritsFrom(TFolder::Class()) || obj->InheritsFrom(TCollection::Class())) {
         if (traverse) {
-          ReadData(obj, dataNames, prefix, suffix, inputID);
+          size_t nMissing = dataNames.size();
+          ReadData(obj, dataNames, prefix, suffix, inputID, fileName, readData, fromCache || isCachedContainer);
+          if (containerRead) {
+            containerRead->nUsed = nMissing - dataNames.size();
+            ioStats.containerReads.push_back(*containerRead);
+          }
+          if (isCachedContainer) deleteObject = false;
         } else if (removeFromList) {
           removeFromList = false;
           deleteObject = false;
@@ -748,17 +1877,29 @@ void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const str
         // the key name supersedes the actual data name (in case they are different when written to file via h->Write("myKeyName"))
         if (curDataName.empty()) curDataName = obj->GetName();
         if (auto it = std::find(dataNames.begin(), dataNames.end(), curDataName); it != dataNames.end()) {
+          if (fromCache) {
+            obj = obj->Clone(); // the cached list stays intact for later requests
+          } else {
+            itemList->Remove(obj);
+          }
           if (obj->InheritsFrom(TH1::Class())) static_cast<TH1*>(obj)->SetDirectory(0); // demand ownership for histogram
-          itemList->Remove(obj);
+          ChunkedSparse::SetFileName(obj, fileName); // projections of chunked sparse histograms are read from the file later on
           dataNames.erase(it);
           string fullName = prefix + curDataName;
           static_cast<TNamed*>(obj)->SetName((fullName + suffix).data());
-          mDataBuffer[inputID][fullName].reset(obj);
+          if (readData) {
+            (*readData)[fullName].reset(obj);
+          } else {
+            mDataBuffer[MakeDataKey(inputID, fullName)].reset(obj);
+          }
           removeFromList = false;
           deleteObject = false;
         }
       }
 
+      // content of cached lists must not be touched
+      if (fromCache) removeFromList = deleteObject = false;
+
       // increase iterator before removing objects from collection
       ++iterator;
       if (removeFromList) {
@@ -776,18 +1917,239 @@ void PlotManager::ReadData(TObject* folder, vector<string>& dataNames, const str
 
 //**************************************************************************************************
 /**
- * Read data from csv file.
+ * Reads the required keys of a directory sorted by their offset in the file. Keys that are close to
+ * each other are fetched with one sequential read of up to the prefetch size. While the calling
+ * thread continues reading, a pool of threads decompresses and deserializes the objects from the
+ * buffers read so far (for a single decompression thread this is done by the calling thread). At
+ * most one buffer more than there are threads is kept in memory (0 threads: all available cores).
+ * Keys that could not be read this way are left to ReadData.
+ */
+//**************************************************************************************************
+map<TKey*, unique_ptr<TObject>> PlotManager::PrefetchKeys(TDirectory* directory, TCollection* keys, const vector<string>& dataNames, io_stats_t& ioStats, const string& fileName,
+                                                          uint32_t nDecompressionThreads)
+{
+  constexpr int64_t maxGap{256 * 1024}; // reading a gap of this size is still faster than seeking
+  map<TKey*, unique_ptr<TObject>> objects;
+  TFile* file = directory->GetFile();
+  if (!file) return objects;
+
+  // only the first key of each name is relevant (further ones are older cycles)
+  vector<TKey*> plannedKeys;
+  set<string> plannedNames;
+  for (TObject* obj : *keys) {
+    if (obj->IsA() != TKey::Class()) continue;
+    TKey* key = static_cast<TKey*>(obj);
+    if (std::find(dataNames.begin(), dataNames.end(), key->GetName()) == dataNames.end()) continue;
+    if (!plannedNames.insert(key->GetName()).second || str_contains(key->GetClassName(), "TDirectory")) continue;
+    plannedKeys.push_back(key);
+  }
+  if (plannedKeys.size() < 2) return objects;
+  std::sort(plannedKeys.begin(), plannedKeys.end(), [](TKey* a, TKey* b) { return a->GetSeekKey() < b->GetSeekKey(); });
+
+  // buffers are released once all keys they contain are deserialized
+  struct buffer_t {
+    vector<char> data;
+    int64_t start{};       // offset in the file
+    size_t nPendingKeys{}; // keys that were not yet deserialized
+  };
+  vector<TObject*> readObjects(plannedKeys.size(), nullptr);
+  auto deserializeKey = [&](size_t index, const buffer_t& buffer) {
+    ScopedTimer readTimer(Profiler::object_read, fileName);
+    readObjects[index] = read_object(plannedKeys[index], buffer.data.data() + (plannedKeys[index]->GetSeekKey() - buffer.start), file);
+  };
+
+  // with a single decompression thread the objects are deserialized by the calling thread right after reading them
+  bool isConcurrent = (nDecompressionThreads != 1);
+  uint32_t nThreads = (isConcurrent) ? std::clamp<uint32_t>((nDecompressionThreads) ? nDecompressionThreads : std::thread::hardware_concurrency(), 1u, plannedKeys.size()) : 0u;
+  uint32_t maxBuffersInFlight = nThreads + 1; // bounds the memory used for buffers that still need to be deserialized
+  uint32_t nBuffersInFlight{};
+  std::deque<std::pair<size_t, shared_ptr<buffer_t>>> queue; // index of key, buffer holding the key
+  bool readingDone{false};
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::condition_variable bufferCondition;
+  auto deserialize = [&]() {
+    while (true) {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueCondition.wait(lock, [&] { return readingDone || !queue.empty(); });
+      if (queue.empty()) return;
+      auto [index, buffer] = std::move(queue.front());
+      queue.pop_front();
+      lock.unlock();
+      deserializeKey(index, *buffer);
+      lock.lock();
+      if (--buffer->nPendingKeys == 0) {
+        --nBuffersInFlight;
+        bufferCondition.notify_one();
+      }
+    }
+  };
+  if (isConcurrent) ROOT::EnableThreadSafety();
+  vector<std::thread> workers;
+  for (uint32_t i = 0; i < nThreads; ++i) {
+    workers.emplace_back(deserialize);
+  }
+
+  auto readStart = std::chrono::steady_clock::now();
+  for (size_t first = 0, last = 0; first < plannedKeys.size(); first = last) {
+    // merge neighbouring keys into one sequential read
+    int64_t start = plannedKeys[first]->GetSeekKey();
+    int64_t end = start + plannedKeys[first]->GetNbytes();
+    for (last = first + 1; last < plannedKeys.size(); ++last) {
+      int64_t keyStart = plannedKeys[last]->GetSeekKey();
+      int64_t keyEnd = keyStart + plannedKeys[last]->GetNbytes();
+      if (keyStart - end > maxGap || keyEnd - start > mReadPrefetchSize) break;
+      end = std::max(end, keyEnd);
+    }
+
+    if (isConcurrent) {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      bufferCondition.wait(lock, [&] { return nBuffersInFlight < maxBuffersInFlight; });
+    }
+    ScopedTimer readTimer(Profiler::object_read, fileName);
+    auto buffer = std::make_shared<buffer_t>();
+    buffer->data.resize(end - start);
+    buffer->start = start;
+    buffer->nPendingKeys = last - first;
+    if (file->ReadBuffer(buffer->data.data(), start, static_cast<int32_t>(end - start))) {
+      WARNING("Could not read {} bytes at offset {} of file {}.", end - start, start, fileName);
+      continue;
+    }
+    readTimer.Stop();
+    if (ioStats.nextOffset >= 0 && start != ioStats.nextOffset) ++ioStats.seeks;
+    ioStats.nextOffset = end;
+    if (!isConcurrent) {
+      for (size_t i = first; i < last; ++i) {
+        deserializeKey(i, *buffer);
+      }
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      ++nBuffersInFlight;
+      for (size_t i = first; i < last; ++i) {
+        queue.emplace_back(i, buffer);
+      }
+    }
+    queueCondition.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    readingDone = true;
+  }
+  queueCondition.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  ioStats.readTime += std::chrono::duration<double_t, std::milli>(std::chrono::steady_clock::now() - readStart).count();
+
+  for (size_t i = 0; i < plannedKeys.size(); ++i) {
+    if (!readObjects[i]) continue;
+    ++ioStats.keysTouched;
+    ioStats.compressedBytes += plannedKeys[i]->GetNbytes();
+    ioStats.uncompressedBytes += plannedKeys[i]->GetObjlen();
+    objects[plannedKeys[i]].reset(readObjects[i]);
+  }
+  return objects;
+}
+
+//**************************************************************************************************
+/**
+ * Read graphs from csv file (optionally followed by ':' and the csv options, see csv_schema_t).
+ * The graph is named after the file, or "file/column" in case several y columns are selected.
+ * All required graphs are extracted in a single pass over the file; returns their names.
+ */
+//**************************************************************************************************
+vector<string> PlotManager::ReadDataCSV(const string& inputFileName, const string& inputIdentifier, const vector<string>& requiredNames)
+{
+  auto fileNameOptions = split_string(inputFileName, ':', true);
+  const string& fileName = fileNameOptions[0];
+  auto schema = csv_schema_t::FromString((fileNameOptions.size() > 1) ? fileNameOptions[1] : "");
+  if (!schema) return {};
+
+  std::filesystem::path filePath(fileName);
+  if (filePath.extension() == ".gz") filePath.replace_extension();
+  string fileStem = filePath.stem().string();
+  auto getGraphName = [&](const string& column) { return (schema->y.size() > 1) ? fileStem + "/" + column : fileStem; };
+  vector<string> graphNames;
+  for (auto& column : (schema->y.empty()) ? vector<string>{""} : schema->y) {
+    string graphName = getGraphName(column);
+    if (std::find(requiredNames.begin(), requiredNames.end(), graphName) != requiredNames.end()) graphNames.push_back(graphName);
+  }
+  if (graphNames.empty()) return {};
+
+  CSVReader reader(*schema);
+  {
+    ScopedTimer timer(Profiler::object_read, fileName);
+    if (!reader.Read(fileName)) return {};
+  }
+  const csv_schema_t& columns = reader.GetSchema(); // including the default columns of the classic format
+  auto getColumn = [&](const vector<string>& columnNames, size_t index) -> const double_t* {
+    if (index >= columnNames.size()) return nullptr;
+    const vector<double_t>* values = reader.GetColumn(columnNames[index]);
+    return (values) ? values->data() : nullptr;
+  };
+  int32_t nPoints = reader.GetNumRows();
+  const double_t* x = getColumn({columns.x}, 0);
+
+  vector<string> extractedGraphs;
+  for (size_t i = 0; i < columns.y.size(); ++i) {
+    string graphName = getGraphName(columns.y[i]);
+    if (std::find(graphNames.begin(), graphNames.end(), graphName) == graphNames.end()) continue;
+    TGraph* graph{nullptr};
+    if (columns.HasAsymmErrors()) {
+      graph = new TGraphAsymmErrors(nPoints, x, getColumn(columns.y, i), getColumn(columns.exl, i), getColumn(columns.exh, i), getColumn(columns.eyl, i), getColumn(columns.eyh, i));
+    } else {
+      graph = new TGraphErrors(nPoints, x, getColumn(columns.y, i), getColumn(columns.ex, i), getColumn(columns.ey, i));
+    }
+    string uniqueName = graphName + gNameGroupSeparator + inputIdentifier;
+    graph->SetName(uniqueName.data());
+    mDataBuffer[MakeDataKey(inputIdentifier, graphName)].reset(graph);
+    extractedGraphs.push_back(graphName);
+  }
+  return extractedGraphs;
+}
+
+//**************************************************************************************************
+/**
+ * Read histograms and graphs from yoda file, hepdata table or numpy arrays; returns the names of the data that was found.
  */
 //**************************************************************************************************
-void PlotManager::ReadDataCSV(const string& inputFileName, const string& graphName, const string& inputIdentifier)
+vector<string> PlotManager::ReadDataExternal(const string& fileName, const string& inputIdentifier, const vector<string>& requiredNames)
 {
-  // extract from path the csv file name that will then become graph name TODO: protect this against wrong usage...
-  string delimiter = "\t"; // TODO: this must somehow be user definable
-  string pattern = "%lg %lg %lg %lg";
-  TGraphErrors* graph = new TGraphErrors(inputFileName.data(), pattern.data(), delimiter.data());
-  string uniqueName = graphName + gNameGroupSeparator + inputIdentifier;
-  graph->SetName(uniqueName.data());
-  mDataBuffer[inputIdentifier][graphName].reset(graph);
+  map<string, unique_ptr<TObject>> objects;
+  vector<string> sidecarFileNames; // files the data was read from in addition to the input file
+  auto read = [&](auto& reader) {
+    ScopedTimer timer(Profiler::object_read, fileName);
+    if (reader.Read(fileName, requiredNames)) objects = std::move(reader.GetObjects());
+  };
+  if (YODAReader::IsYODAFile(fileName)) {
+    YODAReader reader;
+    read(reader);
+  } else if (NumPyReader::IsNumPyFile(fileName)) {
+    NumPyReader reader;
+    read(reader);
+    sidecarFileNames = reader.GetSidecarFileNames();
+  } else {
+    HEPDataReader reader;
+    read(reader);
+  }
+
+  vector<string> dataNames;
+  for (auto& [dataName, object] : objects) {
+    string uniqueName = dataName + gNameGroupSeparator + inputIdentifier;
+    static_cast<TNamed*>(object.get())->SetName(uniqueName.data());
+    mDataBuffer[MakeDataKey(inputIdentifier, dataName)] = std::move(object);
+    dataNames.push_back(dataName);
+  }
+  // modifications of the sidecar files also invalidate the data
+  for (auto& sidecarFileName : sidecarFileNames) {
+    RegisterInputFile(sidecarFileName);
+    for (auto& dataName : dataNames) {
+      mInputFileContent[sidecarFileName].push_back(MakeDataKey(inputIdentifier, dataName));
+    }
+  }
+  return dataNames;
 }
 
 //**************************************************************************************************
@@ -835,10 +2197,10 @@ TObject* PlotManager::FindSubDirectory(TObject* folder, vector<string>& subDirs)
 
 //**************************************************************************************************
 /**
- * Function to find plots in file via regex match of user inputs
+ * Function to find plots in file via regex match of user inputs. Returns false if no plot matches the request.
  */
 //**************************************************************************************************
-void PlotManager::ExtractPlotsFromFile(const string& plotFileName,
+bool PlotManager::ExtractPlotsFromFile(const string& plotFileName,
                                        const string& mode,
                                        const string& plotName,
                                        const string& group,
@@ -864,7 +2226,9 @@ void PlotManager::ExtractPlotsFromFile(const string& plotFileName,
     for (auto& plotTree : plotGroupTree.second) {
       if (isTemplate) {
         Plot plot(plotTree.second);
+        string templateName = plot.GetName();
         AddPlotTemplate(plot);
+        mTemplatesFromFile[plotFileName].insert(templateName);
         continue;
       }
 
@@ -884,7 +2248,9 @@ void PlotManager::ExtractPlotsFromFile(const string& plotFileName,
       } else {
         try {
           Plot plot(plotTree.second);
+          string uniqueName = plot.GetUniqueName();
           AddPlot(plot);
+          mPlotsFromFile[plotFileName].insert(uniqueName);
         } catch (...) {
           ERROR("Could not generate plot {} from XML file.", plotTree.first);
         }
@@ -900,6 +2266,7 @@ void PlotManager::ExtractPlotsFromFile(const string& plotFileName,
     // now produce the loaded plots
     CreatePlots("", "", {}, mode);
   }
+  return (nFoundPlots > 0);
 }
 
 } // end namespace PlottingFramework
@@ -20,6 +20,8 @@
 #include "PlottingFramework.h"
 #include "Logging.h"
 #include "Helpers.h"
+#include "Profiler.h"
+#include "ChunkedSparse.h"
 
 // std dependencies
 #include <regex>
@@ -132,8 +134,9 @@ constexpr bool is_2d()
  * Function to generate the plot.
  */
 //**************************************************************************************************
-unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<string, unordered_map<string, std::unique_ptr<TObject>>>& dataBuffer)
+unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<data_key_t, std::unique_ptr<TObject>>& dataBuffer)
 {
+  ScopedTimer timer(Profiler::painting);
   bool fail = false;
 
   double_t canvasWidth = plot.GetWidth().value_or(gStyle->GetCanvasDefW());
@@ -247,12 +250,8 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
                                    [](auto& curData) { return curData->GetDefinesFrame(); });
       uint8_t frameDataID = (framePos != pad.GetData().end()) ? framePos - pad.GetData().begin() : 0u;
       // make a copy of data that will serve as axis frame and put it in front of data vector
-      if (pad.GetData()[frameDataID]->GetType() == "ratio") {
-        pad.GetData().insert(pad.GetData().begin(), std::make_shared<Plot::Pad::Ratio>(*std::dynamic_pointer_cast<Plot::Pad::Ratio>(pad.GetData()[frameDataID])));
-      } else {
-        pad.GetData().insert(pad.GetData().begin(), std::make_shared<Plot::Pad::Data>(*pad.GetData()[frameDataID]));
-      }
-      pad.GetData()[0]->SetLegendLabel(""); // axis frame should not appear in legend
+      pad.GetData().insert(pad.GetData().begin(), pad.GetData()[frameDataID]);
+      pad.GetData()[0].Mutable().SetLegendLabel(""); // axis frame should not appear in legend
     }
 
     TH1* axisHist_ptr{nullptr};
@@ -328,7 +327,7 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
                 data_ptr->Divide(denom_data_ptr);
               }
               if constexpr (is_hist<denom_data_type>()) {
-                string divideOpt = (std::dynamic_pointer_cast<Plot::Pad::Ratio>(data)->GetIsCorrelated()) ? "B" : "";
+                string divideOpt = (data.As<Plot::Pad::Ratio>()->GetIsCorrelated()) ? "B" : "";
                 if (!data_ptr->Divide(data_ptr, denom_data_ptr, 1., 1., divideOpt.data())) {
                   WARNING("Could not divide histograms properly. Trying approximated division via spline interpolation. Errors will not be fully correct!");
                   DivideHistosInterpolated(data_ptr, denom_data_ptr);
@@ -360,10 +359,11 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
             delete denom_data_ptr;
           };
 
-          auto data_denom = std::dynamic_pointer_cast<Plot::Pad::Ratio>(data);
-          auto rawDenomData = GetDataClone(dataBuffer.at(data_denom->GetDenomIdentifier()).at(data_denom->GetDenomName()).get(), data_denom->GetProjInfoDenom());
+          auto data_denom = data.As<Plot::Pad::Ratio>();
+          auto rawDenomData = GetDataClone(dataBuffer.at(data_denom->GetDenomDataKey()).get(), data_denom->GetProjInfoDenom());
 
           if (rawDenomData) {
+            ScopedTimer ratioTimer(Profiler::ratio);
             std::visit(processDenominator, *rawDenomData);
           } else {
             fail = true;
@@ -378,6 +378,7 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
             data_ptr->Smooth();
           }
         }
+        ScopedTimer scalingTimer(Profiler::scaling);
         if constexpr (is_hist<data_type>()) {
           if (!data_ptr->GetSumw2N()) data_ptr->Sumw2();
           optional<double_t> scaleFactor;
@@ -419,6 +420,7 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
           }
           if (scaleFactor) ScaleGraph(static_cast<TGraph*>(data_ptr), *scaleFactor);
         }
+        scalingTimer.Stop();
 
         // first data is only used to define the axes
         if (dataIndex == 0) {
@@ -702,7 +704,7 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
             if (data->GetLegendID()) legendID = *data->GetLegendID();
 
             if (legendID > 0u && legendID <= legendBoxVector.size()) {
-              legendBoxVector[legendID - 1]->AddEntry(*data->GetLegendLabel(), data_ptr->GetName());
+              legendBoxVector[legendID - 1].Mutable().AddEntry(*data->GetLegendLabel(), data_ptr->GetName());
             } else {
               ERROR("Invalid legend label ({}) specified for data {} in {}.", legendID, data->GetName(), data->GetInputID());
             }
@@ -713,7 +715,7 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
         drawingOptions = "SAME "; // next data should be drawn to same pad
       };
 
-      optional<data_ptr_t> rawData = GetDataClone(dataBuffer.at(data->GetInputID()).at(data->GetName()).get(), data->GetProjInfo());
+      optional<data_ptr_t> rawData = GetDataClone(dataBuffer.at(data->GetDataKey()).get(), data->GetProjInfo());
       if (rawData) {
         std::visit(processData, *rawData);
       } else {
@@ -748,14 +750,15 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
 
     // now place legends, text-boxes and shapes
     uint8_t legendIndex{1u};
-    for (auto& box : pad.GetLegendBoxes()) {
+    for (auto& legendBox : pad.GetLegendBoxes()) {
       string legendName = "LegendBox_" + std::to_string(legendIndex);
-      box->MergeLegendEntries(); // apply individual user settings on top of automatic entries
+      auto& box = legendBox.Mutable();
+      box.MergeLegendEntries(); // apply individual user settings on top of automatic entries
       // apply default text properties of pad to the box
-      if (!box->GetTextFont() && textFont) box->SetTextFont(*textFont);
-      if (!box->GetTextSize() && textSize) box->SetTextSize(*textSize);
-      if (!box->GetTextColor() && textColor) box->SetTextColor(*textColor);
-      TPave* legend = GenerateBox(box, pad_ptr);
+      if (!box.GetTextFont() && textFont) box.SetTextFont(*textFont);
+      if (!box.GetTextSize() && textSize) box.SetTextSize(*textSize);
+      if (!box.GetTextColor() && textColor) box.SetTextColor(*textColor);
+      TPave* legend = GenerateBox(&box, pad_ptr);
       if (legend) {
         legend->SetName(legendName.data());
         legend->Draw("SAME");
@@ -765,13 +768,14 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
       }
     }
     uint8_t textIndex{1u};
-    for (auto& box : pad.GetTextBoxes()) {
+    for (auto& textBox : pad.GetTextBoxes()) {
       string textName = "TextBox_" + std::to_string(textIndex);
+      auto& box = textBox.Mutable();
       // apply default text properties of pad to the box
-      if (!box->GetTextFont() && textFont) box->SetTextFont(*textFont);
-      if (!box->GetTextSize() && textSize) box->SetTextSize(*textSize);
-      if (!box->GetTextColor() && textColor) box->SetTextColor(*textColor);
-      TPave* text = GenerateBox(box, pad_ptr);
+      if (!box.GetTextFont() && textFont) box.SetTextFont(*textFont);
+      if (!box.GetTextSize() && textSize) box.SetTextSize(*textSize);
+      if (!box.GetTextColor() && textColor) box.SetTextColor(*textColor);
+      TPave* text = GenerateBox(&box, pad_ptr);
       if (text) {
         text->SetName(textName.data());
         text->Draw("SAME");
@@ -796,8 +800,9 @@ unique_ptr<TCanvas> PlotPainter::GeneratePlot(Plot& plot, const unordered_map<st
  * Function to generate a legend or text box.
  */
 //**************************************************************************************************
-TPave* PlotPainter::GenerateBox(variant<shared_ptr<Plot::Pad::LegendBox>, shared_ptr<Plot::Pad::TextBox>> boxVariant, TPad* pad)
+TPave* PlotPainter::GenerateBox(variant<const Plot::Pad::LegendBox*, const Plot::Pad::TextBox*> boxVariant, TPad* pad)
 {
+  ScopedTimer timer(Profiler::box_layout);
   TPave* returnBox{nullptr};
 
   auto processBox = [&](auto&& box) {
@@ -1120,6 +1125,7 @@ TPave* PlotPainter::GenerateBox(variant<shared_ptr<Plot::Pad::LegendBox>, shared
 optional<data_ptr_t> PlotPainter::GetDataClone(TObject* obj, const std::optional<Plot::Pad::Data::proj_info_t>& projInfo)
 {
   if (obj) {
+    ScopedTimer timer((projInfo) ? Profiler::projection : Profiler::clone);
     if (projInfo) {
       bool addDirStatus = TH1::AddDirectoryStatus();
       TH1::AddDirectory(false);
@@ -1169,8 +1175,7 @@ optional<data_ptr_t> PlotPainter::GetProjection(TObject* obj, Plot::Pad::Data::p
     return std::nullopt;
   }
 
-  if (obj->InheritsFrom(THnBase::Class()) && !isProfile) {
-    THnBase* histPtr = static_cast<THnBase*>(obj);
+  auto projectSparse = [&](THnBase* histPtr) -> TH1* {
     // first reset all ranges in case this histogram was previously used
     for (int16_t i = 0; i < histPtr->GetNdimensions(); ++i) {
       histPtr->GetAxis(i)->SetRange();
@@ -1179,7 +1184,7 @@ optional<data_ptr_t> PlotPainter::GetProjection(TObject* obj, Plot::Pad::Data::p
       int32_t rangeDim = std::get<0>(rangeTuple);
       if (rangeDim >= histPtr->GetNdimensions()) {
         ERROR("Invalid dimension specified for setting ranges of histogram {}", obj->GetName());
-        return std::nullopt;
+        return nullptr;
       }
       int32_t minBin = (projInfo.isUserCoord && *projInfo.isUserCoord) ? histPtr->GetAxis(rangeDim)->FindBin(std::get<1>(rangeTuple)) : static_cast<int>(std::get<1>(rangeTuple));
       int32_t maxBin = (projInfo.isUserCoord && *projInfo.isUserCoord) ? histPtr->GetAxis(rangeDim)->FindBin(std::get<2>(rangeTuple)) : static_cast<int>(std::get<2>(rangeTuple));
@@ -1187,9 +1192,33 @@ optional<data_ptr_t> PlotPainter::GetProjection(TObject* obj, Plot::Pad::Data::p
     }
     if (projInfo.dims.size() == 2) {
       return histPtr->Projection(projInfo.dims[1], projInfo.dims[0]);
-    } else if (projInfo.dims.size() == 1) {
-      return histPtr->Projection(projInfo.dims[0]);
     }
+    return histPtr->Projection(projInfo.dims[0]);
+  };
+
+  if (ChunkedSparse::IsPlaceholder(obj) && !isProfile) {
+    // sum up the projections of the chunks, which are read one at a time
+    unique_ptr<TH1> projection;
+    bool success = ChunkedSparse::ForEachChunk(obj, [&](THnBase* chunk) {
+      unique_ptr<TH1> chunkProjection(projectSparse(chunk));
+      if (!chunkProjection) return false;
+      if (projection) {
+        projection->Add(chunkProjection.get());
+      } else {
+        projection = std::move(chunkProjection);
+      }
+      return true;
+    });
+    if (!success || !projection) return std::nullopt;
+    if (projInfo.dims.size() == 2) return static_cast<TH2*>(projection.release());
+    return projection.release();
+  } else if (obj->InheritsFrom(THnBase::Class()) && !isProfile) {
+    THnBase* histPtr = static_cast<THnBase*>(obj);
+    if (TH1* projection = projectSparse(histPtr)) {
+      if (projInfo.dims.size() == 2) return static_cast<TH2*>(projection);
+      return projection;
+    }
+    return std::nullopt;
   } else if (obj->InheritsFrom(TH3::Class())) {
     TH3* histPtr = static_cast<TH3*>(obj);
     // first reset all ranges in case this histogram was previously used
@@ -0,0 +1,252 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// framework dependencies
+#include "PlotServer.h"
+#include "Logging.h"
+#include "Helpers.h"
+
+// std dependencies
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace PlottingFramework
+{
+const string gRequestSeparator = "\t";
+const int32_t gRequestTimeout = 5; // seconds a client may take to send its request
+
+//**************************************************************************************************
+/**
+ * Constructor for PlotServer.
+ */
+//**************************************************************************************************
+PlotServer::PlotServer(const string& socketPath) : mSocketPath(socketPath)
+{
+}
+
+//**************************************************************************************************
+/**
+ * Destructor for PlotServer. Closes the socket and removes the socket file.
+ */
+//**************************************************************************************************
+PlotServer::~PlotServer()
+{
+  if (mSocket >= 0) {
+    close(mSocket);
+    unlink(mSocketPath.data());
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Default location of the socket (only accessible by the current user).
+ */
+//**************************************************************************************************
+string PlotServer::GetDefaultSocketPath()
+{
+  if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR")) {
+    return string(runtimeDir) + "/plot-server.sock";
+  }
+  return "/tmp/plot-server-" + std::to_string(getuid()) + ".sock";
+}
+
+//**************************************************************************************************
+/**
+ * Creates the socket and starts listening for connections.
+ */
+//**************************************************************************************************
+bool PlotServer::Listen()
+{
+  sockaddr_un address{};
+  if (mSocketPath.size() >= sizeof(address.sun_path)) {
+    ERROR("Socket path {} is too long.", mSocketPath);
+    return false;
+  }
+  if (Exchange("ping", mSocketPath)) {
+    ERROR("There is already a plot server listening on {}.", mSocketPath);
+    return false;
+  }
+  // remove left-over socket of a server that was not shut down properly, but never anything else
+  // (the default location in /tmp could have been prepared by another user)
+  if (struct stat status{}; lstat(mSocketPath.data(), &status) == 0) {
+    if (!S_ISSOCK(status.st_mode) || status.st_uid != getuid()) {
+      ERROR("Refusing to replace {} since it is not a socket owned by the current user.", mSocketPath);
+      return false;
+    }
+    unlink(mSocketPath.data());
+  }
+
+  mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (mSocket < 0) {
+    ERROR("Could not create socket ({}).", std::strerror(errno));
+    return false;
+  }
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, mSocketPath.data(), sizeof(address.sun_path) - 1);
+  // the socket must only be accessible to the user from the moment it is created
+  mode_t previousMask = umask(S_IRWXG | S_IRWXO);
+  int32_t bindResult = bind(mSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  umask(previousMask);
+  if (bindResult < 0 || chmod(mSocketPath.data(), S_IRUSR | S_IWUSR) < 0 || listen(mSocket, 8) < 0) {
+    ERROR("Could not listen on socket {} ({}).", mSocketPath, std::strerror(errno));
+    close(mSocket);
+    mSocket = -1;
+    return false;
+  }
+  INFO("Plot server is listening on {}.", mSocketPath);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Handles incoming requests one after another until a shutdown request is received.
+ */
+//**************************************************************************************************
+void PlotServer::Run(const std::function<bool(const vector<string>&)>& requestHandler)
+{
+  if (mSocket < 0 && !Listen()) return;
+  while (true) {
+    int32_t client = accept(mSocket, nullptr, nullptr);
+    if (client < 0) {
+      if (errno == EINTR) continue;
+      ERROR("Could not accept connection ({}).", std::strerror(errno));
+      break;
+    }
+    // do not let a client that does not send anything block the server
+    timeval timeout{gRequestTimeout, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    auto request = ReadMessage(client);
+    bool shutdown = false;
+    bool success = false;
+    if (!request) {
+      WARNING("Received incomplete request.");
+    } else if (*request == "ping") {
+      success = true;
+    } else if (*request == "shutdown") {
+      shutdown = success = true;
+    } else {
+      success = requestHandler(split_string(*request, gRequestSeparator[0]));
+    }
+    WriteMessage(client, (success) ? "ok" : "failed");
+    close(client);
+    if (shutdown) break;
+  }
+  INFO("Plot server was shut down.");
+}
+
+//**************************************************************************************************
+/**
+ * Forwards request to the server. Returns nothing in case no server is running.
+ */
+//**************************************************************************************************
+optional<bool> PlotServer::SendRequest(const vector<string>& arguments, const string& socketPath)
+{
+  string request;
+  for (auto& argument : arguments) {
+    if (argument.find_first_of(gRequestSeparator + "\n") != string::npos) {
+      ERROR("Arguments must not contain tabs or line breaks.");
+      return false;
+    }
+    request += ((request.empty()) ? "" : gRequestSeparator) + argument;
+  }
+  auto reply = Exchange(request, socketPath);
+  if (!reply) return std::nullopt;
+  return (*reply == "ok");
+}
+
+//**************************************************************************************************
+/**
+ * Asks the server to shut down.
+ */
+//**************************************************************************************************
+bool PlotServer::Shutdown(const string& socketPath)
+{
+  return Exchange("shutdown", socketPath).has_value();
+}
+
+//**************************************************************************************************
+/**
+ * Sends message to the server and waits for its reply.
+ */
+//**************************************************************************************************
+optional<string> PlotServer::Exchange(const string& message, const string& socketPath)
+{
+  sockaddr_un address{};
+  if (socketPath.size() >= sizeof(address.sun_path)) return std::nullopt;
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socketPath.data(), sizeof(address.sun_path) - 1);
+
+  int32_t server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0) return std::nullopt;
+  optional<string> reply;
+  if (connect(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 && WriteMessage(server, message)) {
+    reply = ReadMessage(server);
+  }
+  close(server);
+  return reply;
+}
+
+//**************************************************************************************************
+/**
+ * Writes message terminated by a line break to the socket.
+ */
+//**************************************************************************************************
+bool PlotServer::WriteMessage(int32_t socket, const string& message)
+{
+  string buffer = message + "\n";
+  size_t nWritten{};
+  while (nWritten < buffer.size()) {
+    // a peer that disconnected early must not kill the process with SIGPIPE
+    ssize_t result = send(socket, buffer.data() + nWritten, buffer.size() - nWritten, MSG_NOSIGNAL);
+    if (result < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    nWritten += result;
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Reads message terminated by a line break from the socket (fails when the receive timeout of the socket expires).
+ */
+//**************************************************************************************************
+optional<string> PlotServer::ReadMessage(int32_t socket)
+{
+  string message;
+  char buffer[512];
+  while (true) {
+    ssize_t result = read(socket, buffer, sizeof(buffer));
+    if (result < 0) {
+      if (errno == EINTR) continue;
+      return std::nullopt;
+    }
+    if (result == 0) return std::nullopt;
+    message.append(buffer, result);
+    if (auto endPos = message.find('\n'); endPos != string::npos) {
+      message.erase(endPos);
+      return message;
+    }
+  }
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,189 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// framework dependencies
+#include "Profiler.h"
+#include "Logging.h"
+
+// std dependencies
+#include <fstream>
+#include <thread>
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Global profiler instance shared by manager and painter.
+ */
+//**************************************************************************************************
+Profiler& Profiler::Instance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor.
+ */
+//**************************************************************************************************
+Profiler::Profiler() : mStartTime{std::chrono::steady_clock::now()}
+{
+}
+
+//**************************************************************************************************
+/**
+ * Name of the phase as shown in the summary and trace.
+ */
+//**************************************************************************************************
+const char* Profiler::GetPhaseName(phase_t phase)
+{
+  static const array<const char*, n_phases> phaseNames{"file open", "key lookup", "object read", "event loop", "clone",
+                                                       "projection", "ratio", "scaling", "box layout", "painting", "SaveAs"};
+  return (phase < n_phases) ? phaseNames[phase] : "unknown";
+}
+
+//**************************************************************************************************
+/**
+ * Stores the timing of one phase.
+ */
+//**************************************************************************************************
+void Profiler::AddRecord(phase_t phase, string context, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+  using std::chrono::microseconds;
+  using std::chrono::duration_cast;
+  static map<std::thread::id, uint32_t> threadIDs;
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto threadID = threadIDs.try_emplace(std::this_thread::get_id(), threadIDs.size()).first->second;
+  mRecords.push_back({phase, std::move(context), duration_cast<microseconds>(start - mStartTime).count(), duration_cast<microseconds>(end - start).count(), threadID});
+}
+
+//**************************************************************************************************
+/**
+ * Prints the time spent in each phase as well as the most expensive plots and input files.
+ * Painting includes the time of clone, projection, ratio, scaling and box layout.
+ */
+//**************************************************************************************************
+void Profiler::PrintSummary(uint32_t nEntries) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mRecords.empty()) {
+    INFO("No timing information was recorded.");
+    return;
+  }
+  struct stats_t {
+    uint32_t calls{};
+    int64_t total{};
+    int64_t max{};
+  };
+  array<stats_t, n_phases> phaseStats{};
+  map<string, int64_t> plotTimes;
+  map<string, int64_t> fileTimes;
+  for (auto& record : mRecords) {
+    auto& stats = phaseStats[record.phase];
+    ++stats.calls;
+    stats.total += record.duration;
+    stats.max = std::max(stats.max, record.duration);
+    if (record.phase <= event_loop) {
+      fileTimes[record.context] += record.duration;
+    } else if (record.phase == painting || record.phase == save_as) {
+      plotTimes[record.context] += record.duration;
+    }
+  }
+
+  PRINT("");
+  PRINT("{:<14} {:>8} {:>12} {:>12} {:>12}", "phase", "calls", "total [ms]", "mean [ms]", "max [ms]");
+  PRINT("{:-<62}", "");
+  for (uint8_t phase = 0; phase < n_phases; ++phase) {
+    auto& stats = phaseStats[phase];
+    if (!stats.calls) continue;
+    PRINT("{:<14} {:>8} {:>12.3f} {:>12.3f} {:>12.3f}", GetPhaseName(static_cast<phase_t>(phase)), stats.calls,
+          stats.total / 1e3, stats.total / 1e3 / stats.calls, stats.max / 1e3);
+  }
+
+  auto printMostExpensive = [nEntries](const map<string, int64_t>& times, const string& title) {
+    if (times.empty()) return;
+    vector<std::pair<string, int64_t>> sortedTimes(times.begin(), times.end());
+    std::sort(sortedTimes.begin(), sortedTimes.end(), [](auto& a, auto& b) { return a.second > b.second; });
+    if (sortedTimes.size() > nEntries) sortedTimes.resize(nEntries);
+    PRINT("");
+    PRINT("{:<48} {:>12}", title, "total [ms]");
+    PRINT("{:-<62}", "");
+    for (auto& [name, time] : sortedTimes) {
+      PRINT("{:<48} {:>12.3f}", name, time / 1e3);
+    }
+  };
+  printMostExpensive(plotTimes, "plot");
+  printMostExpensive(fileTimes, "input file");
+  PRINT("");
+}
+
+//**************************************************************************************************
+/**
+ * Writes all recorded timings to a Chrome trace-event file.
+ */
+//**************************************************************************************************
+bool Profiler::WriteTrace(const string& fileName) const
+{
+  std::ofstream output(fileName);
+  if (!output) {
+    ERROR("Could not write trace to {}.", fileName);
+    return false;
+  }
+  auto escape = [](const string& str) {
+    string escaped;
+    for (char c : str) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        escaped += fmt::format("\\u{:04x}", static_cast<int32_t>(c));
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  };
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  output << R"({"displayTimeUnit": "ms", "traceEvents": [)";
+  bool isFirst = true;
+  for (auto& record : mRecords) {
+    output << fmt::format(R"({}{{"name": "{}", "cat": "{}", "ph": "X", "ts": {}, "dur": {}, "pid": 1, "tid": {}, "args": {{"context": "{}"}}}})",
+                          (isFirst) ? "\n" : ",\n", GetPhaseName(record.phase), (record.phase <= event_loop) ? "input" : "plot",
+                          record.start, record.duration, record.threadID, escape(record.context));
+    isFirst = false;
+  }
+  output << "\n]}\n";
+  INFO("Wrote trace with {} events to {}.", mRecords.size(), fileName);
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Removes all recorded timings.
+ */
+//**************************************************************************************************
+void Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mRecords.clear();
+}
+
+} // end namespace PlottingFramework
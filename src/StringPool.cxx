@@ -0,0 +1,78 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// framework dependencies
+#include "StringPool.h"
+#include "Logging.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Global interning table.
+ */
+//**************************************************************************************************
+StringPool& StringPool::Instance()
+{
+  static StringPool* pool = new StringPool(); // never destroyed, since names may be used until the very end
+  return *pool;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor. Reserves ID 0 for the empty string.
+ */
+//**************************************************************************************************
+StringPool::StringPool()
+{
+  mChunks[0].store(new string[kChunkSize], std::memory_order_release);
+  mIDs.emplace(std::string_view(mChunks[0].load()[0]), 0);
+  mSize = 1;
+}
+
+//**************************************************************************************************
+/**
+ * Returns the ID of the string (adds it to the table if it is not yet known).
+ */
+//**************************************************************************************************
+StringPool::id_t StringPool::Intern(std::string_view str)
+{
+  if (str.empty()) return 0;
+  StringPool& pool = Instance();
+  std::lock_guard<std::mutex> lock(pool.mMutex);
+  if (auto it = pool.mIDs.find(str); it != pool.mIDs.end()) return it->second;
+
+  id_t id = pool.mSize.load(std::memory_order_relaxed);
+  if (id / kChunkSize >= kMaxChunks) {
+    ERROR("Too many different names (> {}).", kChunkSize * kMaxChunks);
+    std::exit(EXIT_FAILURE);
+  }
+  string* chunk = pool.mChunks[id / kChunkSize].load(std::memory_order_relaxed);
+  if (!chunk) {
+    chunk = new string[kChunkSize];
+    pool.mChunks[id / kChunkSize].store(chunk, std::memory_order_release);
+  }
+  string& stored = chunk[id % kChunkSize];
+  stored = str;
+  pool.mIDs.emplace(std::string_view(stored), id);
+  pool.mSize.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,125 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "TextFile.h"
+#include "Logging.h"
+
+// std dependencies
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// zlib dependencies
+#include <zlib.h>
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Destructor.
+ */
+//**************************************************************************************************
+TextFile::~TextFile()
+{
+  Close();
+}
+
+//**************************************************************************************************
+/**
+ * Release the file content.
+ */
+//**************************************************************************************************
+void TextFile::Close()
+{
+  if (mMappedContent) munmap(mMappedContent, mMappedSize);
+  mMappedContent = nullptr;
+  mMappedSize = 0;
+  mInflatedContent.clear();
+  mInflatedContent.shrink_to_fit();
+  mContent = {};
+}
+
+//**************************************************************************************************
+/**
+ * Make the content of the file available.
+ */
+//**************************************************************************************************
+bool TextFile::Open(const string& fileName)
+{
+  Close();
+  if (!std::filesystem::exists(fileName)) {
+    ERROR("Input file {} not found.", fileName);
+    return false;
+  }
+
+  if (fileName.size() > 3 && fileName.compare(fileName.size() - 3, 3, ".gz") == 0) {
+    gzFile file = gzopen(fileName.data(), "rb");
+    if (!file) {
+      ERROR("Cannot open input file {}.", fileName);
+      return false;
+    }
+    gzbuffer(file, 1u << 17);
+    mInflatedContent.reserve(4 * std::filesystem::file_size(fileName)); // typical compression ratio of numeric text
+    constexpr size_t chunkSize = 1u << 20;
+    int32_t nBytes{};
+    do {
+      size_t offset = mInflatedContent.size();
+      mInflatedContent.resize(offset + chunkSize);
+      nBytes = gzread(file, mInflatedContent.data() + offset, chunkSize);
+      mInflatedContent.resize(offset + std::max(nBytes, 0));
+    } while (nBytes > 0);
+    if (nBytes < 0) {
+      int32_t errorCode{};
+      ERROR("Cannot decompress input file {} ({}).", fileName, gzerror(file, &errorCode));
+      gzclose(file);
+      Close();
+      return false;
+    }
+    gzclose(file);
+    mContent = mInflatedContent;
+    return true;
+  }
+
+  int32_t fileDescriptor = open(fileName.data(), O_RDONLY);
+  if (fileDescriptor < 0) {
+    ERROR("Cannot open input file {}.", fileName);
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+    close(fileDescriptor);
+    ERROR("Input file {} is empty.", fileName);
+    return false;
+  }
+  size_t fileSize = fileStatus.st_size;
+  void* content = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  close(fileDescriptor);
+  if (content == MAP_FAILED) {
+    ERROR("Cannot map input file {} to memory.", fileName);
+    return false;
+  }
+  madvise(content, fileSize, MADV_SEQUENTIAL);
+  mMappedContent = content;
+  mMappedSize = fileSize;
+  mContent = {static_cast<const char*>(content), fileSize};
+  return true;
+}
+
+} // end namespace PlottingFramework
@@ -0,0 +1,288 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "TreeFiller.h"
+#include "TextFile.h"
+#include "Profiler.h"
+#include "Helpers.h"
+#include "Logging.h"
+
+// std dependencies
+#include <filesystem>
+
+// root dependencies
+#include "TROOT.h"
+#include "TFile.h"
+#include "TChain.h"
+#include "TH1.h"
+#include "TH2D.h"
+#include "ROOT/RDataFrame.hxx"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Parse the request from the data name (see tree_request_t).
+ */
+//**************************************************************************************************
+optional<tree_request_t> tree_request_t::FromName(const string& name)
+{
+  auto invalidRequest = [&name](const string& reason) {
+    ERROR("Invalid tree request '{}' ({}).", name, reason);
+    return std::nullopt;
+  };
+  size_t treeEnd = name.find("::");
+  size_t binningStart = name.find(">>(", treeEnd);
+  size_t binningEnd = name.find(')', binningStart);
+  if (treeEnd == string::npos || binningStart == string::npos || binningEnd == string::npos) {
+    return invalidRequest("format is <tree>::<expression>>>(<binning>)[|<selection>]");
+  }
+  tree_request_t request;
+  request.tree = trim_blanks(std::string_view(name).substr(0, treeEnd));
+
+  // "y:x" as in TTree::Draw (double colons belong to the expression, e.g. TMath::Abs)
+  std::string_view expression = std::string_view(name).substr(treeEnd + 2, binningStart - treeEnd - 2);
+  size_t start{};
+  for (size_t i = 0; i <= expression.size(); ++i) {
+    bool isSeparator = (i < expression.size() && expression[i] == ':' && (i == 0 || expression[i - 1] != ':') && (i + 1 == expression.size() || expression[i + 1] != ':'));
+    if (!isSeparator && i < expression.size()) continue;
+    request.expressions.insert(request.expressions.begin(), string(trim_blanks(expression.substr(start, i - start))));
+    start = i + 1;
+  }
+
+  std::string_view binning = std::string_view(name).substr(binningStart + 3, binningEnd - binningStart - 3);
+  vector<double_t> numbers;
+  auto addAxis = [&]() {
+    if (numbers.empty()) return true;
+    if (numbers.size() != 3 || numbers[0] < 1 || numbers[1] >= numbers[2]) return false;
+    request.axes.push_back({static_cast<int32_t>(numbers[0]), numbers[1], numbers[2], {}});
+    numbers.clear();
+    return true;
+  };
+  while (!trim_blanks(binning).empty()) {
+    binning = trim_blanks(binning);
+    if (binning.front() == '[') {
+      size_t edgesEnd = binning.find(']');
+      if (edgesEnd == std::string_view::npos || !numbers.empty()) return invalidRequest("malformed bin edges");
+      tree_request_t::axis_t axis;
+      for (auto& edge : split_string(string(binning.substr(1, edgesEnd - 1)), ',')) {
+        double_t value{};
+        if (!parse_number(trim_blanks(edge), value) || (!axis.edges.empty() && value <= axis.edges.back())) return invalidRequest("malformed bin edges");
+        axis.edges.push_back(value);
+      }
+      if (axis.edges.size() < 2) return invalidRequest("malformed bin edges");
+      axis.nBins = axis.edges.size() - 1;
+      request.axes.push_back(std::move(axis));
+      binning.remove_prefix(edgesEnd + 1);
+    } else {
+      size_t numberEnd = binning.find(',');
+      double_t value{};
+      if (!parse_number(trim_blanks(binning.substr(0, numberEnd)), value)) return invalidRequest("malformed binning");
+      numbers.push_back(value);
+      if (numbers.size() == 3 && !addAxis()) return invalidRequest("malformed binning");
+      binning.remove_prefix((numberEnd == std::string_view::npos) ? binning.size() : numberEnd);
+    }
+    binning = trim_blanks(binning);
+    if (!binning.empty() && binning.front() == ',') binning.remove_prefix(1);
+  }
+  if (!numbers.empty()) return invalidRequest("malformed binning");
+  if (request.expressions.size() > 2 || request.expressions.size() != request.axes.size()) {
+    return invalidRequest("one or two expressions with corresponding binning are required");
+  }
+  if (request.tree.empty() || std::any_of(request.expressions.begin(), request.expressions.end(), [](auto& expr) { return expr.empty(); })) {
+    return invalidRequest("tree and expressions must not be empty");
+  }
+
+  std::string_view selection = trim_blanks(std::string_view(name).substr(binningEnd + 1));
+  if (!selection.empty()) {
+    if (selection.front() != '|') return invalidRequest("selection must be separated by '|'");
+    request.selection = trim_blanks(selection.substr(1));
+  }
+  return request;
+}
+
+//**************************************************************************************************
+/**
+ * Constructor.
+ */
+//**************************************************************************************************
+TreeFiller::TreeFiller(const string& cacheFileName, uint32_t nThreads) : mCacheFileName{cacheFileName}, mNumThreads{nThreads}
+{
+}
+
+//**************************************************************************************************
+/**
+ * Identifier of the result in the cache file.
+ */
+//**************************************************************************************************
+string TreeFiller::GetCacheKey(const string& requestName, const vector<string>& inputFileNames) const
+{
+  string state = requestName;
+  for (auto& inputFileName : inputFileNames) {
+    string fileName = split_string(inputFileName, ':', true)[0];
+    std::error_code errorCode;
+    auto size = std::filesystem::file_size(fileName, errorCode);
+    auto modificationTime = std::filesystem::last_write_time(fileName, errorCode).time_since_epoch().count();
+    state += fmt::format("|{}:{}:{}", inputFileName, size, modificationTime);
+  }
+  return fmt::format("request_{:016x}", std::hash<string>{}(state));
+}
+
+//**************************************************************************************************
+/**
+ * Fill the requested histograms; results that are available in the cache are taken from there.
+ */
+//**************************************************************************************************
+bool TreeFiller::Fill(const vector<string>& inputFileNames, const vector<string>& requestNames, const string& context)
+{
+  mObjects.clear();
+  bool success = true;
+  map<string, vector<std::pair<string, tree_request_t>>> requestsPerTree;
+  map<string, string> cacheKeys;
+  unique_ptr<TFile> cacheFile;
+  if (!mCacheFileName.empty() && std::filesystem::exists(mCacheFileName)) {
+    cacheFile.reset(TFile::Open(mCacheFileName.data(), "READ"));
+  }
+  for (auto& name : requestNames) {
+    auto request = tree_request_t::FromName(name);
+    if (!request) {
+      success = false;
+      continue;
+    }
+    if (!mCacheFileName.empty()) {
+      cacheKeys[name] = GetCacheKey(name, inputFileNames);
+      if (cacheFile && !cacheFile->IsZombie()) {
+        if (auto histo = dynamic_cast<TH1*>(cacheFile->Get(cacheKeys[name].data()))) {
+          histo->SetDirectory(nullptr);
+          mObjects[name].reset(histo);
+          continue;
+        }
+      }
+    }
+    requestsPerTree[request->tree].emplace_back(name, std::move(*request));
+  }
+  cacheFile.reset();
+  if (requestsPerTree.empty()) return success;
+
+#ifdef R__USE_IMT
+  if (!ROOT::IsImplicitMTEnabled() && mNumThreads != 1) ROOT::EnableImplicitMT(mNumThreads);
+#endif
+  vector<string> filledNames;
+  for (auto& [tree, requests] : requestsPerTree) {
+    success &= FillTree(tree, requests, inputFileNames, context);
+    for (auto& [name, request] : requests) {
+      if (mObjects.find(name) != mObjects.end()) filledNames.push_back(name);
+    }
+  }
+
+  if (!mCacheFileName.empty() && !filledNames.empty()) {
+    TFile cache(mCacheFileName.data(), "UPDATE");
+    if (cache.IsZombie()) {
+      WARNING("Cannot write results of event loop to cache file {}.", mCacheFileName);
+    } else {
+      for (auto& name : filledNames) {
+        mObjects[name]->Write(cacheKeys[name].data(), TObject::kOverwrite);
+      }
+    }
+  }
+  return success;
+}
+
+//**************************************************************************************************
+/**
+ * Book all requests for a tree and run the event loop once.
+ */
+//**************************************************************************************************
+bool TreeFiller::FillTree(const string& tree, const vector<std::pair<string, tree_request_t>>& requests, const vector<string>& inputFileNames, const string& context)
+{
+  TChain chain(tree.data());
+  for (auto& inputFileName : inputFileNames) {
+    // "file.root:dir" -> "file.root/dir/tree"
+    auto fileNameDir = split_string(inputFileName, ':', true);
+    string treePath = (fileNameDir.size() > 1) ? fileNameDir[1] + "/" + tree : tree;
+    chain.Add((fileNameDir[0] + "/" + treePath).data());
+  }
+
+  try {
+    ROOT::RDataFrame dataFrame(chain);
+    // columns for all expressions that are not simply a branch name
+    ROOT::RDF::RNode definitions = dataFrame;
+    auto branches = dataFrame.GetColumnNames();
+    map<string, string> columns; // expression, column name
+    for (auto& [name, request] : requests) {
+      for (auto& expression : request.expressions) {
+        if (columns.find(expression) != columns.end()) continue;
+        if (std::find(branches.begin(), branches.end(), expression) != branches.end()) {
+          columns[expression] = expression;
+        } else {
+          string column = "expression_" + std::to_string(columns.size());
+          definitions = definitions.Define(column, expression);
+          columns[expression] = column;
+        }
+      }
+    }
+    // one filter per selection
+    map<string, ROOT::RDF::RNode> selections;
+    for (auto& [name, request] : requests) {
+      if (selections.find(request.selection) != selections.end()) continue;
+      selections.emplace(request.selection, (request.selection.empty()) ? definitions : ROOT::RDF::RNode(definitions.Filter(request.selection)));
+    }
+
+    vector<std::pair<string, ROOT::RDF::RResultPtr<TH1D>>> histos1d;
+    vector<std::pair<string, ROOT::RDF::RResultPtr<TH2D>>> histos2d;
+    for (auto& [name, request] : requests) {
+      auto& node = selections.at(request.selection);
+      auto& x = request.axes[0];
+      if (request.expressions.size() == 1) {
+        ROOT::RDF::TH1DModel model = (x.edges.empty()) ? ROOT::RDF::TH1DModel(name.data(), "", x.nBins, x.min, x.max) : ROOT::RDF::TH1DModel(name.data(), "", x.nBins, x.edges.data());
+        histos1d.emplace_back(name, node.Histo1D(model, columns[request.expressions[0]]));
+        continue;
+      }
+      auto& y = request.axes[1];
+      ROOT::RDF::TH2DModel model;
+      if (x.edges.empty() && y.edges.empty()) {
+        model = ROOT::RDF::TH2DModel(name.data(), "", x.nBins, x.min, x.max, y.nBins, y.min, y.max);
+      } else if (y.edges.empty()) {
+        model = ROOT::RDF::TH2DModel(name.data(), "", x.nBins, x.edges.data(), y.nBins, y.min, y.max);
+      } else if (x.edges.empty()) {
+        model = ROOT::RDF::TH2DModel(name.data(), "", x.nBins, x.min, x.max, y.nBins, y.edges.data());
+      } else {
+        model = ROOT::RDF::TH2DModel(name.data(), "", x.nBins, x.edges.data(), y.nBins, y.edges.data());
+      }
+      histos2d.emplace_back(name, node.Histo2D(model, columns[request.expressions[0]], columns[request.expressions[1]]));
+    }
+
+    // accessing the first result runs the event loop that fills all booked histograms
+    ScopedTimer timer(Profiler::event_loop, context + tree);
+    auto takeResult = [&](const string& name, TH1* histo) {
+      auto result = static_cast<TH1*>(histo->Clone());
+      result->SetDirectory(nullptr);
+      mObjects[name].reset(result);
+    };
+    for (auto& [name, histo] : histos1d) takeResult(name, histo.GetPtr());
+    for (auto& [name, histo] : histos2d) takeResult(name, histo.GetPtr());
+    timer.Stop();
+    INFO("Filled {} histogram{} from tree {} ({} events).", requests.size(), (requests.size() == 1) ? "" : "s", tree, chain.GetEntries());
+  } catch (const std::exception& exception) {
+    ERROR("Event loop over tree {} failed: {}", tree, exception.what());
+    return false;
+  }
+  return true;
+}
+
+} // end namespace PlottingFramework
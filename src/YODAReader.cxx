@@ -0,0 +1,312 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "YODAReader.h"
+#include "TextFile.h"
+#include "Logging.h"
+
+// std dependencies
+#include <cmath>
+#include <numeric>
+
+// root dependencies
+#include "TH1D.h"
+#include "TGraphAsymmErrors.h"
+
+namespace PlottingFramework
+{
+
+//**************************************************************************************************
+/**
+ * Append the numbers at the beginning of a whitespace separated line to values.
+ */
+//**************************************************************************************************
+static void parse_row(std::string_view line, vector<double_t>& values)
+{
+  line = trim_blanks(line);
+  while (!line.empty()) {
+    size_t end = line.find_first_of(" \t");
+    double_t value{};
+    if (!parse_number(line.substr(0, end), value)) return;
+    values.push_back(value);
+    line = trim_blanks(line.substr((end == std::string_view::npos) ? line.size() : end));
+  }
+}
+
+//**************************************************************************************************
+/**
+ * Parse list of numbers in brackets, e.g. "[0.0, 1.5, 3.0]".
+ */
+//**************************************************************************************************
+static bool parse_list(std::string_view list, vector<double_t>& values)
+{
+  list = trim_blanks(list);
+  if (list.size() < 2 || list.front() != '[' || list.back() != ']') return false;
+  list = list.substr(1, list.size() - 2);
+  values.clear();
+  while (!trim_blanks(list).empty()) {
+    size_t end = list.find(',');
+    double_t value{};
+    if (!parse_number(trim_blanks(list.substr(0, end)), value)) return false;
+    values.push_back(value);
+    list.remove_prefix((end == std::string_view::npos) ? list.size() : end + 1);
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Check if file is a (possibly gzip compressed) yoda file.
+ */
+//**************************************************************************************************
+bool YODAReader::IsYODAFile(const string& fileName)
+{
+  string name = fileName;
+  auto endsWith = [&name](const string& suffix) { return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0; };
+  if (endsWith(".gz")) name.resize(name.size() - 3);
+  return endsWith(".yoda");
+}
+
+//**************************************************************************************************
+/**
+ * Read the required objects from the file. The content of all other objects is skipped.
+ */
+//**************************************************************************************************
+bool YODAReader::Read(const string& fileName, const vector<string>& requiredNames)
+{
+  mObjects.clear();
+  TextFile file;
+  if (!file.Open(fileName)) return false;
+  std::string_view content = file.GetContent();
+  std::set<string, std::less<>> missingNames(requiredNames.begin(), requiredNames.end());
+
+  const std::string_view beginTag = "BEGIN YODA_";
+  const std::string_view endTag = "END YODA_";
+  size_t position{};
+  std::string_view line;
+  while (!missingNames.empty() && next_line(content, position, line)) {
+    // objects start with e.g. "BEGIN YODA_HISTO1D_V2 /ALICE_2019_I1234567/d01-x01-y01"
+    line = trim_blanks(line);
+    if (line.compare(0, beginTag.size(), beginTag) != 0) continue;
+    line.remove_prefix(beginTag.size());
+    size_t typeEnd = line.find_first_of(" \t");
+    std::string_view type = line.substr(0, typeEnd);
+    std::string_view path = (typeEnd == std::string_view::npos) ? "" : trim_blanks(line.substr(typeEnd));
+    if (!path.empty() && path.front() == '/') path.remove_prefix(1);
+    uint8_t version = 1;
+    if (auto versionPos = type.rfind("_V"); versionPos != std::string_view::npos) {
+      std::from_chars(type.data() + versionPos + 2, type.data() + type.size(), version);
+      type = type.substr(0, versionPos);
+    }
+
+    size_t bodyEnd = content.find(endTag, position);
+    if (bodyEnd == std::string_view::npos) {
+      ERROR("Object {} in {} is not terminated.", path, fileName);
+      return false;
+    }
+    std::string_view body = content.substr(position, bodyEnd - position);
+    position = bodyEnd;
+
+    auto name = missingNames.find(path);
+    if (name == missingNames.end()) continue;
+    if (auto object = ParseObject(*name, type, version, body, fileName)) {
+      mObjects[*name] = std::move(object);
+    }
+    missingNames.erase(name);
+  }
+  return true;
+}
+
+//**************************************************************************************************
+/**
+ * Convert the body of a yoda object to the corresponding root object.
+ */
+//**************************************************************************************************
+unique_ptr<TObject> YODAReader::ParseObject(const string& name, std::string_view type, uint8_t version, std::string_view body, const string& fileName)
+{
+  bool isHisto = (type == "HISTO1D");
+  bool isScatter = (type == "SCATTER2D");
+  bool isEstimate = (type == "ESTIMATE1D");
+  if (!(isHisto || isScatter || isEstimate)) {
+    WARNING("Object {} in {} is of unsupported type {}.", name, fileName, type);
+    return nullptr;
+  }
+  if (isEstimate && version < 3) {
+    // estimates were introduced with version 3, older ones do not provide the required bin edges
+    WARNING("Estimate {} in {} is of unsupported format version {}.", name, fileName, version);
+    return nullptr;
+  }
+
+  string title;
+  vector<double_t> edges;  // axis of version 3 objects
+  vector<double_t> values; // rows of numbers (all with the same number of columns)
+  size_t nColumns{};
+  vector<double_t> totalRow, underflowRow, overflowRow; // version 1 and 2 histograms
+  vector<double_t> row;
+  size_t position{};
+  std::string_view line;
+  while (next_line(body, position, line)) {
+    line = trim_blanks(line);
+    if (line.empty() || line.front() == '#' || line == "---") continue;
+    row.clear();
+    parse_row(line, row);
+    if (!row.empty()) {
+      if (!nColumns) nColumns = row.size();
+      if (row.size() != nColumns) {
+        ERROR("Object {} in {} contains rows with different number of columns.", name, fileName);
+        return nullptr;
+      }
+      values.insert(values.end(), row.begin(), row.end());
+      continue;
+    }
+    // "Total    Total    sumw  sumw2  sumwx  sumwx2  numEntries"
+    bool isSpecialRow = false;
+    for (auto [label, specialRow] : {std::pair{"Total", &totalRow}, std::pair{"Underflow", &underflowRow}, std::pair{"Overflow", &overflowRow}}) {
+      std::string_view labelView{label};
+      if (line.compare(0, labelView.size(), labelView) != 0) continue;
+      line.remove_prefix(labelView.size());
+      line = trim_blanks(line);
+      if (line.compare(0, labelView.size(), labelView) == 0) line.remove_prefix(labelView.size());
+      parse_row(line, *specialRow);
+      isSpecialRow = true;
+    }
+    if (isSpecialRow) continue;
+    // meta data is stored as "Key: value" (version 1: "Key=value")
+    size_t separator = line.find((version < 2) ? '=' : ':');
+    if (separator == std::string_view::npos) continue;
+    std::string_view key = trim_blanks(line.substr(0, separator));
+    std::string_view value = trim_blanks(line.substr(separator + 1));
+    if (key == "Title") {
+      title = value;
+    } else if (key == "Edges(A1)" && !parse_list(value, edges)) {
+      WARNING("Object {} in {} has unsupported (non-numeric) binning.", name, fileName);
+      return nullptr;
+    }
+  }
+
+  size_t nRows = (nColumns) ? values.size() / nColumns : 0u;
+  auto at = [&](size_t row, size_t column) { return values[row * nColumns + column]; };
+  bool hasEdges = (version >= 3 && !isScatter);
+  if (hasEdges && (edges.size() < 2 || nRows != edges.size() + 1)) {
+    ERROR("Number of bins of object {} in {} does not match its binning.", name, fileName);
+    return nullptr;
+  }
+
+  if (isHisto) {
+    // version 1 and 2: "xlow  xhigh  sumw  sumw2  sumwx  sumwx2  numEntries"
+    // version 3: "sumW  sumW2  sumW(A1)  sumW2(A1)  numEntries" incl. underflow and overflow rows
+    size_t offset = (hasEdges) ? 0u : 2u;
+    if (nColumns < offset + 5) {
+      ERROR("Unexpected format of histogram {} in {}.", name, fileName);
+      return nullptr;
+    }
+    vector<int32_t> bins(nRows);
+    if (hasEdges) {
+      std::iota(bins.begin(), bins.end(), 0);
+    } else {
+      for (size_t i = 0; i < nRows; ++i) {
+        double_t xLow = at(i, 0);
+        double_t xHigh = at(i, 1);
+        if (edges.empty()) {
+          edges.push_back(xLow);
+        } else if (xLow - edges.back() > 1e-9 * (xHigh - xLow)) {
+          edges.push_back(xLow); // gap between bins is filled by an empty bin
+        } else if (edges.back() - xLow > 1e-9 * (xHigh - xLow)) {
+          ERROR("Bins of histogram {} in {} are overlapping or not sorted.", name, fileName);
+          return nullptr;
+        }
+        edges.push_back(xHigh);
+        bins[i] = edges.size() - 1;
+      }
+      if (edges.size() < 2) {
+        ERROR("Histogram {} in {} has no bins.", name, fileName);
+        return nullptr;
+      }
+    }
+    int32_t nBins = edges.size() - 1;
+    auto histo = std::make_unique<TH1D>(name.data(), title.data(), nBins, edges.data());
+    histo->SetDirectory(nullptr);
+    histo->Sumw2();
+    double_t stats[4]{};
+    double_t nEntries{};
+    auto fillBin = [&](int32_t bin, const double_t* columns) {
+      histo->SetBinContent(bin, columns[0]);
+      histo->SetBinError(bin, std::sqrt(columns[1]));
+    };
+    for (size_t i = 0; i < nRows; ++i) {
+      const double_t* columns = &values[i * nColumns + offset];
+      fillBin(bins[i], columns);
+      for (size_t j = 0; j < 4; ++j) stats[j] += columns[j];
+      nEntries += columns[4];
+    }
+    if (underflowRow.size() >= 2) fillBin(0, underflowRow.data());
+    if (overflowRow.size() >= 2) fillBin(nBins + 1, overflowRow.data());
+    if (totalRow.size() >= 5) {
+      std::copy_n(totalRow.begin(), 4, stats);
+      nEntries = totalRow[4];
+    }
+    histo->PutStats(stats);
+    histo->SetEntries(nEntries);
+    return histo;
+  }
+
+  vector<double_t> x, y, exl, exh, eyl, eyh;
+  if (isScatter) {
+    // "xval  xerr-  xerr+  yval  yerr-  yerr+"
+    if (nColumns < 6) {
+      ERROR("Unexpected format of scatter {} in {}.", name, fileName);
+      return nullptr;
+    }
+    for (size_t i = 0; i < nRows; ++i) {
+      x.push_back(at(i, 0));
+      exl.push_back(std::abs(at(i, 1)));
+      exh.push_back(std::abs(at(i, 2)));
+      y.push_back(at(i, 3));
+      eyl.push_back(std::abs(at(i, 4)));
+      eyh.push_back(std::abs(at(i, 5)));
+    }
+  } else {
+    // "value  errDn(1)  errUp(1)  errDn(2)  errUp(2) ..." incl. underflow and overflow rows
+    if (nColumns % 2 != 1) {
+      ERROR("Unexpected format of estimate {} in {}.", name, fileName);
+      return nullptr;
+    }
+    for (size_t i = 1; i + 1 < nRows; ++i) {
+      if (std::isnan(at(i, 0))) continue;
+      double_t errDown2{}, errUp2{};
+      for (size_t j = 1; j + 1 < nColumns; j += 2) {
+        double_t down = std::min({at(i, j), at(i, j + 1), 0.});
+        double_t up = std::max({at(i, j), at(i, j + 1), 0.});
+        errDown2 += down * down;
+        errUp2 += up * up;
+      }
+      double_t halfWidth = (edges[i] - edges[i - 1]) / 2;
+      x.push_back(edges[i - 1] + halfWidth);
+      exl.push_back(halfWidth);
+      exh.push_back(halfWidth);
+      y.push_back(at(i, 0));
+      eyl.push_back(std::sqrt(errDown2));
+      eyh.push_back(std::sqrt(errUp2));
+    }
+  }
+  auto graph = std::make_unique<TGraphAsymmErrors>(x.size(), x.data(), y.data(), exl.data(), exh.data(), eyl.data(), eyh.data());
+  graph->SetName(name.data());
+  graph->SetTitle(title.data());
+  return graph;
+}
+
+} // end namespace PlottingFramework
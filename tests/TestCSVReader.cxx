@@ -0,0 +1,107 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "CSVReader.h"
+#include "TextFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <fmt/core.h>
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Checks the number parsing shared by the text based readers (including the strtod fallback) and
+ * reads csv files with a schema as well as in the classic format.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+
+  // both implementations must accept and reject the same fields
+  vector<std::pair<string, optional<double_t>>> fields{
+    {"1.5", 1.5}, {"+2", 2.}, {"-3e2", -300.}, {".5", 0.5}, {"", std::nullopt}, {"+", std::nullopt}, {"++1", std::nullopt}, {"+-1", std::nullopt},
+    {" 1", std::nullopt}, {"1 ", std::nullopt}, {"1e400", std::nullopt}, {"abc", std::nullopt}, {"1,5", std::nullopt}, {"0x10", std::nullopt}};
+  for (auto& [field, expected] : fields) {
+    double_t value{};
+    bool parsed = parse_number(field, value);
+    check(parsed == expected.has_value() && (!parsed || value == *expected), fmt::format("parse_number handles '{}'", field));
+    // the fallback is only used for fields without leading '+'
+    if (!field.empty() && field.front() == '+') continue;
+    double_t fallbackValue{};
+    bool fallbackParsed = parse_number_strtod(field, fallbackValue);
+    check(fallbackParsed == expected.has_value() && (!fallbackParsed || fallbackValue == *expected), fmt::format("strtod fallback handles '{}'", field));
+  }
+
+  const string schemaFile = "test_csv_reader_schema.csv";
+  const string classicFile = "test_csv_reader_classic.csv";
+  std::ofstream(schemaFile) << "# efficiency scan\n"
+                               "energy; eff; eff_err\n"
+                               "1; 0.5; 0.1\n"
+                               "+2; 0.75; 0.05\n"
+                               "3; bad; 0.1\n"
+                               "4; 1e400; 0.1\n"
+                               "5; 0.9\n"
+                               "\n";
+  std::ofstream(classicFile) << "1 10\n"
+                                "2\t20 0.5 1\n";
+
+  auto schema = csv_schema_t::FromString("header,delimiter=semicolon,x=energy,y=eff,ey=eff_err");
+  check(schema.has_value(), "valid csv options are accepted");
+  if (schema) {
+    CSVReader reader(*schema);
+    check(reader.Read(schemaFile), "csv file with header can be read");
+    check(reader.GetNumRows() == 2, "rows that cannot be parsed or miss fields are skipped");
+    auto x = reader.GetColumn("energy");
+    auto y = reader.GetColumn("eff");
+    auto ey = reader.GetColumn("2");
+    check(x && y && ey, "columns can be accessed by name and index");
+    if (x && y && ey) {
+      check(*x == vector<double_t>{1., 2.}, "x values are read");
+      check(*y == vector<double_t>{0.5, 0.75}, "y values are read");
+      check(*ey == vector<double_t>{0.1, 0.05}, "error values are read");
+    }
+  }
+
+  CSVReader classicReader(csv_schema_t{});
+  check(classicReader.Read(classicFile), "csv file in classic format can be read");
+  check(classicReader.GetNumRows() == 2, "all rows of classic format are read");
+  if (auto ey = classicReader.GetColumn("3")) {
+    check(*ey == vector<double_t>{0., 1.}, "missing optional error columns are set to zero");
+  } else {
+    check(false, "error columns are read in classic format");
+  }
+
+  check(!csv_schema_t::FromString("y=a,ey=b|c"), "mismatching number of error columns is rejected");
+  check(!csv_schema_t::FromString("y=a,ey=b,eyl=c"), "mixing symmetric and asymmetric errors is rejected");
+
+  for (auto& fileName : {schemaFile, classicFile}) {
+    std::filesystem::remove(fileName);
+  }
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "ChunkedSparse.h"
+
+#include <filesystem>
+#include <fmt/core.h>
+
+#include "TFile.h"
+#include "TH1.h"
+#include "THnSparse.h"
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Writes a two-dimensional sparse histogram with the specified filled bins to a file.
+ */
+//**************************************************************************************************
+static void write_sparse(const string& fileName, const vector<std::pair<double_t, double_t>>& points, double_t xUp = 10.)
+{
+  int32_t nBins[2]{10, 10};
+  double_t xMin[2]{0., 0.};
+  double_t xMax[2]{xUp, 10.};
+  THnSparseD sparse("sparse", "sparse", 2, nBins, xMin, xMax);
+  sparse.Sumw2();
+  for (auto& [x, y] : points) {
+    double_t coordinates[2]{x, y};
+    sparse.Fill(coordinates, 2.);
+  }
+  TFile file(fileName.data(), "RECREATE");
+  file.WriteTObject(&sparse);
+}
+
+//**************************************************************************************************
+/**
+ * Converts overlapping sparse histograms into chunks and checks that the projection streamed from
+ * the chunks equals the sum of the projections of the inputs.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+
+  const string inputA = "test_chunked_sparse_a.root";
+  const string inputB = "test_chunked_sparse_b.root";
+  const string inputC = "test_chunked_sparse_c.root";
+  const string output = "test_chunked_sparse_out.root";
+  for (auto& fileName : {inputA, inputB, inputC, output}) {
+    std::filesystem::remove(fileName);
+  }
+  write_sparse(inputA, {{0.5, 0.5}, {1.5, 2.5}, {2.5, 2.5}, {5.5, 7.5}, {8.5, 9.5}});
+  write_sparse(inputB, {{0.5, 0.5}, {1.5, 2.5}, {3.5, 4.5}, {8.5, 9.5}, {8.5, 9.5}});
+  write_sparse(inputC, {{0.5, 0.5}}, 20.);
+
+  // chunks of three bins, such that overlapping bins end up in the same as well as in different chunks
+  bool converted = ChunkedSparse::Convert({inputA + ":sparse", inputB + ":sparse"}, output, "sparse", 3);
+  check(converted, "conversion of compatible inputs succeeds");
+
+  unique_ptr<TH1> expected;
+  for (auto& fileName : {inputA, inputB}) {
+    TFile file(fileName.data(), "READ");
+    unique_ptr<THnSparse> sparse(dynamic_cast<THnSparse*>(file.Get("sparse")));
+    unique_ptr<TH1> projection(sparse->Projection(0));
+    projection->SetDirectory(nullptr);
+    if (expected) {
+      expected->Add(projection.get());
+    } else {
+      expected = std::move(projection);
+    }
+  }
+
+  unique_ptr<TH1> projection;
+  double_t nEntries{};
+  if (converted) {
+    TFile file(output.data(), "READ");
+    unique_ptr<TObject> placeholder(file.Get("sparse"));
+    check(ChunkedSparse::IsPlaceholder(placeholder.get()), "output contains the placeholder");
+    ChunkedSparse::SetFileName(placeholder.get(), output);
+    bool success = ChunkedSparse::ForEachChunk(placeholder.get(), [&](THnBase* chunk) {
+      unique_ptr<TH1> chunkProjection(chunk->Projection(0));
+      chunkProjection->SetDirectory(nullptr);
+      nEntries += chunk->GetEntries();
+      if (projection) {
+        projection->Add(chunkProjection.get());
+      } else {
+        projection = std::move(chunkProjection);
+      }
+      return true;
+    });
+    check(success && projection, "chunks can be read");
+  }
+  if (projection) {
+    check(projection->GetNbinsX() == expected->GetNbinsX(), "projection has the binning of the inputs");
+    for (int32_t bin = 0; bin <= expected->GetNbinsX() + 1; ++bin) {
+      check(std::abs(projection->GetBinContent(bin) - expected->GetBinContent(bin)) < 1e-9, fmt::format("content of bin {} equals the sum of the inputs", bin));
+      check(std::abs(projection->GetBinError(bin) - expected->GetBinError(bin)) < 1e-9, fmt::format("error of bin {} equals the one of the summed inputs", bin));
+    }
+    check(std::abs(nEntries - 10.) < 1e-9, "number of entries equals the sum of the inputs");
+  }
+
+  std::filesystem::remove(output);
+  check(!ChunkedSparse::Convert({inputA + ":sparse", inputC + ":sparse"}, output, "sparse", 3), "inputs with different binning are rejected");
+
+  for (auto& fileName : {inputA, inputB, inputC, output}) {
+    std::filesystem::remove(fileName);
+  }
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
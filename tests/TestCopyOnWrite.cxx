@@ -0,0 +1,114 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "CopyOnWrite.h"
+#include "Plot.h"
+
+#include <fmt/core.h>
+
+namespace PlottingFramework
+{
+//**************************************************************************************************
+/**
+ * Gives the tests access to the internals of the plot.
+ */
+//**************************************************************************************************
+class TestAccess
+{
+public:
+  static uint8_t GetDataCount(const Plot& plot) { return plot.GetDataCount(); }
+  static size_t GetPadCount(const Plot& plot) { return plot.GetPads().size(); }
+  static ptree GetPropertyTree(const Plot& plot) { return plot.GetPropertyTree(); }
+  static Plot SharedCopy(const Plot& plot) { return plot.SharedCopy(); }
+  static bool SharesPads(const Plot& plot, const Plot& otherPlot) { return &plot.GetPads() == &otherPlot.GetPads(); }
+};
+} // end namespace PlottingFramework
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Checks the sharing semantics of plot copies and that moved-from plots remain usable.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+
+  cow_ptr<vector<int32_t>> values(std::make_shared<vector<int32_t>>(vector<int32_t>{1, 2, 3}));
+  cow_ptr<vector<int32_t>> copiedValues = values;
+  check(values.IsShared() && copiedValues.IsShared(), "copies share their pointee");
+  copiedValues.Mutable().push_back(4);
+  check(!values.IsShared() && values->size() == 3 && copiedValues->size() == 4, "modified copy is detached from the original");
+  cow_ptr<vector<int32_t>> movedValues = std::move(values);
+  check(movedValues->size() == 3 && values->empty(), "moved-from pointer holds a default-constructed pointee");
+  values = std::move(copiedValues);
+  check(values->size() == 4 && copiedValues->empty(), "move assignment leaves a default-constructed pointee behind");
+
+  Plot plot("plot", "group/category");
+  plot[1].AddData("hist", "input");
+  Plot copiedPlot = plot;
+  copiedPlot[1].AddData("otherHist", "input");
+  check(TestAccess::GetDataCount(plot) == 1 && TestAccess::GetDataCount(copiedPlot) == 2, "modifying a plot copy does not change the original");
+
+  // references obtained before copying must not modify the copies
+  Plot::Pad& pad = plot[1];
+  Plot::Pad::Data& data = pad.AddData("referencedHist", "input");
+  Plot namedCopy(plot, "namedCopy", "group");
+  Plot plainCopy = plot;
+  Plot assignedCopy;
+  assignedCopy = plot;
+  ptree namedCopyTree = TestAccess::GetPropertyTree(namedCopy);
+  ptree plainCopyTree = TestAccess::GetPropertyTree(plainCopy);
+  ptree assignedCopyTree = TestAccess::GetPropertyTree(assignedCopy);
+  pad.AddData("lateHist", "input");
+  data.SetLegendLabel("modified after copy");
+  check(TestAccess::GetDataCount(plot) == 3, "references modify the original plot");
+  check(TestAccess::GetPropertyTree(namedCopy) == namedCopyTree, "references do not modify copies created from the plot");
+  check(TestAccess::GetPropertyTree(plainCopy) == plainCopyTree, "references do not modify plain copies");
+  check(TestAccess::GetPropertyTree(assignedCopy) == assignedCopyTree, "references do not modify assigned copies");
+
+  // internal copies share the contents until they are modified
+  Plot sharedCopy = TestAccess::SharedCopy(plot);
+  check(TestAccess::SharesPads(plot, sharedCopy), "internal copies share their pads");
+  sharedCopy[1].AddData("sharedCopyHist", "input");
+  check(!TestAccess::SharesPads(plot, sharedCopy) && TestAccess::GetDataCount(plot) == 3, "modified internal copy is detached from the original");
+  check(!TestAccess::SharesPads(plot, plainCopy), "plain copies do not share their pads");
+
+  Plot movedPlot = std::move(plot);
+  check(TestAccess::GetDataCount(movedPlot) == 3, "moved plot keeps its data");
+  check(TestAccess::GetDataCount(plot) == 0, "moved-from plot is empty");
+  plot[1].AddData("hist", "input");
+  check(TestAccess::GetDataCount(plot) == 1 && TestAccess::GetDataCount(movedPlot) == 3, "moved-from plot can be used again");
+
+  Plot assignedPlot;
+  assignedPlot = std::move(movedPlot);
+  check(TestAccess::GetDataCount(assignedPlot) == 3 && TestAccess::GetDataCount(movedPlot) == 0, "move assignment leaves an empty plot behind");
+  movedPlot[1]['X'].SetTitle("x");
+  check(TestAccess::GetPadCount(movedPlot) == 1, "pads of a moved-from plot can be modified");
+
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "HEPDataReader.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <fmt/core.h>
+
+#include "TGraphAsymmErrors.h"
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Reads the same hepdata table in yaml format and as csv export and checks the resulting graphs.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+  auto isClose = [](double_t value, double_t expected) { return std::abs(value - expected) < 1e-9; };
+
+  const string yamlFile = "test_hepdata_yaml.yaml";
+  const string csvFile = "test_hepdata_csv.csv";
+  std::ofstream(yamlFile) << "dependent_variables:\n"
+                             "- header: {name: 'cross section', units: pb}\n"
+                             "  qualifiers:\n"
+                             "  - {name: SQRT(S), units: GeV, value: 13000}\n"
+                             "  values:\n"
+                             "  - value: 10\n"
+                             "    errors:\n"
+                             "    - {symerror: 1, label: stat}\n"
+                             "    - {asymerror: {plus: 2, minus: -1}, label: sys}\n"
+                             "  - value: 20\n"
+                             "    errors:\n"
+                             "    - {symerror: 10%, label: stat}\n"
+                             "    - asymerror:\n"
+                             "        plus: 4\n"
+                             "        minus: -3\n"
+                             "      label: sys\n"
+                             "- header: {name: ratio}\n"
+                             "  values:\n"
+                             "  - value: 1.0\n"
+                             "  - value: '-'\n"
+                             "independent_variables:\n"
+                             "- header: {name: pT, units: GeV}\n"
+                             "  values:\n"
+                             "  - {low: 0, high: 2}\n"
+                             "  - {low: 2, high: 6}\n";
+  std::ofstream(csvFile) << "#: name: Table 1\n"
+                            "\"pT [GeV]\",\"pT [GeV] LOW\",\"pT [GeV] HIGH\",\"cross section [pb]\",\"stat +\",\"stat -\",\"sys +\",\"sys -\"\n"
+                            "1,0,2,10,1,-1,2,-1\n"
+                            "4,2,6,20,2,-2,4,-3\n";
+
+  check(HEPDataReader::IsHEPDataFile(yamlFile) && HEPDataReader::IsHEPDataFile(csvFile + ":hepdata"), "hepdata tables are recognized");
+  check(!HEPDataReader::IsHEPDataFile(csvFile), "csv files without option are not treated as hepdata tables");
+
+  for (auto& fileName : {yamlFile, csvFile}) {
+    string table = HEPDataReader::GetTableName(fileName);
+    HEPDataReader reader;
+    check(reader.Read(fileName, {table + "/y1", table + "/y1/stat", table + "/y2"}), fmt::format("{} can be read", fileName));
+    auto& objects = reader.GetObjects();
+
+    if (auto total = (objects.count(table + "/y1")) ? dynamic_cast<TGraphAsymmErrors*>(objects[table + "/y1"].get()) : nullptr) {
+      check(total->GetN() == 2, fmt::format("all points are read from {}", fileName));
+      check(isClose(total->GetX()[1], 4.) && isClose(total->GetEXlow()[1], 2.) && isClose(total->GetEXhigh()[1], 2.), fmt::format("bins are read from {}", fileName));
+      check(isClose(total->GetY()[1], 20.), fmt::format("values are read from {}", fileName));
+      check(isClose(total->GetEYlow()[1], std::sqrt(13.)) && isClose(total->GetEYhigh()[1], std::sqrt(20.)), fmt::format("uncertainties of {} are added in quadrature", fileName));
+    } else {
+      check(false, fmt::format("dependent variable is read from {}", fileName));
+    }
+    if (auto stat = (objects.count(table + "/y1/stat")) ? dynamic_cast<TGraphAsymmErrors*>(objects[table + "/y1/stat"].get()) : nullptr) {
+      check(isClose(stat->GetEYlow()[0], 1.) && isClose(stat->GetEYhigh()[1], 2.), fmt::format("labeled uncertainties are read from {}", fileName));
+    } else {
+      check(false, fmt::format("labeled uncertainties can be selected in {}", fileName));
+    }
+  }
+
+  HEPDataReader reader;
+  reader.Read(yamlFile, {"test_hepdata_yaml/y2"});
+  if (auto ratio = dynamic_cast<TGraphAsymmErrors*>(reader.GetObjects()["test_hepdata_yaml/y2"].get())) {
+    check(ratio->GetN() == 1, "non-numeric values are skipped");
+  } else {
+    check(false, "second dependent variable is read");
+  }
+
+  for (auto& fileName : {yamlFile, csvFile}) {
+    std::filesystem::remove(fileName);
+  }
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "NumPyReader.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <fmt/core.h>
+
+#include "TH1D.h"
+#include "TGraphErrors.h"
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Writes array in npy format (version 1.0, little-endian data as given).
+ */
+//**************************************************************************************************
+template <typename T>
+static void write_npy(const string& fileName, const string& descr, const string& shape, const vector<T>& data, bool isFortranOrder = false)
+{
+  string header = fmt::format("{{'descr': '{}', 'fortran_order': {}, 'shape': {}, }}", descr, (isFortranOrder) ? "True" : "False", shape);
+  // the data starts at a multiple of 64 bytes
+  header.append(63 - (10 + header.size()) % 64, ' ');
+  header += '\n';
+  uint16_t headerLength = header.size();
+  std::ofstream file(fileName, std::ios::binary);
+  file.write("\x93NUMPY\x01\x00", 8);
+  file.put(static_cast<char>(headerLength & 0xff));
+  file.put(static_cast<char>(headerLength >> 8));
+  file << header;
+  file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+//**************************************************************************************************
+/**
+ * Reads a histogram defined via sidecar files and a graph from npy files.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+  auto isClose = [](double_t value, double_t expected) { return std::abs(value - expected) < 1e-9; };
+
+  const string histoFile = "test_numpy_histo.npy";
+  const string edgesFile = "test_numpy_histo.edges.npy";
+  const string errorsFile = "test_numpy_histo.errors.npy";
+  const string graphFile = "test_numpy_graph.npy";
+  write_npy<double_t>(histoFile, "<f8", "(3,)", {1., 2., 3.});
+  write_npy<double_t>(edgesFile, "<f8", "(4,)", {0., 1., 3., 6.});
+  write_npy<float_t>(errorsFile, "<f4", "(3,)", {0.5, 1., 1.5});
+  // columns x, y in fortran order
+  write_npy<int32_t>(graphFile, "<i4", "(2, 2)", {1, 2, 10, 20}, true);
+
+  NumPyReader reader;
+  check(reader.Read(histoFile, {"test_numpy_histo"}), "npy file with sidecar files can be read");
+  if (auto histo = dynamic_cast<TH1D*>(reader.GetObjects()["test_numpy_histo"].get())) {
+    check(histo->GetNbinsX() == 3, "histogram has the binning of the edges sidecar");
+    check(isClose(histo->GetBinContent(3), 3.) && isClose(histo->GetBinError(3), 1.5), "histogram contents and errors are read");
+  } else {
+    check(false, "histogram is read as TH1D");
+  }
+  // these files are watched for modifications by the manager
+  auto& sidecarFiles = reader.GetSidecarFileNames();
+  check(sidecarFiles == vector<string>{edgesFile, errorsFile}, "all sidecar files that were read are reported");
+
+  check(reader.Read(graphFile, {"test_numpy_graph"}), "npy file without sidecar files can be read");
+  check(reader.GetSidecarFileNames().empty(), "sidecar files of previous read are forgotten");
+  if (auto graph = dynamic_cast<TGraph*>(reader.GetObjects()["test_numpy_graph"].get())) {
+    check(graph->GetN() == 2, "graph has all points");
+    check(isClose(graph->GetX()[1], 2.) && isClose(graph->GetY()[1], 20.), "columns of fortran ordered array are read");
+  } else {
+    check(false, "graph is read as TGraph");
+  }
+
+  check(reader.Read(histoFile, {"something_else"}) && reader.GetObjects().empty() && reader.GetSidecarFileNames().empty(), "files that are not required are not read");
+
+  for (auto& fileName : {histoFile, edgesFile, errorsFile, graphFile}) {
+    std::filesystem::remove(fileName);
+  }
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
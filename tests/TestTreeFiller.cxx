@@ -0,0 +1,118 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "TreeFiller.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fmt/core.h>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1D.h"
+#include "TH2D.h"
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Writes a tree with the given (pt, eta) entries to a file.
+ */
+//**************************************************************************************************
+static void write_tree(const string& fileName, const vector<std::pair<double_t, double_t>>& entries)
+{
+  TFile file(fileName.data(), "RECREATE");
+  TTree tree("Events", "Events");
+  double_t pt{}, eta{};
+  tree.Branch("pt", &pt);
+  tree.Branch("eta", &eta);
+  for (auto& entry : entries) {
+    std::tie(pt, eta) = entry;
+    tree.Fill();
+  }
+  tree.Write();
+}
+
+//**************************************************************************************************
+/**
+ * Checks the parsing of tree requests and fills histograms from a tree (directly and from the cache).
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+  auto isClose = [](double_t value, double_t expected) { return std::abs(value - expected) < 1e-9; };
+
+  auto request = tree_request_t::FromName("Events::TMath::Abs(eta):pt>>(+10, 0, 1e1, [-1, 0, 1]) | pt > 1");
+  check(request.has_value(), "valid 2d request is accepted");
+  if (request) {
+    check(request->tree == "Events", "tree name is parsed");
+    check(request->expressions == vector<string>{"pt", "TMath::Abs(eta)"}, "expressions are parsed in order x, y");
+    check(request->axes.size() == 2 && request->axes[0].nBins == 10 && isClose(request->axes[0].max, 10.), "fixed binning is parsed");
+    check(request->axes.size() == 2 && request->axes[1].edges == vector<double_t>{-1., 0., 1.}, "variable binning is parsed");
+    check(request->selection == "pt > 1", "selection is parsed");
+  }
+  for (auto& invalidName : {"Events::pt>>(10,5,1)", "Events::pt>>(0,0,1)", "Events::pt>>([1,0])", "Events::pt>>(10,0)", "Events::pt>>(10,0,10) pt > 1",
+                            "Events::eta:pt>>(10,0,10)", "::pt>>(10,0,10)"}) {
+    check(!tree_request_t::FromName(invalidName), fmt::format("invalid request '{}' is rejected", invalidName));
+  }
+
+  const string inputFile = "test_tree_filler.root";
+  const string cacheFile = "test_tree_filler_cache.root";
+  std::filesystem::remove(cacheFile);
+  write_tree(inputFile, {{0.5, -0.5}, {1.5, 0.5}, {2.5, -0.5}, {3.5, 0.5}, {3.5, 0.8}});
+
+  const string histoName = "Events::pt>>(4,0,4)";
+  const string mapName = "Events::eta:pt>>(2,0,4,[-1,0,1])|pt > 1";
+  const string expressionName = "Events::2*pt>>(4,0,8)|eta > 0";
+  for (bool fromCache : {false, true}) {
+    string mode = (fromCache) ? "from cache" : "in event loop";
+    TreeFiller filler(cacheFile, 1);
+    check(filler.Fill({inputFile}, {histoName, mapName, expressionName}), fmt::format("histograms are filled {}", mode));
+    auto& objects = filler.GetObjects();
+    if (auto histo = dynamic_cast<TH1*>(objects[histoName].get())) {
+      check(isClose(histo->GetBinContent(4), 2.) && isClose(histo->GetEntries(), 5.), fmt::format("1d histogram is filled {}", mode));
+    } else {
+      check(false, fmt::format("1d histogram is available {}", mode));
+    }
+    if (auto histo2d = dynamic_cast<TH2*>(objects[mapName].get())) {
+      check(isClose(histo2d->GetBinContent(1, 2), 1.) && isClose(histo2d->GetBinContent(2, 2), 2.) && isClose(histo2d->GetEntries(), 4.), fmt::format("selection is applied to 2d histogram {}", mode));
+    } else {
+      check(false, fmt::format("2d histogram is available {}", mode));
+    }
+    if (auto histo = dynamic_cast<TH1*>(objects[expressionName].get())) {
+      check(isClose(histo->GetBinContent(2), 1.) && isClose(histo->GetBinContent(4), 2.), fmt::format("histogram of expression is filled {}", mode));
+    } else {
+      check(false, fmt::format("histogram of expression is available {}", mode));
+    }
+  }
+  check(std::filesystem::exists(cacheFile), "results are written to the cache file");
+
+  for (auto& fileName : {inputFile, cacheFile}) {
+    std::filesystem::remove(fileName);
+  }
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}
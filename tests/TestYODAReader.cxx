@@ -0,0 +1,136 @@
+// PlottingFramework
+//
+// Copyright (C) 2019-2022  Mario Krüger
+// Contact: mario.kruger@cern.ch
+// For a full list of contributors please see doc/CONTRIBUTORS.md
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "PlottingFramework.h"
+#include "YODAReader.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <fmt/core.h>
+
+#include "TH1D.h"
+#include "TGraphAsymmErrors.h"
+
+using namespace PlottingFramework;
+
+//**************************************************************************************************
+/**
+ * Reads histograms, scatters and estimates of different format versions from a yoda file.
+ */
+//**************************************************************************************************
+int main()
+{
+  uint32_t nFailures{};
+  auto check = [&nFailures](bool condition, const string& description) {
+    if (!condition) {
+      fmt::print(stderr, "FAILED: {}\n", description);
+      ++nFailures;
+    }
+  };
+  auto isClose = [](double_t value, double_t expected) { return std::abs(value - expected) < 1e-9; };
+
+  const string inputFile = "test_yoda_reader.yoda";
+  std::ofstream(inputFile) << "BEGIN YODA_HISTO1D_V2 /TEST/histo\n"
+                              "Path: /TEST/histo\n"
+                              "Title: histogram\n"
+                              "Type: Histo1D\n"
+                              "---\n"
+                              "# xlow\t xhigh\t sumw\t sumw2\t sumwx\t sumwx2\t numEntries\n"
+                              "Total   \tTotal   \t6\t14\t14\t41.5\t3\n"
+                              "Underflow\tUnderflow\t0\t0\t0\t0\t0\n"
+                              "Overflow\tOverflow\t1\t1\t5\t25\t1\n"
+                              "0\t1\t1\t1\t0.5\t0.25\t1\n"
+                              "1\t2\t2\t4\t3\t4.5\t1\n"
+                              "3\t4\t3\t9\t10.5\t36.75\t1\n"
+                              "END YODA_HISTO1D_V2\n"
+                              "\n"
+                              "BEGIN YODA_SCATTER2D_V2 /TEST/other\n"
+                              "Path: /TEST/other\n"
+                              "---\n"
+                              "this object is not requested and therefore never parsed\n"
+                              "END YODA_SCATTER2D_V2\n"
+                              "\n"
+                              "BEGIN YODA_SCATTER2D_V2 /TEST/scatter\n"
+                              "Path: /TEST/scatter\n"
+                              "Type: Scatter2D\n"
+                              "---\n"
+                              "# xval\t xerr-\t xerr+\t yval\t yerr-\t yerr+\n"
+                              "1\t0.5\t0.5\t10\t1\t2\n"
+                              "2\t0.5\t0.5\t20\t-2\t3\n"
+                              "END YODA_SCATTER2D_V2\n"
+                              "\n"
+                              "BEGIN YODA_ESTIMATE1D_V3 /TEST/estimate\n"
+                              "Path: /TEST/estimate\n"
+                              "Title: estimate\n"
+                              "Type: Estimate1D\n"
+                              "---\n"
+                              "Edges(A1): [0.0, 2.0, 4.0]\n"
+                              "ErrorLabels: [\"stat\"]\n"
+                              "# value\terrDn(1)\terrUp(1)\n"
+                              "nan\tnan\tnan\n"
+                              "1.5\t-0.3\t0.4\n"
+                              "2.5\t-0.1\t0.2\n"
+                              "nan\tnan\tnan\n"
+                              "END YODA_ESTIMATE1D_V3\n"
+                              "\n"
+                              "BEGIN YODA_ESTIMATE1D_V2 /TEST/old_estimate\n"
+                              "Path: /TEST/old_estimate\n"
+                              "Type: Estimate1D\n"
+                              "---\n"
+                              "1.5\t-0.3\t0.4\n"
+                              "END YODA_ESTIMATE1D_V2\n";
+
+  YODAReader reader;
+  check(reader.Read(inputFile, {"TEST/histo", "TEST/scatter", "TEST/estimate", "TEST/old_estimate", "TEST/missing"}), "yoda file can be read");
+  auto& objects = reader.GetObjects();
+  check(objects.size() == 3, "only the supported objects that were requested are read");
+
+  if (auto histo = (objects.count("TEST/histo")) ? dynamic_cast<TH1D*>(objects["TEST/histo"].get()) : nullptr) {
+    // the gap between the bins is filled by an empty bin
+    check(histo->GetNbinsX() == 4, "histogram has the bins of the file");
+    check(isClose(histo->GetBinContent(2), 2.) && isClose(histo->GetBinError(2), 2.), "histogram bin content and error are read");
+    check(isClose(histo->GetBinContent(3), 0.), "gap between bins results in empty bin");
+    check(isClose(histo->GetBinContent(5), 1.), "overflow is read");
+    check(isClose(histo->GetEntries(), 3.), "number of entries is taken from the total");
+  } else {
+    check(false, "histogram is read as TH1D");
+  }
+
+  if (auto scatter = (objects.count("TEST/scatter")) ? dynamic_cast<TGraphAsymmErrors*>(objects["TEST/scatter"].get()) : nullptr) {
+    check(scatter->GetN() == 2, "scatter has all points");
+    check(isClose(scatter->GetY()[1], 20.) && isClose(scatter->GetEYlow()[1], 2.) && isClose(scatter->GetEYhigh()[1], 3.), "scatter values and errors are read");
+  } else {
+    check(false, "scatter is read as TGraphAsymmErrors");
+  }
+
+  if (auto estimate = (objects.count("TEST/estimate")) ? dynamic_cast<TGraphAsymmErrors*>(objects["TEST/estimate"].get()) : nullptr) {
+    check(estimate->GetN() == 2, "underflow and overflow of estimate are skipped");
+    check(isClose(estimate->GetX()[1], 3.) && isClose(estimate->GetEXlow()[1], 1.), "estimate bins are taken from its edges");
+    check(isClose(estimate->GetY()[0], 1.5) && isClose(estimate->GetEYlow()[0], 0.3) && isClose(estimate->GetEYhigh()[0], 0.4), "estimate values and errors are read");
+  } else {
+    check(false, "estimate is read as TGraphAsymmErrors");
+  }
+
+  // estimates of format version < 3 do not contain the bin edges
+  check(!objects.count("TEST/old_estimate"), "estimates without bin edges are rejected");
+
+  std::filesystem::remove(inputFile);
+  if (nFailures) fmt::print(stderr, "{} check(s) failed.\n", nFailures);
+  return (nFailures) ? 1 : 0;
+}